@@ -1,4 +1,5 @@
 #include "bdwgraph.h"
+#include "uilogging.h"
 #include <QDebug>
 
 /**
@@ -25,64 +26,30 @@ BDWGraph::~BDWGraph()
 }
 
 /**
- * @brief Override draw method to create scatterplots by default
+ * @brief Draw the ADOPTED series as a dashed line and the other series as scatterplots
  *
+ * @param seriesId The interned ID of the series
+ * @return SeriesStyle Style used by the base draw paths
  */
-void BDWGraph::draw()
+WaterfallGraph::SeriesStyle BDWGraph::seriesStyle(int seriesId) const
 {
-    if (!graphicsScene)
-        return;
-    
-    // Prevent concurrent drawing to avoid marker duplication
-    if (isDrawing) {
-        qDebug() << "BDWGraph: draw() already in progress, skipping";
-        return;
-    }
-    
-    isDrawing = true;
-
-    graphicsScene->clear();
-    graphicsScene->update(); // Force immediate update to ensure clearing is visible
-    setupDrawingArea();
-
-    if (gridEnabled)
-    {
-        drawGrid();
-    }
+    SeriesStyle style = adoptedLineSeriesStyle(seriesId);
+    style.linePen.setStyle(Qt::DashLine);
+    style.linePen.setDashPattern({8, 4}); // Custom dash pattern: 8px dash, 4px gap
+    return style;
+}
 
-    // Draw dashed grey vertical axis at 0 value
+/**
+ * @brief Draw the zero axis and the BTW symbols over the series
+ *
+ */
+void BDWGraph::drawDecorations()
+{
+    // Draw dashed vertical axis at 0 value
     drawZeroAxis();
-    
-    if (dataSource && !dataSource->isEmpty())
-    {
-        updateDataRanges();
-        
-        // Draw scatterplots for each series with their respective colors
-        std::vector<QString> seriesLabels = dataSource->getDataSeriesLabels();
-        for (const QString &seriesLabel : seriesLabels)
-        {
-            if (isSeriesVisible(seriesLabel))
-            {
-                QColor seriesColor = getSeriesColor(seriesLabel);
-                
-                if (seriesLabel == "ADOPTED")
-                {
-                    // Draw curve for ADOPTED series without points
-                    drawDataLine(seriesLabel, false);
-                }
-                else
-                {
-                    // Draw scatterplot for other series
-                    drawScatterplot(seriesLabel, seriesColor, 3.0, Qt::black);
-                }
-            }
-        }
-    }
-    
+
     // Draw BTW symbols (magenta circles) if any exist in data source
     drawBTWSymbols();
-    
-    isDrawing = false;
 }
 
 /**
@@ -145,81 +112,9 @@ void BDWGraph::drawZeroAxis()
     zeroAxisPen.setDashPattern({8, 4}); // Custom dash pattern: 8px dash, 4px gap
     
     // Draw the vertical line
-    graphicsScene->addLine(QLineF(topPoint, bottomPoint), zeroAxisPen);
+    QGraphicsLineItem *zeroAxis = new QGraphicsLineItem(QLineF(topPoint, bottomPoint));
+    zeroAxis->setPen(zeroAxisPen);
+    addDecorationItem(zeroAxis);
     
-    qDebug() << "BDW zero axis drawn at x:" << zeroPoint.x();
-}
-
-/**
- * @brief Override drawDataLine to use dashed lines for BDW graph
- *
- */
-void BDWGraph::drawDataLine(const QString &seriesLabel, bool plotPoints)
-{
-    if (!graphicsScene || !dataSource || dataSource->isEmpty() || !dataRangesValid)
-    {
-        return;
-    }
-
-    const auto &yData = dataSource->getYDataSeries(seriesLabel);
-    const auto &timestamps = dataSource->getTimestampsSeries(seriesLabel);
-
-    // Filter data points to only include those within the current time range
-    std::vector<std::pair<qreal, QDateTime>> visibleData;
-    for (size_t i = 0; i < yData.size(); ++i)
-    {
-        if (timestamps[i] >= timeMin && timestamps[i] <= timeMax)
-        {
-            visibleData.push_back({yData[i], timestamps[i]});
-        }
-    }
-
-    if (visibleData.empty())
-    {
-        qDebug() << "No data points within current time range";
-        return;
-    }
-
-    if (visibleData.size() < 2)
-    {
-        // Draw a single point if we only have one data point
-        QPointF screenPoint = mapDataToScreen(visibleData[0].first, visibleData[0].second);
-        QPen pointPen(Qt::green, 0); // No stroke (width 0)
-        graphicsScene->addEllipse(screenPoint.x() - 2, screenPoint.y() - 2, 4, 4, pointPen);
-        qDebug() << "Data line drawn with 1 visible point";
-        return;
-    }
-
-    // Create a path for the line
-    QPainterPath path;
-    QPointF firstPoint = mapDataToScreen(visibleData[0].first, visibleData[0].second);
-    path.moveTo(firstPoint);
-
-    // Add lines connecting all visible data points
-    for (size_t i = 1; i < visibleData.size(); ++i)
-    {
-        QPointF point = mapDataToScreen(visibleData[i].first, visibleData[i].second);
-        path.lineTo(point);
-    }
-
-    // Draw the line with dashed style
-    QColor seriesColor = getSeriesColor(seriesLabel);
-    QPen linePen(seriesColor, 2);
-    linePen.setStyle(Qt::DashLine);
-    linePen.setDashPattern({8, 4}); // Custom dash pattern: 8px dash, 4px gap
-    graphicsScene->addPath(path, linePen);
-
-    // Draw data points if enabled
-    if (plotPoints)
-    {
-        // Draw data points
-        QPen pointPen(seriesColor, 0); // No stroke (width 0)
-        for (size_t i = 0; i < visibleData.size(); ++i)
-        {
-            QPointF point = mapDataToScreen(visibleData[i].first, visibleData[i].second);
-            graphicsScene->addEllipse(point.x() - 1, point.y() - 1, 2, 2, pointPen);
-        }
-    }
-
-    qDebug() << "BDW data line drawn (dashed) for series" << seriesLabel << "with" << visibleData.size() << "visible points";
+    UI_DEBUG(lcWaterfallDraw) << "BDW zero axis drawn at x:" << zeroPoint.x();
 }
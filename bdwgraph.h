@@ -18,15 +18,13 @@ public:
     ~BDWGraph();
 
 protected:
-    // Override the draw method to create scatterplots by default
-    void draw() override;
+    // Draw the ADOPTED series as a dashed line and the other series as scatterplots
+    SeriesStyle seriesStyle(int seriesId) const override;
+    void drawDecorations() override;
 
     // Override mouse event handlers if needed
     void onMouseClick(const QPointF &scenePos) override;
     void onMouseDrag(const QPointF &scenePos) override;
-    
-    // Override drawDataLine to use dashed lines
-    void drawDataLine(const QString &seriesLabel, bool plotPoints = true) override;
 
 private:
     // BDW-specific properties and methods can be added here
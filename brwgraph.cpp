@@ -1,4 +1,5 @@
 #include "brwgraph.h"
+#include "uilogging.h"
 #include <QDebug>
 
 /**
@@ -25,64 +26,27 @@ BRWGraph::~BRWGraph()
 }
 
 /**
- * @brief Override draw method to create scatterplots by default
+ * @brief Draw the ADOPTED series as a line and the other series as scatterplots
  *
+ * @param seriesId The interned ID of the series
+ * @return SeriesStyle Style used by the base draw paths
  */
-void BRWGraph::draw()
+WaterfallGraph::SeriesStyle BRWGraph::seriesStyle(int seriesId) const
 {
-    if (!graphicsScene)
-        return;
-    
-    // Prevent concurrent drawing to avoid marker duplication
-    if (isDrawing) {
-        qDebug() << "BRWGraph: draw() already in progress, skipping";
-        return;
-    }
-    
-    isDrawing = true;
-
-    graphicsScene->clear();
-    graphicsScene->update(); // Force immediate update to ensure clearing is visible
-    setupDrawingArea();
-
-    if (gridEnabled)
-    {
-        drawGrid();
-    }
+    return adoptedLineSeriesStyle(seriesId);
+}
 
-    // Draw dashed white horizontal line at 0 value
+/**
+ * @brief Draw the zero axis and the BTW symbols over the series
+ *
+ */
+void BRWGraph::drawDecorations()
+{
+    // Draw dashed vertical axis at 0 value
     drawZeroAxis();
 
-    if (dataSource && !dataSource->isEmpty())
-    {
-        updateDataRanges();
-        
-        // Draw scatterplots for each series with their respective colors
-        std::vector<QString> seriesLabels = dataSource->getDataSeriesLabels();
-        for (const QString &seriesLabel : seriesLabels)
-        {
-            if (isSeriesVisible(seriesLabel))
-            {
-                QColor seriesColor = getSeriesColor(seriesLabel);
-                
-                if (seriesLabel == "ADOPTED")
-                {
-                    // Draw curve for ADOPTED series without points
-                    drawDataLine(seriesLabel, false);
-                }
-                else
-                {
-                    // Draw scatterplot for other series
-                    drawScatterplot(seriesLabel, seriesColor, 3.0, Qt::black);
-                }
-            }
-        }
-    }
-    
     // Draw BTW symbols (magenta circles) if any exist in data source
     drawBTWSymbols();
-    
-    isDrawing = false;
 }
 
 /**
@@ -144,7 +108,9 @@ void BRWGraph::drawZeroAxis()
     zeroAxisPen.setDashPattern({8, 4}); // Custom dash pattern: 8px dash, 4px gap
     
     // Draw the vertical line
-    graphicsScene->addLine(QLineF(topPoint, bottomPoint), zeroAxisPen);
+    QGraphicsLineItem *zeroAxis = new QGraphicsLineItem(QLineF(topPoint, bottomPoint));
+    zeroAxis->setPen(zeroAxisPen);
+    addDecorationItem(zeroAxis);
     
-    qDebug() << "BRW zero axis drawn at x:" << zeroPoint.x();
+    UI_DEBUG(lcWaterfallDraw) << "BRW zero axis drawn at x:" << zeroPoint.x();
 }
@@ -1,4 +1,5 @@
 #include "btwgraph.h"
+#include "uilogging.h"
 #include "btwinteractiveoverlay.h"
 #include "interactivegraphicsitem.h"
 #include "graphcontainer.h"
@@ -37,72 +38,30 @@ BTWGraph::~BTWGraph()
 }
 
 /**
- * @brief Override draw method to create scatterplots by default
+ * @brief Draw the ADOPTED series as a line and the other series as scatterplots
  *
+ * @param seriesId The interned ID of the series
+ * @return SeriesStyle Style used by the base draw paths
  */
-void BTWGraph::draw()
+WaterfallGraph::SeriesStyle BTWGraph::seriesStyle(int seriesId) const
 {
-    if (!graphicsScene)
-        return;
-    
-    // Prevent concurrent drawing to avoid marker duplication
-    if (isDrawing) {
-        qDebug() << "BTWGraph: draw() already in progress, skipping";
-        return;
-    }
-    
-    isDrawing = true;
+    return adoptedLineSeriesStyle(seriesId);
+}
 
-    // Clear existing items - ensure complete clearing before drawing
-    // Automatic circle markers are in graphicsScene, so clearing graphicsScene removes them
-    graphicsScene->clear();
-    graphicsScene->update(); // Force immediate update to ensure clearing is visible
-    
+/**
+ * @brief Draw the BTW symbols and the manually placed markers over the series
+ *
+ */
+void BTWGraph::drawDecorations()
+{
     // Clear stored timestamps when redrawing (markers will be recreated)
     m_automaticMarkerTimestamps.clear();
-    
-    setupDrawingArea();
-
-    if (gridEnabled)
-    {
-        drawGrid();
-    }
-
-    if (dataSource && !dataSource->isEmpty())
-    {
-        updateDataRanges();
-        
-        // Draw scatterplots for each series with their respective colors
-        std::vector<QString> seriesLabels = dataSource->getDataSeriesLabels();
-        for (const QString &seriesLabel : seriesLabels)
-        {
-            if (isSeriesVisible(seriesLabel))
-            {
-                QColor seriesColor = getSeriesColor(seriesLabel);
-                
-                if (seriesLabel == "ADOPTED")
-                {
-                    // Draw curve for ADOPTED series without points
-                    drawDataLine(seriesLabel, false);
-                }
-                else
-                {
-                    // Draw scatterplot for other series
-                    drawScatterplot(seriesLabel, seriesColor, 3.0, Qt::black);
-                }
 
-                // BTW markers are now manually placed through data source - no automatic generation
-            }
-        }
-    }
-    
     // Draw BTW symbols (magenta circles from other graphs)
     drawBTWSymbols();
     
     // Draw manually placed BTW markers from data source
     drawCustomCircleMarkers();
-    
-    isDrawing = false;
 }
 
 /**
@@ -188,7 +147,7 @@ void BTWGraph::drawBTWScatterplot()
 void BTWGraph::drawCustomCircleMarkers()
 {
     if (!dataSource || !graphicsScene) {
-        qDebug() << "BTW: drawCustomCircleMarkers early return - no dataSource or graphicsScene";
+        UI_DEBUG(lcWaterfallDraw) << "BTW: drawCustomCircleMarkers early return - no dataSource or graphicsScene";
         return;
     }
 
@@ -196,7 +155,7 @@ void BTWGraph::drawCustomCircleMarkers()
     std::vector<BTWMarkerData> btwMarkers = dataSource->getBTWMarkers();
     
     if (btwMarkers.empty()) {
-        qDebug() << "BTW: No manually placed markers in data source";
+        UI_DEBUG(lcWaterfallDraw) << "BTW: No manually placed markers in data source";
         return;
     }
 
@@ -215,13 +174,13 @@ void BTWGraph::drawCustomCircleMarkers()
     }
 
     if (visibleMarkers.empty()) {
-        qDebug() << "BTW: No visible markers within time range";
+        UI_DEBUG(lcWaterfallDraw) << "BTW: No visible markers within time range";
         return;
     }
 
     // Draw circle markers for each visible marker
     int markersDrawn = 0;
-    qDebug() << "BTW: Drawing" << visibleMarkers.size() << "manually placed markers";
+    UI_DEBUG(lcWaterfallDraw) << "BTW: Drawing" << visibleMarkers.size() << "manually placed markers";
     
     for (const auto& markerData : visibleMarkers) {
         QDateTime timestamp = markerData.timestamp;
@@ -244,7 +203,7 @@ void BTWGraph::drawCustomCircleMarkers()
             circleOutline->setBrush(QBrush(Qt::transparent));
             circleOutline->setZValue(1000);
             
-            graphicsScene->addItem(circleOutline);
+            addDecorationItem(circleOutline);
             
             // Draw angled line (5x radius on both sides)
             qreal lineLength = 5 * markerRadius;
@@ -265,7 +224,7 @@ void BTWGraph::drawCustomCircleMarkers()
             angledLine->setPen(QPen(Qt::blue, 2));
             angledLine->setZValue(1001);
             
-            graphicsScene->addItem(angledLine);
+            addDecorationItem(angledLine);
             
             // Add blue text label with rectangular outline beside the marker
             QString prefix = (deltaValue >= 0) ? "R" : "L";
@@ -283,7 +242,7 @@ void BTWGraph::drawCustomCircleMarkers()
                             screenPos.y() - textRect.height() / 2);
             textLabel->setZValue(1002);
             
-            graphicsScene->addItem(textLabel);
+            addDecorationItem(textLabel);
             
             // Add rectangular outline around the text
             QGraphicsRectItem *textOutline = new QGraphicsRectItem();
@@ -293,13 +252,13 @@ void BTWGraph::drawCustomCircleMarkers()
             textOutline->setBrush(QBrush(Qt::transparent));
             textOutline->setZValue(1001);
             
-            graphicsScene->addItem(textOutline);
+            addDecorationItem(textOutline);
             
             markersDrawn++;
         }
     }
     
-    qDebug() << "BTW: Drew" << markersDrawn << "manually placed circle markers";
+    UI_DEBUG(lcWaterfallDraw) << "BTW: Drew" << markersDrawn << "manually placed circle markers";
 }
 
 /**
@@ -597,7 +556,7 @@ void BTWGraph::drawBTWSymbols()
         pixmapItem->setPos(screenPos.x() - pixmapRect.width()/2, screenPos.y() - pixmapRect.height()/2);
         pixmapItem->setZValue(1003); // Above markers but below interactive items
         
-        graphicsScene->addItem(pixmapItem);
+        addDecorationItem(pixmapItem);
     }
 }
 
@@ -663,24 +622,17 @@ void BTWGraph::addBTWSymbolToOtherGraphs(const QDateTime &timestamp, qreal btwVa
             qreal dataValue = 0.0;
             
             // Check all series in the data source
-            std::vector<QString> seriesLabels = dataSource->getDataSeriesLabels();
-            for (const QString &seriesLabel : seriesLabels)
+            const qint64 timestampMs = timestamp.toMSecsSinceEpoch();
+            for (int seriesId : dataSource->getDataSeriesIds())
             {
                 // Get data points near this timestamp (within 1 second)
-                const std::vector<QDateTime> &timestamps = dataSource->getTimestampsSeries(seriesLabel);
-                const std::vector<qreal> &yData = dataSource->getYDataSeries(seriesLabel);
-                
-                for (size_t i = 0; i < timestamps.size(); ++i)
+                WaterfallSeriesView nearby = dataSource->getDataSeriesView(seriesId, timestampMs - 999, timestampMs + 999);
+                if (!nearby.empty())
                 {
-                    qint64 timeDiff = qAbs(timestamps[i].msecsTo(timestamp));
-                    if (timeDiff < 1000) // Within 1 second
-                    {
-                        hasDataPoint = true;
-                        dataValue = yData[i];
-                        break;
-                    }
+                    hasDataPoint = true;
+                    dataValue = nearby.yData[0];
+                    break;
                 }
-                if (hasDataPoint) break;
             }
             
             // Only add symbol if there's a datapoint
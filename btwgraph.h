@@ -53,8 +53,9 @@ public slots:
     void deleteInteractiveMarkers();
 
 protected:
-    // Override the draw method to create scatterplots by default
-    void draw() override;
+    // Draw the ADOPTED series as a line and the other series as scatterplots
+    SeriesStyle seriesStyle(int seriesId) const override;
+    void drawDecorations() override;
 
     // Override mouse event handlers to add interactive markers on click
     void onMouseClick(const QPointF &scenePos) override;
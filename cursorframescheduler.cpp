@@ -0,0 +1,60 @@
+#include "cursorframescheduler.h"
+#include "perfcounters.h"
+#include "waterfallgraph.h"
+#include <algorithm>
+
+CursorFrameScheduler *CursorFrameScheduler::instance()
+{
+    static CursorFrameScheduler scheduler;
+    return &scheduler;
+}
+
+CursorFrameScheduler::CursorFrameScheduler()
+{
+    m_frameTimer.setSingleShot(true);
+    m_frameTimer.setTimerType(Qt::PreciseTimer);
+    QObject::connect(&m_frameTimer, &QTimer::timeout, this, [this]() { runFrame(); });
+}
+
+void CursorFrameScheduler::registerGraph(WaterfallGraph *graph)
+{
+    if (std::find(m_graphs.begin(), m_graphs.end(), graph) == m_graphs.end())
+    {
+        m_graphs.push_back(graph);
+    }
+}
+
+void CursorFrameScheduler::unregisterGraph(WaterfallGraph *graph)
+{
+    m_graphs.erase(std::remove(m_graphs.begin(), m_graphs.end(), graph), m_graphs.end());
+}
+
+/**
+ * @brief Schedule a frame for all graphs
+ *
+ * A frame runs as soon as possible when the last one is at least a frame interval old,
+ * otherwise at the start of the next slot, so a burst of mouse moves and cursor time
+ * changes across several graphs costs one repaint per frame.
+ */
+void CursorFrameScheduler::requestFrame()
+{
+    if (m_frameTimer.isActive())
+    {
+        return;
+    }
+
+    qint64 elapsedMs = m_sinceLastFrame.isValid() ? m_sinceLastFrame.elapsed() : FrameIntervalMs;
+    m_frameTimer.start(static_cast<int>(qBound<qint64>(0, FrameIntervalMs - elapsedMs, FrameIntervalMs)));
+}
+
+void CursorFrameScheduler::runFrame()
+{
+    PERF_SCOPE("CursorFrameScheduler::runFrame");
+    m_sinceLastFrame.start();
+
+    // Flushing never registers or destroys graphs, so the list is stable here
+    for (WaterfallGraph *graph : m_graphs)
+    {
+        graph->flushCursorLayer();
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef CURSORFRAMESCHEDULER_H
+#define CURSORFRAMESCHEDULER_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+#include <vector>
+
+class WaterfallGraph;
+
+/**
+ * @brief Coalesces the cursor layer updates of all waterfall graphs into display frames
+ *
+ * Graphs call requestFrame() when their crosshair or time axis cursor may have moved.
+ * The first request arms a single-shot timer for the next frame slot; the frame then
+ * flushes every registered graph, and each one repaints only if its own cursor state
+ * or the shared cursor revision changed. No timer runs while nothing is requested.
+ */
+class CursorFrameScheduler : public QObject
+{
+public:
+    static CursorFrameScheduler *instance();
+
+    void registerGraph(WaterfallGraph *graph);
+    void unregisterGraph(WaterfallGraph *graph);
+
+    // Arm the next frame unless one is already pending
+    void requestFrame();
+
+private:
+    CursorFrameScheduler();
+    void runFrame();
+
+    static constexpr int FrameIntervalMs = 16; // One 60 Hz display frame
+
+    std::vector<WaterfallGraph *> m_graphs;
+    QTimer m_frameTimer;
+    QElapsedTimer m_sinceLastFrame;
+};
+
+#endif // CURSORFRAMESCHEDULER_H
@@ -1,4 +1,5 @@
 #include "ftwgraph.h"
+#include "uilogging.h"
 #include <QDebug>
 
 /**
@@ -25,61 +26,24 @@ FTWGraph::~FTWGraph()
 }
 
 /**
- * @brief Override draw method to create scatterplots by default
+ * @brief Draw the ADOPTED series as a line and the other series as scatterplots
  *
+ * @param seriesId The interned ID of the series
+ * @return SeriesStyle Style used by the base draw paths
  */
-void FTWGraph::draw()
+WaterfallGraph::SeriesStyle FTWGraph::seriesStyle(int seriesId) const
 {
-    if (!graphicsScene)
-        return;
-    
-    // Prevent concurrent drawing to avoid marker duplication
-    if (isDrawing) {
-        qDebug() << "FTWGraph: draw() already in progress, skipping";
-        return;
-    }
-    
-    isDrawing = true;
-
-    graphicsScene->clear();
-    graphicsScene->update(); // Force immediate update to ensure clearing is visible
-    setupDrawingArea();
-
-    if (gridEnabled)
-    {
-        drawGrid();
-    }
+    return adoptedLineSeriesStyle(seriesId);
+}
 
-    if (dataSource && !dataSource->isEmpty())
-    {
-        updateDataRanges();
-        
-        // Draw scatterplots for each series with their respective colors
-        std::vector<QString> seriesLabels = dataSource->getDataSeriesLabels();
-        for (const QString &seriesLabel : seriesLabels)
-        {
-            if (isSeriesVisible(seriesLabel))
-            {
-                QColor seriesColor = getSeriesColor(seriesLabel);
-                
-                if (seriesLabel == "ADOPTED")
-                {
-                    // Draw curve for ADOPTED series without points
-                    drawDataLine(seriesLabel, false);
-                }
-                else
-                {
-                    // Draw scatterplot for other series
-                    drawScatterplot(seriesLabel, seriesColor, 3.0, Qt::black);
-                }
-            }
-        }
-    }
-    
+/**
+ * @brief Draw the BTW symbols over the series
+ *
+ */
+void FTWGraph::drawDecorations()
+{
     // Draw BTW symbols (magenta circles) if any exist in data source
     drawBTWSymbols();
-    
-    isDrawing = false;
 }
 
 /**
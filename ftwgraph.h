@@ -18,8 +18,9 @@ public:
     ~FTWGraph();
 
 protected:
-    // Override the draw method to create scatterplots by default
-    void draw() override;
+    // Draw the ADOPTED series as a line and the other series as scatterplots
+    SeriesStyle seriesStyle(int seriesId) const override;
+    void drawDecorations() override;
 
     // Override mouse event handlers if needed
     void onMouseClick(const QPointF &scenePos) override;
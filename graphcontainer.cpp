@@ -1,4 +1,6 @@
 #include "graphcontainer.h"
+#include "uilogging.h"
+#include "perfcounters.h"
 #include <QDebug>
 #include <QTimer>
 #include <stdexcept>
@@ -68,10 +70,12 @@ GraphContainer::GraphContainer(QWidget *parent, bool showTimelineView, std::map<
     m_waterfallLayout->addWidget(m_comboBox);
     m_waterfallLayout->addWidget(m_zoomPanel);
 
-    // Create all waterfall graph instances upfront
-    createAllWaterfallGraphs();
-    
-    // Show the initial graph type
+    // Hidden graphs are released when this fires (see setIdleGraphReleaseTimeout)
+    m_graphReleaseTimer = new QTimer(this);
+    m_graphReleaseTimer->setSingleShot(true);
+    connect(m_graphReleaseTimer, &QTimer::timeout, this, &GraphContainer::releaseHiddenWaterfallGraphs);
+
+    // Show the initial graph type; it is constructed here and the others on first selection
     setCurrentDataOption(currentDataOption);
 
 
@@ -142,8 +146,9 @@ void GraphContainer::setupTimer()
 
 void GraphContainer::onTimerTick()
 {
-    // Update current time to all objects in the container
-    QTime currentTime = QTime::currentTime();
+    // Update current time to all objects in the container (the replay clock while replaying)
+    QDateTime clockTime = m_syncState ? m_syncState->currentClockTime() : QDateTime::currentDateTime();
+    QTime currentTime = clockTime.time();
 
     if (m_timelineSelectionView)
     {
@@ -188,8 +193,7 @@ void GraphContainer::onTimerTick()
         auto timeRange = m_currentWaterfallGraph->getTimeRange();
         if (timeRange.first.isValid() && timeRange.second.isValid())
         {
-            QDateTime currentDateTime = QDateTime::currentDateTime();
-            qint64 timeDiffMs = timeRange.second.msecsTo(currentDateTime);
+            qint64 timeDiffMs = timeRange.second.msecsTo(clockTime);
             
             // If showing recent data (within 1 minute), update time range and redraw
             if (timeDiffMs >= 0 && timeDiffMs < 60000)
@@ -445,7 +449,7 @@ void GraphContainer::redrawWaterfallGraph()
     if (m_currentWaterfallGraph)
     {
         m_currentWaterfallGraph->draw();
-        qDebug() << "GraphContainer: Triggered waterfall graph redraw for current graph type" << static_cast<int>(currentDataOption);
+        UI_DEBUG(lcGraphContainer) << "GraphContainer: Triggered waterfall graph redraw for current graph type" << static_cast<int>(currentDataOption);
     }
 }
 
@@ -456,7 +460,7 @@ void GraphContainer::redrawWaterfallGraph(GraphType graphType)
     if (it != m_waterfallGraphs.end() && it->second)
     {
         it->second->draw();
-        qDebug() << "GraphContainer: Triggered waterfall graph redraw for graph type" << static_cast<int>(graphType);
+        UI_DEBUG(lcGraphContainer) << "GraphContainer: Triggered waterfall graph redraw for graph type" << static_cast<int>(graphType);
     }
 }
 
@@ -475,6 +479,64 @@ WaterfallGraph* GraphContainer::getWaterfallGraph(GraphType graphType) const
     return nullptr;
 }
 
+void GraphContainer::setIdleGraphReleaseTimeout(int timeoutMs)
+{
+    m_idleGraphReleaseTimeoutMs = qMax(0, timeoutMs);
+    if (m_idleGraphReleaseTimeoutMs > 0)
+    {
+        m_graphReleaseTimer->start(m_idleGraphReleaseTimeoutMs);
+    }
+    else
+    {
+        m_graphReleaseTimer->stop();
+    }
+}
+
+int GraphContainer::getIdleGraphReleaseTimeout() const
+{
+    return m_idleGraphReleaseTimeoutMs;
+}
+
+/**
+ * @brief Release the hidden waterfall graphs, keeping the current one.
+ *
+ * A released graph is constructed again when it is next selected. Everything it is set up
+ * with is kept by the container (data source, range limits, interval, cursor time, series
+ * colours, rendering mode), so only graphs holding state of their own are kept: BTW graphs
+ * with interactive overlay markers.
+ *
+ * @return int Number of graphs released
+ */
+int GraphContainer::releaseHiddenWaterfallGraphs()
+{
+    int released = 0;
+    for (auto it = m_waterfallGraphs.begin(); it != m_waterfallGraphs.end();)
+    {
+        WaterfallGraph *graph = it->second;
+        if (graph && graph != m_currentWaterfallGraph && canReleaseWaterfallGraph(graph))
+        {
+            qDebug() << "GraphContainer: Releasing hidden waterfall graph" << graphTypeToString(it->first);
+            graph->deleteLater();
+            it = m_waterfallGraphs.erase(it);
+            ++released;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return released;
+}
+
+bool GraphContainer::canReleaseWaterfallGraph(WaterfallGraph *graph) const
+{
+    if (auto btwGraph = qobject_cast<BTWGraph*>(graph))
+    {
+        return !btwGraph->getInteractiveOverlay() || btwGraph->getInteractiveOverlay()->getAllMarkers().isEmpty();
+    }
+    return true;
+}
+
 // Data options management implementation
 
 void GraphContainer::addDataOption(const GraphType graphType, WaterfallData &dataSource)
@@ -718,47 +780,39 @@ WaterfallGraph *GraphContainer::createWaterfallGraph(GraphType graphType)
     }
 }
 
-void GraphContainer::createAllWaterfallGraphs()
+/**
+ * @brief Get the waterfall graph of a type, constructing it on first use.
+ *
+ * Each graph has three scenes and views, a cursor timer and symbol caches, so graphs are
+ * only built for the types actually selected. A new graph is hidden and set up from the
+ * state the container keeps for all graphs.
+ *
+ * @param graphType Graph type
+ * @return WaterfallGraph* The graph of that type
+ */
+WaterfallGraph *GraphContainer::ensureWaterfallGraph(GraphType graphType)
 {
-    // Create all graph types upfront
-    std::vector<GraphType> allTypes = getAllGraphTypes();
-    
-    for (GraphType graphType : allTypes)
+    auto it = m_waterfallGraphs.find(graphType);
+    if (it != m_waterfallGraphs.end() && it->second)
     {
-        if (m_waterfallGraphs.find(graphType) == m_waterfallGraphs.end())
-        {
-            WaterfallGraph *graph = createWaterfallGraph(graphType);
-            m_waterfallGraphs[graphType] = graph;
-            
-            // Initially hide all graphs
-            graph->setVisible(false);
-            
-            // Set up the graph properties
-            setupWaterfallGraphProperties(graph, graphType);
-            
-            // Add to layout (only add one initially, the rest will be added as needed)
-            if (graphType == currentDataOption)
-            {
-                m_waterfallLayout->addWidget(graph, 1);
-                m_currentWaterfallGraph = graph;
-            }
-            else
-            {
-                // For other graphs, we'll add them to the layout but initially hidden
-                graph->setParent(this);
-                graph->hide();
-            }
-        }
+        return it->second;
     }
-    
-    // Connect events for all graphs
-    for (auto &pair : m_waterfallGraphs)
+
+    WaterfallGraph *graph = createWaterfallGraph(graphType);
+    m_waterfallGraphs[graphType] = graph;
+    graph->setVisible(false);
+
+    setupWaterfallGraphProperties(graph, graphType);
+    if (m_hasTimeInterval)
     {
-        connect(pair.second, &WaterfallGraph::SelectionCreated,
-                this, &GraphContainer::onSelectionCreated);
+        graph->setTimeInterval(m_timeInterval);
     }
-    
-    qDebug() << "GraphContainer: Created all waterfall graph instances";
+
+    connect(graph, &WaterfallGraph::SelectionCreated,
+            this, &GraphContainer::onSelectionCreated, Qt::UniqueConnection);
+
+    qDebug() << "GraphContainer: Constructed waterfall graph" << graphTypeToString(graphType);
+    return graph;
 }
 
 void GraphContainer::setupWaterfallGraphProperties(WaterfallGraph *graph, GraphType graphType)
@@ -796,6 +850,9 @@ void GraphContainer::setupWaterfallGraphProperties(WaterfallGraph *graph, GraphT
     {
         graph->setAutoUpdateYRange(true);
     }
+
+    graph->setRasterRenderingEnabled(m_rasterRenderingEnabled);
+    graph->setScrollingBitmapEnabled(m_scrollingBitmapEnabled);
     
     // Enable mouse selection for the waterfall graph
     graph->setMouseSelectionEnabled(false);
@@ -881,19 +938,20 @@ void GraphContainer::setupWaterfallGraphProperties(WaterfallGraph *graph, GraphT
 void GraphContainer::initializeWaterfallGraph(GraphType graphType)
 {
     // Remove current graph from layout if it exists
+    std::pair<QDateTime, QDateTime> previousTimeRange;
     if (m_currentWaterfallGraph)
     {
+        previousTimeRange = m_currentWaterfallGraph->getTimeRange();
         m_waterfallLayout->removeWidget(m_currentWaterfallGraph);
         m_currentWaterfallGraph->hide();
         m_currentWaterfallGraph->setParent(this);
     }
     
-    // Find and show the target graph
-    auto it = m_waterfallGraphs.find(graphType);
-    if (it != m_waterfallGraphs.end())
+    // Find (or construct) and show the target graph
+    bool isNewGraph = m_waterfallGraphs.find(graphType) == m_waterfallGraphs.end();
+    WaterfallGraph *targetGraph = ensureWaterfallGraph(graphType);
+    if (targetGraph)
     {
-        WaterfallGraph *targetGraph = it->second;
-        
         // Update data source if needed
         WaterfallData *dataSource = nullptr;
         auto dataIt = dataOptions.find(graphType);
@@ -910,6 +968,12 @@ void GraphContainer::initializeWaterfallGraph(GraphType graphType)
         {
             targetGraph->setDataSource(*dataSource);
         }
+
+        // A new graph starts on the window the container was showing
+        if (isNewGraph && previousTimeRange.first.isValid() && previousTimeRange.second.isValid())
+        {
+            targetGraph->setTimeRange(previousTimeRange.first, previousTimeRange.second);
+        }
         
         // Set the auto update Y range for the waterfall graph if it has stored range limits
         if (hasGraphRangeLimits(graphType))
@@ -932,6 +996,12 @@ void GraphContainer::initializeWaterfallGraph(GraphType graphType)
         applyCursorTimeToGraph(targetGraph);
         
         qDebug() << "GraphContainer: Switched to waterfall graph type:" << graphTypeToString(graphType);
+
+        // The graphs just hidden are released if they stay hidden for the idle timeout
+        if (m_idleGraphReleaseTimeoutMs > 0)
+        {
+            m_graphReleaseTimer->start(m_idleGraphReleaseTimeoutMs);
+        }
     }
     else
     {
@@ -1018,9 +1088,12 @@ void GraphContainer::updateTimeInterval(TimeInterval interval)
     // Set flag to prevent TimeScopeChanged from interfering
     m_updatingTimeInterval = true;
 
-    // Update ALL waterfall graphs' time interval (not just current one)
-    // This ensures all graphs have the correct interval when switching between them
+    // Update ALL constructed waterfall graphs' time interval (not just current one)
+    // This ensures all graphs have the correct interval when switching between them;
+    // graphs constructed later are given m_timeInterval
     // setTimeInterval() updates the interval, recalculates time ranges, and triggers a redraw
+    m_timeInterval = interval;
+    m_hasTimeInterval = true;
     for (auto &pair : m_waterfallGraphs)
     {
         if (pair.second)
@@ -1190,6 +1263,50 @@ bool GraphContainer::isMouseSelectionEnabled() const
     return false;
 }
 
+void GraphContainer::setRasterRenderingEnabled(bool enabled)
+{
+    m_rasterRenderingEnabled = enabled;
+    if (enabled)
+    {
+        m_scrollingBitmapEnabled = false; // The graphs use one backend at a time
+    }
+    for (auto &pair : m_waterfallGraphs)
+    {
+        if (pair.second)
+        {
+            pair.second->setRasterRenderingEnabled(enabled);
+        }
+    }
+    qDebug() << "GraphContainer: Raster rendering" << (enabled ? "enabled" : "disabled");
+}
+
+bool GraphContainer::isRasterRenderingEnabled() const
+{
+    return m_rasterRenderingEnabled;
+}
+
+void GraphContainer::setScrollingBitmapEnabled(bool enabled)
+{
+    m_scrollingBitmapEnabled = enabled;
+    if (enabled)
+    {
+        m_rasterRenderingEnabled = false;
+    }
+    for (auto &pair : m_waterfallGraphs)
+    {
+        if (pair.second)
+        {
+            pair.second->setScrollingBitmapEnabled(enabled);
+        }
+    }
+    qDebug() << "GraphContainer: Scrolling bitmap" << (enabled ? "enabled" : "disabled");
+}
+
+bool GraphContainer::isScrollingBitmapEnabled() const
+{
+    return m_scrollingBitmapEnabled;
+}
+
 void GraphContainer::testSelectionRectangle()
 {
     if (m_currentWaterfallGraph)
@@ -1304,7 +1421,7 @@ void GraphContainer::initializeZoomPanelLimits()
 {
     if (!m_zoomPanel)
     {
-        qDebug() << "GraphContainer: Cannot initialize zoom panel limits - no zoom panel";
+        UI_DEBUG(lcGraphContainer) << "GraphContainer: Cannot initialize zoom panel limits - no zoom panel";
         return;
     }
 
@@ -1318,7 +1435,7 @@ void GraphContainer::initializeZoomPanelLimits()
 
     if (!currentDataSource || currentDataSource->isEmpty())
     {
-        qDebug() << "GraphContainer: Cannot initialize zoom panel limits - no data available";
+        UI_DEBUG(lcGraphContainer) << "GraphContainer: Cannot initialize zoom panel limits - no data available";
         return;
     }
 
@@ -1335,7 +1452,7 @@ void GraphContainer::initializeZoomPanelLimits()
         dataMin = rangeLimit.first;
         dataMax = rangeLimit.second;
 
-        qDebug() << "GraphContainer: Using stored range limit for" << graphTypeToString(currentDataOption) << "- Min:" << dataMin << "Max:" << dataMax;
+        UI_DEBUG(lcGraphContainer) << "GraphContainer: Using stored range limit for" << graphTypeToString(currentDataOption) << "- Min:" << dataMin << "Max:" << dataMax;
     }
 
 
@@ -1359,19 +1476,20 @@ void GraphContainer::initializeZoomPanelLimits()
             m_currentWaterfallGraph->setZeroAxisValue(centerValue);
         }
         
-        qDebug() << "GraphContainer: Zoom panel limits updated - Min:" << dataMin
+        UI_DEBUG(lcGraphContainer) << "GraphContainer: Zoom panel limits updated - Min:" << dataMin
                  << "Center:" << centerValue << "Max:" << dataMax << "- User has not customized";
     }
     else
     {
         // User has customized - don't update anything (preserve all zoom state)
         // Original values remain constant, display values remain unchanged
-        qDebug() << "GraphContainer: Zoom panel limits NOT updated - user has customized zoom - preserving state";
+        UI_DEBUG(lcGraphContainer) << "GraphContainer: Zoom panel limits NOT updated - user has customized zoom - preserving state";
     }
 }
 
-void GraphContainer::onDataChanged(GraphType graphType)
+void GraphContainer::onDataChanged(GraphType graphType, const std::set<int> &seriesIds)
 {
+    PERF_SCOPE("GraphContainer::onDataChanged");
     // Only process if this container has this data option
     if (!hasDataOption(graphType))
     {
@@ -1400,14 +1518,14 @@ void GraphContainer::onDataChanged(GraphType graphType)
                 {
                     // Initialize graph time range from timeline view's current window
                     m_currentWaterfallGraph->setTimeRange(timelineWindow.startTime, timelineWindow.endTime);
-                    qDebug() << "GraphContainer: Initialized graph time range from timeline view -" 
+                    UI_DEBUG(lcGraphContainer) << "GraphContainer: Initialized graph time range from timeline view -" 
                              << timelineWindow.startTime.toString() << "to" << timelineWindow.endTime.toString();
                 }
             }
             else
             {
                 // Graph has a valid time range - check if we need to update it for new data
-                QDateTime currentTime = QDateTime::currentDateTime();
+                QDateTime currentTime = m_syncState ? m_syncState->currentClockTime() : QDateTime::currentDateTime();
                 qint64 timeDiffMs = timeRange.second.msecsTo(currentTime);
                 
                 // If timeMax is within 1 minute of current time, we're showing recent data
@@ -1433,7 +1551,7 @@ void GraphContainer::onDataChanged(GraphType graphType)
                             TimeSelectionSpan newWindow(newTimeMin, newTimeMax);
                             timelineView->setVisibleTimeWindow(newWindow);
                             
-                            qDebug() << "GraphContainer: Updated time range to show new data -" 
+                            UI_DEBUG(lcGraphContainer) << "GraphContainer: Updated time range to show new data -" 
                                      << newTimeMin.toString() << "to" << newTimeMax.toString();
                         }
                     }
@@ -1444,15 +1562,18 @@ void GraphContainer::onDataChanged(GraphType graphType)
         // Update zoom panel limits to reflect new data ranges
         initializeZoomPanelLimits();
 
-        // Force redraw of the waterfall graph
-        // This is critical - ensure graph redraws when new data arrives, even after time range changes
-        redrawWaterfallGraph();
+        // Draw only the series that changed; the graph falls back to a full redraw
+        // when the new data moved the screen mapping
+        if (m_currentWaterfallGraph)
+        {
+            m_currentWaterfallGraph->drawChangedSeries(seriesIds);
+        }
         
         // Ensure timer is running to continue animation after data update
         if (m_timer && !m_timer->isActive())
         {
             m_timer->start();
-            qDebug() << "GraphContainer: Timer restarted after data change to continue animation";
+            UI_DEBUG(lcGraphContainer) << "GraphContainer: Timer restarted after data change to continue animation";
         }
 
         // Update valid time range in TimeSelectionVisualizer from available data
@@ -1466,21 +1587,21 @@ void GraphContainer::onDataChanged(GraphType graphType)
                     QTime startTime = timeRange.first.time();
                     QTime endTime = timeRange.second.time();
                     m_timelineSelectionView->setValidSelectionRange(startTime, endTime);
-                    qDebug() << "GraphContainer: Updated TimeSelectionVisualizer valid range to" 
+                    UI_DEBUG(lcGraphContainer) << "GraphContainer: Updated TimeSelectionVisualizer valid range to" 
                              << startTime.toString() << "to" << endTime.toString();
                 }
                 else
                 {
                     // If time range is invalid, clear the valid range
                     m_timelineSelectionView->setValidSelectionRange(QTime(), QTime());
-                    qDebug() << "GraphContainer: Cleared TimeSelectionVisualizer valid range (invalid time range)";
+                    UI_DEBUG(lcGraphContainer) << "GraphContainer: Cleared TimeSelectionVisualizer valid range (invalid time range)";
                 }
             }
             catch (const std::runtime_error &e)
             {
                 // If data is empty or not available, clear the valid range
                 m_timelineSelectionView->setValidSelectionRange(QTime(), QTime());
-                qDebug() << "GraphContainer: Cleared TimeSelectionVisualizer valid range -" << e.what();
+                UI_DEBUG(lcGraphContainer) << "GraphContainer: Cleared TimeSelectionVisualizer valid range -" << e.what();
             }
         }
     }
@@ -24,6 +24,7 @@
 #include <QWidget>
 #include <functional>
 #include <map>
+#include <set>
 #include <vector>
 #include "sharedsyncstate.h"
 
@@ -80,9 +81,15 @@ public:
     // Get the current waterfall graph
     WaterfallGraph* getCurrentWaterfallGraph() const;
     
-    // Get a specific waterfall graph by type
+    // Get a specific waterfall graph by type (nullptr until it is first shown)
     WaterfallGraph* getWaterfallGraph(GraphType graphType) const;
 
+    // Graphs are constructed when first selected. With a non-zero timeout, hidden graphs are
+    // released once that long has passed since the last switch (0, the default, keeps them)
+    void setIdleGraphReleaseTimeout(int timeoutMs);
+    int getIdleGraphReleaseTimeout() const;
+    int releaseHiddenWaterfallGraphs(); // Release now, e.g. under memory pressure; returns the count
+
     // Data options management
     void addDataOption(const GraphType graphType, WaterfallData &dataSource);
     void removeDataOption(const GraphType graphType);
@@ -100,6 +107,14 @@ public:
     void setMouseSelectionEnabled(bool enabled);
     bool isMouseSelectionEnabled() const;
 
+    // Off-GUI-thread series rasterization, applied to every graph of the container
+    void setRasterRenderingEnabled(bool enabled);
+    bool isRasterRenderingEnabled() const;
+
+    // Scrolling bitmap backend (only new rows are rendered each tick), applied to every graph of the container
+    void setScrollingBitmapEnabled(bool enabled);
+    bool isScrollingBitmapEnabled() const;
+
     // Set the current time
     void setCurrentTime(const QTime &time);
     
@@ -172,7 +187,7 @@ public slots:
     void onBTWManualMarkerClicked(const QDateTime &timestamp, const QPointF &position);
     void onGraphContainerInFollowModeChanged(bool isInFollowMode);
     // Unified data change notification handler
-    void onDataChanged(GraphType graphType);
+    void onDataChanged(GraphType graphType, const std::set<int> &seriesIds);
 
 private:
     void updateTotalContainerSize();
@@ -181,7 +196,8 @@ private:
     void setupEventConnections();
     void setupEventConnectionsForWaterfallGraph();
     WaterfallGraph *createWaterfallGraph(GraphType graphType);
-    void createAllWaterfallGraphs();
+    WaterfallGraph *ensureWaterfallGraph(GraphType graphType);
+    bool canReleaseWaterfallGraph(WaterfallGraph *graph) const;
     void setupWaterfallGraphProperties(WaterfallGraph *graph, GraphType graphType);
     void initializeWaterfallGraph(GraphType graphType);
     void handleCursorTimeChanged(const QDateTime &time);
@@ -208,13 +224,17 @@ private:
     QVBoxLayout *m_waterfallLayout;
     QComboBox *m_comboBox;
     ZoomPanel *m_zoomPanel;
-    WaterfallGraph *m_currentWaterfallGraph;
+    WaterfallGraph *m_currentWaterfallGraph = nullptr;
     TimeSelectionVisualizer *m_timelineSelectionView;
     TimelineView *m_timelineView;
     bool m_showTimelineView;
 
-    // Waterfallgraph management
+    // Waterfallgraph management (constructed on first selection, see ensureWaterfallGraph)
     std::map<GraphType, WaterfallGraph *> m_waterfallGraphs;
+    TimeInterval m_timeInterval = TimeInterval::FifteenMinutes; // Given to graphs constructed later
+    bool m_hasTimeInterval = false;
+    QTimer *m_graphReleaseTimer = nullptr;
+    int m_idleGraphReleaseTimeoutMs = 0;
 
     // Timer management
     QTimer *m_timer;
@@ -248,6 +268,10 @@ private:
     // Graph container in follow mode
     bool m_isInFollowMode = true;
 
+    // Series rasterization mode of the waterfall graphs
+    bool m_rasterRenderingEnabled = false;
+    bool m_scrollingBitmapEnabled = false;
+
     // Shared synchronization state pointer
     GraphContainerSyncState *m_syncState;
     
@@ -1,11 +1,14 @@
 #include "graphlayout.h"
+#include "cursorframescheduler.h"
+#include "uilogging.h"
 #include "navtimeutils.h"
 #include "btwgraph.h"
 #include "btwinteractiveoverlay.h"
 #include <QDebug>
+#include <algorithm>
 
 GraphLayout::GraphLayout(QWidget *parent, LayoutType layoutType, QTimer *timer, std::map<GraphType, std::vector<QPair<QString, QColor>>> seriesLabelsMap)
-    : QWidget{parent}, m_layoutType(layoutType), m_timer(timer)
+    : QWidget{parent}, m_layoutType(layoutType), m_timer(timer), m_frameTimer(nullptr), m_frameRequested(false), m_recorder(nullptr), m_recordingTimer(nullptr)
 {
 
     // If the timer is not provided, create a default 1-second timer
@@ -52,10 +55,20 @@ GraphLayout::GraphLayout(QWidget *parent, LayoutType layoutType, QTimer *timer,
 
     // Initialize the graph containers layout
     setLayoutType(layoutType);
+
+    // One frame (~16 ms) after the first change on the GUI thread: drain the ingestion
+    // rings, then deliver the coalesced data-change notifications. Idle layouts do not tick.
+    m_frameTimer = new QTimer(this);
+    m_frameTimer->setSingleShot(true);
+    m_frameTimer->setInterval(16);
+    connect(m_frameTimer, &QTimer::timeout, this, &GraphLayout::onFrameTick);
 }
 
 GraphLayout::~GraphLayout()
 {
+    // Finish the recording (writes its time index) while the data sources are intact
+    stopRecording();
+
     // Clean up graph containers
     for (auto *container : m_graphContainers)
     {
@@ -63,6 +76,13 @@ GraphLayout::~GraphLayout()
     }
     m_graphContainers.clear();
 
+    // Producers must have stopped before the layout is destroyed
+    for (auto &pair : m_ingestQueues)
+    {
+        delete pair.second;
+    }
+    m_ingestQueues.clear();
+
     // Layouts will be automatically cleaned up by Qt's parent-child system
     // since they have this widget as parent
 }
@@ -299,6 +319,14 @@ void GraphLayout::initializeDataSources(std::map<GraphType, std::vector<QPair<QS
         
         // Create WaterfallData with series labels
         m_dataSources[graphType] = new WaterfallData(graphTypeToString(graphType), seriesLabels);
+
+        // Bound history to the longest selectable window so the display can run unattended
+        WaterfallRetentionPolicy retentionPolicy;
+        retentionPolicy.maxAgeMs = timeIntervalToMs(TimeInterval::TwelveHours);
+        m_dataSources[graphType]->setRetentionPolicy(retentionPolicy);
+
+        // Ingestion ring for producers running on other threads
+        m_ingestQueues[graphType] = new IngestQueue();
         
         // Set colors for each series (this will require updating WaterfallData to support colors)
         for (const auto& seriesPair : seriesData) {
@@ -776,20 +804,14 @@ void GraphLayout::addDataPointToDataSource(const GraphType &graphType, const QSt
     if (it != m_dataSources.end())
     {
         it->second->addDataPointToSeries(seriesLabel, yValue, timestamp);
-        qDebug() << "Added data point to" << dataSourceLabel << "series" << seriesLabel << "y:" << yValue << "time:" << timestamp.toString();
+        UI_DEBUG(lcWaterfallData) << "Added data point to" << dataSourceLabel << "series" << seriesLabel << "y:" << yValue << "time:" << timestamp.toString();
 
-        // Notify all containers that have this data source to update their UI
-        for (auto *container : m_graphContainers)
-        {
-            if (container)
-            {
-                container->onDataChanged(graphType);
-            }
-        }
+        // Coalesced: containers are notified once on the next frame tick
+        notifyDataChanged(graphType, seriesLabel);
     }
     else
     {
-        qDebug() << "Data source not found:" << dataSourceLabel;
+        UI_WARNING(lcWaterfallData) << "Data source not found:" << dataSourceLabel;
     }
 }
 
@@ -800,23 +822,412 @@ void GraphLayout::addDataPointsToDataSource(const GraphType &graphType, const QS
     if (it != m_dataSources.end())
     {
         it->second->addDataPointsToSeries(seriesLabel, yValues, timestamps);
-        qDebug() << "Added" << yValues.size() << "data points to" << dataSourceLabel << "series" << seriesLabel;
+        UI_DEBUG(lcWaterfallData) << "Added" << yValues.size() << "data points to" << dataSourceLabel << "series" << seriesLabel;
+
+        // Coalesced: containers are notified once on the next frame tick
+        notifyDataChanged(graphType, seriesLabel);
+    }
+    else
+    {
+        UI_WARNING(lcWaterfallData) << "Data source not found:" << dataSourceLabel;
+    }
+}
+
+/**
+ * @brief Append samples to a data source series from raw epoch-ms and value columns.
+ *
+ * @param graphType Graph type whose data source receives the samples
+ * @param seriesLabel Series label
+ * @param yValues Pointer to count values
+ * @param timestampsMs Pointer to count timestamps in milliseconds since epoch
+ * @param count Number of samples
+ */
+void GraphLayout::addDataPointsToDataSource(const GraphType &graphType, const QString &seriesLabel, const qreal *yValues, const qint64 *timestampsMs, size_t count)
+{
+    auto it = m_dataSources.find(graphType);
+    if (it == m_dataSources.end())
+    {
+        UI_WARNING(lcWaterfallData) << "Data source not found:" << graphTypeToString(graphType);
+        return;
+    }
+
+    it->second->addDataPointsToSeries(seriesLabel, yValues, timestampsMs, count);
+    UI_DEBUG(lcWaterfallData) << "Added" << count << "data points to" << graphTypeToString(graphType) << "series" << seriesLabel;
+
+    notifyDataChanged(graphType, seriesLabel);
+}
+
+/**
+ * @brief Append samples to several series of a data source in one call.
+ *
+ * @param graphType Graph type whose data source receives the samples
+ * @param batch One entry per series
+ */
+void GraphLayout::addDataBatchToDataSource(const GraphType &graphType, const std::vector<WaterfallSeriesBatch> &batch)
+{
+    auto it = m_dataSources.find(graphType);
+    if (it == m_dataSources.end())
+    {
+        UI_WARNING(lcWaterfallData) << "Data source not found:" << graphTypeToString(graphType);
+        return;
+    }
+
+    it->second->addDataBatch(batch);
+    UI_DEBUG(lcWaterfallData) << "Added batch of" << batch.size() << "series to" << graphTypeToString(graphType);
+
+    for (const WaterfallSeriesBatch &entry : batch)
+    {
+        notifyDataChanged(graphType, entry.seriesLabel);
+    }
+}
+
+/**
+ * @brief Enqueue a sample from any thread without blocking.
+ *
+ * Each graph type has a single-producer/single-consumer ring: at most one thread may
+ * produce samples for a given graph type. The GUI thread applies queued samples in
+ * one batch per frame (see drainIngestQueues).
+ *
+ * Setup-only convenience: the label is interned on every call, which takes the global
+ * SeriesRegistry mutex, so this overload is not lock-free. Producers should intern each
+ * label once with SeriesRegistry::intern and enqueue through the ID overload, or use
+ * enqueueDataPoints for runs of one series.
+ *
+ * @param graphType Graph type whose data source receives the sample
+ * @param seriesLabel Series label
+ * @param yValue Sample value
+ * @param timestampMs Sample time in milliseconds since epoch
+ * @return false if the graph type is unknown or its ring is full (the sample is dropped)
+ */
+bool GraphLayout::enqueueDataPoint(const GraphType &graphType, const QString &seriesLabel, qreal yValue, qint64 timestampMs)
+{
+    return enqueueDataPoint(graphType, SeriesRegistry::intern(seriesLabel), yValue, timestampMs);
+}
+
+/**
+ * @brief Enqueue a sample of a series identified by its interned ID, without blocking or locking.
+ *
+ * @param graphType Graph type whose data source receives the sample
+ * @param seriesId Interned series ID (see SeriesRegistry)
+ * @param yValue Sample value
+ * @param timestampMs Sample time in milliseconds since epoch
+ * @return false if the graph type is unknown or its ring is full (the sample is dropped)
+ */
+bool GraphLayout::enqueueDataPoint(const GraphType &graphType, int seriesId, qreal yValue, qint64 timestampMs)
+{
+    auto it = m_ingestQueues.find(graphType);
+    if (it == m_ingestQueues.end() || seriesId < 0)
+    {
+        return false;
+    }
+
+    IngestSample sample;
+    sample.seriesId = seriesId;
+    sample.yValue = yValue;
+    sample.timestampMs = timestampMs;
+    if (!it->second->push(sample))
+    {
+        return false;
+    }
+
+    // Arm the frame timer on the GUI thread, posting at most once per frame
+    if (!m_frameRequested.exchange(true))
+    {
+        QMetaObject::invokeMethod(this, [this]() { scheduleFrame(); }, Qt::QueuedConnection);
+    }
+    return true;
+}
+
+/**
+ * @brief Enqueue a run of samples of one series, interning its label once for the whole run.
+ *
+ * @param graphType Graph type whose data source receives the samples
+ * @param seriesLabel Series label
+ * @param yValues Pointer to count values
+ * @param timestampsMs Pointer to count timestamps in milliseconds since epoch
+ * @param count Number of samples
+ * @return size_t Number of samples queued; the rest were dropped because the ring was full
+ */
+size_t GraphLayout::enqueueDataPoints(const GraphType &graphType, const QString &seriesLabel, const qreal *yValues, const qint64 *timestampsMs, size_t count)
+{
+    const int seriesId = SeriesRegistry::intern(seriesLabel);
+    size_t queued = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (enqueueDataPoint(graphType, seriesId, yValues[i], timestampsMs[i]))
+        {
+            ++queued;
+        }
+    }
+    return queued;
+}
+
+/**
+ * @brief Get the number of samples dropped because a graph type's ring was full.
+ *
+ * @param graphType Graph type
+ * @return quint64 Dropped sample count
+ */
+quint64 GraphLayout::getDroppedSampleCount(const GraphType &graphType) const
+{
+    auto it = m_ingestQueues.find(graphType);
+    return it != m_ingestQueues.end() ? it->second->droppedCount() : 0;
+}
+
+/**
+ * @brief Apply all queued samples to their data sources, one batch per graph type.
+ *
+ * The resulting data-change notifications are coalesced with any others raised in the
+ * same frame (see flushDataChanges).
+ */
+void GraphLayout::drainIngestQueues()
+{
+    for (auto &pair : m_ingestQueues)
+    {
+        m_ingestBatch.clear();
+        if (pair.second->drain(m_ingestBatch) == 0)
+        {
+            continue;
+        }
+
+        GraphType graphType = pair.first;
+        auto sourceIt = m_dataSources.find(graphType);
+        if (sourceIt == m_dataSources.end())
+        {
+            continue;
+        }
+
+        // Collect each distinct series once, so the dirty set is not touched per sample
+        m_ingestBatchSeries.clear();
+        int lastSeriesId = -1;
+        for (const IngestSample &sample : m_ingestBatch)
+        {
+            sourceIt->second->addDataPointToSeries(sample.seriesId, sample.yValue, sample.timestampMs);
+            if (sample.seriesId != lastSeriesId)
+            {
+                lastSeriesId = sample.seriesId;
+                if (std::find(m_ingestBatchSeries.begin(), m_ingestBatchSeries.end(), lastSeriesId) == m_ingestBatchSeries.end())
+                {
+                    m_ingestBatchSeries.push_back(lastSeriesId);
+                }
+            }
+        }
+        for (int seriesId : m_ingestBatchSeries)
+        {
+            notifyDataChanged(graphType, seriesId);
+        }
+        UI_DEBUG(lcWaterfallData) << "Drained" << m_ingestBatch.size() << "queued samples into" << graphTypeToString(graphType);
+    }
+}
+
+/**
+ * @brief Record that a series of a data source changed.
+ *
+ * Notifications are not delivered immediately: every change raised within one frame is
+ * gathered into a dirty set that flushDataChanges delivers once, so redraw work scales
+ * with the number of graphs on screen rather than with the number of samples added.
+ *
+ * @param graphType Graph type whose data source changed
+ * @param seriesLabel Series that changed
+ */
+void GraphLayout::notifyDataChanged(const GraphType &graphType, const QString &seriesLabel)
+{
+    notifyDataChanged(graphType, SeriesRegistry::intern(seriesLabel));
+}
+
+void GraphLayout::notifyDataChanged(const GraphType &graphType, int seriesId)
+{
+    m_pendingDataChanges[graphType].insert(seriesId);
+    scheduleFrame();
+}
+
+/**
+ * @brief Deliver the pending data-change notifications, once per dirty graph type.
+ *
+ * Each container redraws its displayed graph at most once per dirty graph type, however
+ * many samples or series changed since the previous flush.
+ */
+void GraphLayout::flushDataChanges()
+{
+    if (m_pendingDataChanges.empty())
+    {
+        return;
+    }
+
+    // Swap out first so notifications raised while redrawing land in the next frame
+    std::map<GraphType, std::set<int>> pending;
+    pending.swap(m_pendingDataChanges);
+
+    for (const auto &pair : pending)
+    {
+        UI_DEBUG(lcWaterfallData) << "Flushing data change for" << graphTypeToString(pair.first) << "-" << pair.second.size() << "series changed";
 
         // Notify all containers that have this data source to update their UI
         for (auto *container : m_graphContainers)
         {
             if (container)
             {
-                container->onDataChanged(graphType);
+                container->onDataChanged(pair.first, pair.second);
             }
         }
     }
-    else
+}
+
+/**
+ * @brief Per-frame tick: apply queued samples, then flush coalesced notifications.
+ *
+ */
+void GraphLayout::onFrameTick()
+{
+    // Samples queued from here on post a new request
+    m_frameRequested.store(false);
+    drainIngestQueues();
+
+    // The changes just drained are flushed now; only changes raised by the flush need another frame
+    m_frameTimer->stop();
+    flushDataChanges();
+}
+
+/**
+ * @brief Arm the single-shot frame timer unless a frame is already pending (GUI thread only).
+ *
+ */
+void GraphLayout::scheduleFrame()
+{
+    if (m_frameTimer && !m_frameTimer->isActive())
     {
-        qDebug() << "Data source not found:" << dataSourceLabel;
+        m_frameTimer->start();
     }
 }
 
+/**
+ * @brief Start recording every data source to a session recording file.
+ *
+ * The data already held by the data sources is written immediately; later samples and
+ * annotation changes are appended once per second until stopRecording is called.
+ *
+ * @param filePath Path of the recording (overwritten if it exists)
+ * @return true if recording started
+ */
+bool GraphLayout::startRecording(const QString &filePath)
+{
+    stopRecording();
+
+    m_recorder = new SessionRecorder();
+    if (!m_recorder->open(filePath))
+    {
+        delete m_recorder;
+        m_recorder = nullptr;
+        return false;
+    }
+    recordDataSources();
+
+    m_recordingTimer = new QTimer(this);
+    m_recordingTimer->setInterval(1000);
+    connect(m_recordingTimer, &QTimer::timeout, this, &GraphLayout::recordDataSources);
+    m_recordingTimer->start();
+    return true;
+}
+
+/**
+ * @brief Write the remaining data and the time index, then close the recording.
+ *
+ */
+void GraphLayout::stopRecording()
+{
+    if (!m_recorder)
+    {
+        return;
+    }
+
+    if (m_recordingTimer)
+    {
+        m_recordingTimer->stop();
+        m_recordingTimer->deleteLater();
+        m_recordingTimer = nullptr;
+    }
+
+    recordDataSources();
+    m_recorder->close();
+    delete m_recorder;
+    m_recorder = nullptr;
+}
+
+bool GraphLayout::isRecording() const
+{
+    return m_recorder && m_recorder->isOpen();
+}
+
+/**
+ * @brief Append the data recorded since the previous call for every data source.
+ *
+ */
+void GraphLayout::recordDataSources()
+{
+    if (!m_recorder)
+    {
+        return;
+    }
+
+    // Samples still queued for ingestion belong to this interval
+    drainIngestQueues();
+    for (const auto &pair : m_dataSources)
+    {
+        if (pair.second)
+        {
+            m_recorder->recordDataSource(pair.first, *pair.second);
+        }
+    }
+}
+
+/**
+ * @brief Replace the contents of the data sources with a session recording.
+ *
+ * The file is memory-mapped and its columns are bulk-appended directly into the data
+ * sources; graph types that are not part of this layout are ignored. The graphs draw from
+ * WaterfallData only, so loading copies every recorded sample and costs O(recording size);
+ * zero-copy range queries on the mapping (getSeriesViews) are what ReplayEngine uses.
+ * Retention is switched off for the loaded data sources, so a session longer than the
+ * live retention window is shown whole.
+ *
+ * @param filePath Path of the recording
+ * @return true if at least one data source was loaded
+ */
+bool GraphLayout::loadRecording(const QString &filePath)
+{
+    SessionRecordingReader reader;
+    if (!reader.open(filePath))
+    {
+        return false;
+    }
+
+    bool loaded = false;
+    for (const GraphType &graphType : reader.getGraphTypes())
+    {
+        auto it = m_dataSources.find(graphType);
+        if (it == m_dataSources.end() || !it->second)
+        {
+            qDebug() << "Recording has data for" << graphTypeToString(graphType) << "which is not in this layout";
+            continue;
+        }
+
+        // The live retention policy would drop everything older than 12h of the session
+        it->second->setRetentionPolicy(WaterfallRetentionPolicy());
+
+        if (reader.loadInto(graphType, *it->second))
+        {
+            for (const QString &seriesLabel : reader.getSeriesLabels(graphType))
+            {
+                notifyDataChanged(graphType, seriesLabel);
+            }
+            loaded = true;
+        }
+    }
+
+    flushDataChanges();
+    return loaded;
+}
+
 void GraphLayout::setDataToDataSource(const GraphType &graphType, const QString &seriesLabel, const std::vector<qreal> &yData, const std::vector<QDateTime> &timestamps)
 {
     QString dataSourceLabel = graphTypeToString(graphType);
@@ -824,20 +1235,14 @@ void GraphLayout::setDataToDataSource(const GraphType &graphType, const QString
     if (it != m_dataSources.end())
     {
         it->second->setDataSeries(seriesLabel, yData, timestamps);
-        qDebug() << "Set data for" << dataSourceLabel << "series" << seriesLabel << "size:" << yData.size();
+        UI_DEBUG(lcWaterfallData) << "Set data for" << dataSourceLabel << "series" << seriesLabel << "size:" << yData.size();
 
-        // Notify all containers that have this data source to update their UI
-        for (auto *container : m_graphContainers)
-        {
-            if (container)
-            {
-                container->onDataChanged(graphType);
-            }
-        }
+        // Coalesced: containers are notified once on the next frame tick
+        notifyDataChanged(graphType, seriesLabel);
     }
     else
     {
-        qDebug() << "Data source not found:" << dataSourceLabel;
+        UI_WARNING(lcWaterfallData) << "Data source not found:" << dataSourceLabel;
     }
 }
 
@@ -858,20 +1263,14 @@ void GraphLayout::setDataToDataSource(const GraphType &graphType, const QString
         }
         
         it->second->setDataSeries(seriesLabel, yData, timestamps);
-        qDebug() << "Set data for" << dataSourceLabel << "series" << seriesLabel << "from WaterfallData object";
+        UI_DEBUG(lcWaterfallData) << "Set data for" << dataSourceLabel << "series" << seriesLabel << "from WaterfallData object";
 
-        // Notify all containers that have this data source to update their UI
-        for (auto *container : m_graphContainers)
-        {
-            if (container)
-            {
-                container->onDataChanged(graphType);
-            }
-        }
+        // Coalesced: containers are notified once on the next frame tick
+        notifyDataChanged(graphType, seriesLabel);
     }
     else
     {
-        qDebug() << "Data source not found:" << dataSourceLabel;
+        UI_WARNING(lcWaterfallData) << "Data source not found:" << dataSourceLabel;
     }
 }
 
@@ -882,20 +1281,14 @@ void GraphLayout::clearDataSource(const GraphType &graphType, const QString &ser
     if (it != m_dataSources.end())
     {
         it->second->clearDataSeries(seriesLabel);
-        qDebug() << "Cleared data for" << dataSourceLabel << "series" << seriesLabel;
+        UI_DEBUG(lcWaterfallData) << "Cleared data for" << dataSourceLabel << "series" << seriesLabel;
 
-        // Notify all containers that have this data source to update their UI
-        for (auto *container : m_graphContainers)
-        {
-            if (container)
-            {
-                container->onDataChanged(graphType);
-            }
-        }
+        // Coalesced: containers are notified once on the next frame tick
+        notifyDataChanged(graphType, seriesLabel);
     }
     else
     {
-        qDebug() << "Data source not found:" << dataSourceLabel;
+        UI_WARNING(lcWaterfallData) << "Data source not found:" << dataSourceLabel;
     }
 }
 
@@ -1028,6 +1421,48 @@ void GraphLayout::setCurrentTime(const QTime &time)
     }
 }
 
+/**
+ * @brief Set the replay clock, which overrides the wall clock until clearReplayClock is called.
+ *
+ * The containers compare data times against the full date and time of this clock, so
+ * recordings from another day or crossing midnight follow the right window. The timeline
+ * widgets take the time of day only.
+ *
+ * @param timeMs Replay time in milliseconds since epoch
+ */
+void GraphLayout::setReplayClock(qint64 timeMs)
+{
+    m_syncState.replayClockMs = timeMs;
+    m_syncState.hasReplayClock = true;
+
+    QDateTime replayTime = QDateTime::fromMSecsSinceEpoch(timeMs);
+    NavTimeUtils navTimeUtils;
+    m_syncState.currentNavTime = navTimeUtils.covertSystemTimeToNavTime(replayTime);
+    m_syncState.hasCurrentNavTime = true;
+
+    setCurrentTime(replayTime.time());
+}
+
+/**
+ * @brief Return to the wall clock.
+ *
+ */
+void GraphLayout::clearReplayClock()
+{
+    if (!m_syncState.hasReplayClock)
+    {
+        return;
+    }
+
+    m_syncState.hasReplayClock = false;
+    onTimerTick();
+}
+
+bool GraphLayout::hasReplayClock() const
+{
+    return m_syncState.hasReplayClock;
+}
+
 void GraphLayout::deleteInteractiveMarkers()
 {
     qDebug() << "GraphLayout: deleteInteractiveMarkers invoked";
@@ -1301,6 +1736,12 @@ void GraphLayout::syncAllTimelineViews()
 
 void GraphLayout::onTimerTick()
 {
+    // A replay drives the clock itself; the wall clock would pull follow mode back to now
+    if (m_syncState.hasReplayClock)
+    {
+        return;
+    }
+
     setCurrentTime(QTime::currentTime());
     
     // Update current navtime in sync state
@@ -1426,16 +1867,9 @@ void GraphLayout::registerCursorSyncCallbacks()
 
 void GraphLayout::onContainerCursorTimeChanged(GraphContainer *source, const QDateTime &time)
 {
-    // Update shared sync state
-    if (time.isValid())
-    {
-        m_syncState.cursorTime = time;
-        m_syncState.hasCursorTime = true;
-    }
-    else
-    {
-        m_syncState.hasCursorTime = false;
-    }
+    // Update shared sync state; the cursor layers repaint on the next frame if it changed
+    m_syncState.setCursorTime(time);
+    CursorFrameScheduler::instance()->requestFrame();
 
     // Propagate cursor time to all containers' timeline views
     // The source container already updated its timeline view in handleCursorTimeChanged
@@ -1458,8 +1892,7 @@ void GraphLayout::onContainerCursorTimeChanged(GraphContainer *source, const QDa
         }
     }
 
-    // All containers now read from sync state via timer for cursor layer
-    // The cursor layer in each WaterfallGraph will automatically read from m_syncState
+    // The cursor layer in each WaterfallGraph reads the new cursor revision from m_syncState
 }
 
 void GraphLayout::onTimeSelectionsCleared()
@@ -1520,24 +1953,19 @@ void GraphLayout::onBTWManualMarkerPlaced(const QDateTime &timestamp, const QPoi
         if (btwDataSource && !btwDataSource->isEmpty())
         {
             // Try to find a data point near this timestamp
+            const qint64 timestampMs = timestamp.toMSecsSinceEpoch();
             std::vector<QString> seriesLabels = btwDataSource->getDataSeriesLabels();
             for (const QString &seriesLabel : seriesLabels)
             {
-                const std::vector<QDateTime> &timestamps = btwDataSource->getTimestampsSeries(seriesLabel);
-                const std::vector<qreal> &yData = btwDataSource->getYDataSeries(seriesLabel);
-                
-                for (size_t i = 0; i < timestamps.size(); ++i)
+                // Samples within 1 second of the timestamp
+                WaterfallSeriesView nearby = btwDataSource->getDataSeriesView(seriesLabel, timestampMs - 999, timestampMs + 999);
+                if (!nearby.empty())
                 {
-                    qint64 timeDiff = qAbs(timestamps[i].msecsTo(timestamp));
-                    if (timeDiff < 1000) // Within 1 second
-                    {
-                        range = yData[i];
-                        foundRange = true;
-                        qDebug() << "GraphLayout: Found range" << range << "from data at timestamp";
-                        break;
-                    }
+                    range = nearby.yData[0];
+                    foundRange = true;
+                    qDebug() << "GraphLayout: Found range" << range << "from data at timestamp";
+                    break;
                 }
-                if (foundRange) break;
             }
         }
     }
@@ -1555,6 +1983,56 @@ void GraphLayout::onBTWManualMarkerPlaced(const QDateTime &timestamp, const QPoi
 }
 
 // Chevron label control methods implementation - operate on all visible containers
+void GraphLayout::setRasterRenderingEnabled(bool enabled)
+{
+    for (auto *container : m_graphContainers)
+    {
+        if (container)
+        {
+            container->setRasterRenderingEnabled(enabled);
+        }
+    }
+    qDebug() << "GraphLayout: Raster rendering" << (enabled ? "enabled" : "disabled") << "for all containers";
+}
+
+void GraphLayout::setScrollingBitmapEnabled(bool enabled)
+{
+    for (auto *container : m_graphContainers)
+    {
+        if (container)
+        {
+            container->setScrollingBitmapEnabled(enabled);
+        }
+    }
+    qDebug() << "GraphLayout: Scrolling bitmap" << (enabled ? "enabled" : "disabled") << "for all containers";
+}
+
+void GraphLayout::setIdleGraphReleaseTimeout(int timeoutMs)
+{
+    for (auto *container : m_graphContainers)
+    {
+        if (container)
+        {
+            container->setIdleGraphReleaseTimeout(timeoutMs);
+        }
+    }
+    qDebug() << "GraphLayout: Idle graph release timeout set to" << timeoutMs << "ms for all containers";
+}
+
+int GraphLayout::releaseHiddenWaterfallGraphs()
+{
+    int released = 0;
+    for (auto *container : m_graphContainers)
+    {
+        if (container)
+        {
+            released += container->releaseHiddenWaterfallGraphs();
+        }
+    }
+    qDebug() << "GraphLayout: Released" << released << "hidden waterfall graphs";
+    return released;
+}
+
 void GraphLayout::setChevronLabel1(const QString &label)
 {
     for (auto *container : m_graphContainers)
@@ -2124,17 +2602,20 @@ void GraphLayout::addBTWSymbolToAllGraphs(const QDateTime &timestamp, qreal /* u
         
         // Try to find a data point at the given timestamp (within tolerance)
         const qint64 timeToleranceMs = 1000; // 1 second tolerance
+        const qint64 timestampMs = timestamp.toMSecsSinceEpoch();
         qint64 closestTimeDiff = timeToleranceMs;
         
         for (const QString &seriesLabel : seriesLabels)
         {
-            const std::vector<QDateTime> &timestamps = dataSource->getTimestampsSeries(seriesLabel);
-            const std::vector<qreal> &yData = dataSource->getYDataSeries(seriesLabel);
+            // Only samples inside the tolerance window can qualify
+            WaterfallSeriesView nearby = dataSource->getDataSeriesView(seriesLabel, timestampMs - timeToleranceMs, timestampMs + timeToleranceMs);
+            const qint64 *timestamps = nearby.timestampsMs;
+            const qreal *yData = nearby.yData;
             
             // Find the closest data point to the target timestamp
-            for (size_t i = 0; i < timestamps.size(); ++i)
+            for (size_t i = 0; i < nearby.size(); ++i)
             {
-                qint64 timeDiff = qAbs(timestamps[i].msecsTo(timestamp));
+                qint64 timeDiff = qAbs(timestamps[i] - timestampMs);
                 if (timeDiff < closestTimeDiff)
                 {
                     closestTimeDiff = timeDiff;
@@ -3,6 +3,8 @@
 
 #include "graphcontainer.h"
 #include "graphtype.h"
+#include "ingestqueue.h"
+#include "sessionrecording.h"
 #include "waterfalldata.h"
 #include <QDateTime>
 #include <QHBoxLayout>
@@ -11,7 +13,9 @@
 #include <QTimer>
 #include <QVBoxLayout>
 #include <QWidget>
+#include <atomic>
 #include <map>
+#include <set>
 #include <vector>
 #include "sharedsyncstate.h"
 
@@ -59,10 +63,30 @@ public:
     // Data point methods for specific data sources
     void addDataPointToDataSource(const GraphType &graphType, const QString &seriesLabel, qreal yValue, const QDateTime &timestamp);
     void addDataPointsToDataSource(const GraphType &graphType, const QString &seriesLabel, const std::vector<qreal> &yValues, const std::vector<QDateTime> &timestamps);
+    void addDataPointsToDataSource(const GraphType &graphType, const QString &seriesLabel, const qreal *yValues, const qint64 *timestampsMs, size_t count);
+    void addDataBatchToDataSource(const GraphType &graphType, const std::vector<WaterfallSeriesBatch> &batch);
     void setDataToDataSource(const GraphType &graphType, const QString &seriesLabel, const std::vector<qreal> &yData, const std::vector<QDateTime> &timestamps);
     void setDataToDataSource(const GraphType &graphType, const QString &seriesLabel, const WaterfallData &data);
     void clearDataSource(const GraphType &graphType, const QString &seriesLabel);
 
+    // Thread-safe producer API: one producer thread per graph type may enqueue samples,
+    // which the GUI thread drains and applies once per frame. The label overload interns under
+    // the registry mutex on every call (setup-only); producers intern once and use the ID overload
+    bool enqueueDataPoint(const GraphType &graphType, const QString &seriesLabel, qreal yValue, qint64 timestampMs);
+    bool enqueueDataPoint(const GraphType &graphType, int seriesId, qreal yValue, qint64 timestampMs);
+    size_t enqueueDataPoints(const GraphType &graphType, const QString &seriesLabel, const qreal *yValues, const qint64 *timestampsMs, size_t count);
+    quint64 getDroppedSampleCount(const GraphType &graphType) const;
+
+    // Deliver pending data-change notifications now instead of on the next frame tick
+    void flushDataChanges();
+
+    // Session recording: while recording, new samples and annotations of every data source
+    // are appended to the file once per second; loading replaces the data sources' contents
+    bool startRecording(const QString &filePath);
+    void stopRecording();
+    bool isRecording() const;
+    bool loadRecording(const QString &filePath);
+
     // Data source management
     WaterfallData *getDataSource(const GraphType &graphType);
     bool hasDataSource(const GraphType &graphType) const;
@@ -80,8 +104,23 @@ public:
 
     // Set the current time
     void setCurrentTime(const QTime &time);
+
+    // Drive the current time from a replay instead of the wall clock (full date and time)
+    void setReplayClock(qint64 timeMs);
+    void clearReplayClock();
+    bool hasReplayClock() const;
     void deleteInteractiveMarkers();
 
+    // Rasterize the series of every graph on the thread pool instead of the GUI thread
+    void setRasterRenderingEnabled(bool enabled);
+
+    // Scroll a backing bitmap of every graph and render only the newly exposed rows
+    void setScrollingBitmapEnabled(bool enabled);
+
+    // Release graphs hidden in their containers, after an idle timeout (0 keeps them) or now
+    void setIdleGraphReleaseTimeout(int timeoutMs);
+    int releaseHiddenWaterfallGraphs();
+
     // Selection linking methods
     void linkHorizontalContainers();
     
@@ -151,6 +190,10 @@ protected:
 
 public slots:
     void onTimerTick();
+    void drainIngestQueues();
+    void onFrameTick();
+    void scheduleFrame();
+    void recordDataSources();
     void onTimeSelectionCreated(const TimeSelectionSpan &selection);
     void onTimeSelectionsCleared();
     void onBTWManualMarkerPlaced(const QDateTime &timestamp, const QPointF &position);
@@ -170,6 +213,21 @@ private:
 
     std::map<GraphType, WaterfallData *> m_dataSources;
 
+    // Per graph type ingestion rings, created once in initializeDataSources and never
+    // modified afterwards so producer threads can look them up without locking
+    std::map<GraphType, IngestQueue *> m_ingestQueues;
+    std::vector<IngestSample> m_ingestBatch; // Reused drain buffer (GUI thread only)
+    std::vector<int> m_ingestBatchSeries; // Distinct series of the drained batch (GUI thread only)
+
+    // Series changed since the last frame, keyed by graph type (flushed by onFrameTick)
+    std::map<GraphType, std::set<int>> m_pendingDataChanges; // Interned series IDs
+    QTimer *m_frameTimer; // Single-shot, armed by the first change of a frame
+    std::atomic<bool> m_frameRequested; // A producer thread already asked the GUI thread to arm m_frameTimer
+
+    // Session recorder and the timer that flushes new data to it (null when not recording)
+    SessionRecorder *m_recorder;
+    QTimer *m_recordingTimer;
+
     // Series colors map
     std::map<QString, QColor> m_seriesColorsMap;
 
@@ -186,6 +244,10 @@ private:
     // Helper to add BTW symbol (magenta circle) to all graphs at a timestamp
     void addBTWSymbolToAllGraphs(const QDateTime &timestamp, qreal range);
 
+    // Queue a coalesced data-change notification for the next frame
+    void notifyDataChanged(const GraphType &graphType, const QString &seriesLabel);
+    void notifyDataChanged(const GraphType &graphType, int seriesId);
+
     // Container synchronization state
     GraphContainerSyncState m_syncState;
 
@@ -0,0 +1,66 @@
+#include "ingestqueue.h"
+
+IngestQueue::IngestQueue(size_t capacity)
+    : m_mask(0), m_tail(0), m_head(0), m_dropped(0)
+{
+    size_t roundedCapacity = 2;
+    while (roundedCapacity < capacity)
+    {
+        roundedCapacity *= 2;
+    }
+    m_slots.resize(roundedCapacity);
+    m_mask = roundedCapacity - 1;
+}
+
+/**
+ * @brief Push a sample (producer thread only).
+ *
+ * @param sample Sample to enqueue
+ * @return false if the ring is full; the sample is dropped and counted
+ */
+bool IngestQueue::push(const IngestSample &sample)
+{
+    const size_t tail = m_tail.load(std::memory_order_relaxed);
+    const size_t head = m_head.load(std::memory_order_acquire);
+    if (tail - head >= m_slots.size())
+    {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    m_slots[tail & m_mask] = sample;
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Move queued samples into a batch (consumer thread only).
+ *
+ * @param out Batch the samples are appended to
+ * @param maxCount Maximum number of samples to take, 0 for all that are queued
+ * @return size_t Number of samples taken
+ */
+size_t IngestQueue::drain(std::vector<IngestSample> &out, size_t maxCount)
+{
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    const size_t tail = m_tail.load(std::memory_order_acquire);
+    size_t count = tail - head;
+    if (maxCount > 0 && count > maxCount)
+    {
+        count = maxCount;
+    }
+
+    out.reserve(out.size() + count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        out.push_back(std::move(m_slots[(head + i) & m_mask]));
+    }
+
+    m_head.store(head + count, std::memory_order_release);
+    return count;
+}
+
+bool IngestQueue::isEmpty() const
+{
+    return m_tail.load(std::memory_order_acquire) == m_head.load(std::memory_order_acquire);
+}
@@ -0,0 +1,41 @@
+#ifndef INGESTQUEUE_H
+#define INGESTQUEUE_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <vector>
+
+// One sample handed from a producer thread to the GUI thread
+struct IngestSample
+{
+    int seriesId = -1; // Interned series ID (see SeriesRegistry), resolved by the producer
+    qreal yValue = 0.0;
+    qint64 timestampMs = 0; // Milliseconds since epoch
+};
+
+// Bounded lock-free single-producer/single-consumer ring of samples
+// push() may be called from exactly one producer thread and drain() from exactly one
+// consumer thread (the GUI thread); neither side ever blocks or takes a lock
+class IngestQueue
+{
+public:
+    explicit IngestQueue(size_t capacity = 65536);
+
+    bool push(const IngestSample &sample);
+    size_t drain(std::vector<IngestSample> &out, size_t maxCount = 0);
+
+    size_t capacity() const { return m_slots.size(); }
+    bool isEmpty() const;
+    quint64 droppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    std::vector<IngestSample> m_slots; // Capacity is a power of two
+    size_t m_mask;
+
+    // Producer and consumer indices live on separate cache lines to avoid false sharing
+    alignas(64) std::atomic<size_t> m_tail; // Next slot to write (producer)
+    alignas(64) std::atomic<size_t> m_head; // Next slot to read (consumer)
+    alignas(64) std::atomic<quint64> m_dropped; // Samples rejected because the ring was full
+};
+
+#endif // INGESTQUEUE_H
@@ -0,0 +1,111 @@
+#include "intensitycolormap.h"
+#include <QColor>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define INTENSITYCOLORMAP_SSE2 1
+#endif
+
+IntensityColorMap::IntensityColorMap()
+    : IntensityColorMap(QGradientStops{{0.0, Qt::black}, {1.0, Qt::white}})
+{
+}
+
+/**
+ * @brief Build the table by linear interpolation between gradient stops
+ *
+ * @param stops Stops ordered by position within [0, 1]
+ */
+IntensityColorMap::IntensityColorMap(const QGradientStops &stops)
+{
+    for (int i = 0; i < 256; ++i)
+    {
+        qreal position = i / 255.0;
+        QColor color = stops.isEmpty() ? QColor(Qt::black) : stops.first().second;
+        for (int s = 1; s < stops.size(); ++s)
+        {
+            const QGradientStop &from = stops[s - 1];
+            const QGradientStop &to = stops[s];
+            if (position <= to.first)
+            {
+                qreal span = to.first - from.first;
+                qreal t = span > 0.0 ? qBound<qreal>(0.0, (position - from.first) / span, 1.0) : 1.0;
+                color = QColor::fromRgbF(from.second.redF() + (to.second.redF() - from.second.redF()) * t,
+                                         from.second.greenF() + (to.second.greenF() - from.second.greenF()) * t,
+                                         from.second.blueF() + (to.second.blueF() - from.second.blueF()) * t);
+                break;
+            }
+            color = to.second;
+        }
+        m_table[i] = color.rgb(); // Opaque, as RGB32 scanlines require
+    }
+}
+
+IntensityColorMap IntensityColorMap::grayscale()
+{
+    return IntensityColorMap();
+}
+
+IntensityColorMap IntensityColorMap::sonar()
+{
+    return IntensityColorMap(QGradientStops{{0.0, QColor(0, 0, 0)},
+                                            {0.35, QColor(96, 40, 0)},
+                                            {0.7, QColor(255, 160, 0)},
+                                            {1.0, QColor(255, 255, 255)}});
+}
+
+IntensityColorMap IntensityColorMap::jet()
+{
+    return IntensityColorMap(QGradientStops{{0.0, QColor(0, 0, 128)},
+                                            {0.125, QColor(0, 0, 255)},
+                                            {0.375, QColor(0, 255, 255)},
+                                            {0.625, QColor(255, 255, 0)},
+                                            {0.875, QColor(255, 0, 0)},
+                                            {1.0, QColor(128, 0, 0)}});
+}
+
+/**
+ * @brief Convert intensities to opaque pixels through the table
+ *
+ * The SSE2 path converts four intensities to table indices per step. NaN and values
+ * below levelMin take the first entry, values above levelMax the last, exactly as in
+ * the scalar loop, so both paths give the same pixels.
+ *
+ * @param values Pointer to count intensities
+ * @param count Number of intensities
+ * @param levelMin Intensity mapped to the first table entry (and below)
+ * @param levelMax Intensity mapped to the last table entry (and above)
+ * @param out Receives count pixels
+ */
+void IntensityColorMap::mapScanline(const float *values, size_t count, float levelMin, float levelMax, QRgb *out) const
+{
+    const float scale = levelMax > levelMin ? 255.0f / (levelMax - levelMin) : 0.0f;
+    size_t i = 0;
+
+#ifdef INTENSITYCOLORMAP_SSE2
+    const __m128 minimum = _mm_set1_ps(levelMin);
+    const __m128 scaleVector = _mm_set1_ps(scale);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 top = _mm_set1_ps(255.0f);
+    alignas(16) qint32 indices[4];
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 position = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(values + i), minimum), scaleVector);
+        position = _mm_min_ps(_mm_max_ps(position, zero), top); // max() returns zero for NaN
+        _mm_store_si128(reinterpret_cast<__m128i *>(indices), _mm_cvttps_epi32(position));
+
+        out[i] = m_table[indices[0]];
+        out[i + 1] = m_table[indices[1]];
+        out[i + 2] = m_table[indices[2]];
+        out[i + 3] = m_table[indices[3]];
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        float position = (values[i] - levelMin) * scale;
+        int index = position > 0.0f ? (position < 255.0f ? static_cast<int>(position) : 255) : 0;
+        out[i] = m_table[index];
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef INTENSITYCOLORMAP_H
+#define INTENSITYCOLORMAP_H
+
+#include <QGradientStops>
+#include <QRgb>
+#include <QtGlobal>
+#include <array>
+
+/**
+ * @brief 256-entry colour lookup table for intensity (spectrogram) series
+ *
+ * The table is computed once from gradient stops, so converting a row of intensities
+ * is a scale, a clamp and a table load per bin. mapScanline() writes straight into
+ * QImage::Format_RGB32 scanlines and uses SSE2 for the index conversion where the
+ * target has it.
+ */
+class IntensityColorMap
+{
+public:
+    IntensityColorMap(); // Grayscale
+    explicit IntensityColorMap(const QGradientStops &stops);
+
+    static IntensityColorMap grayscale();
+    static IntensityColorMap sonar(); // Black through amber to white
+    static IntensityColorMap jet();   // Blue through green and yellow to red
+
+    QRgb color(int index) const { return m_table[index]; }
+
+    /**
+     * @brief Convert intensities to opaque pixels
+     * @param values Pointer to count intensities
+     * @param count Number of intensities
+     * @param levelMin Intensity mapped to the first table entry (and below)
+     * @param levelMax Intensity mapped to the last table entry (and above)
+     * @param out Receives count pixels
+     */
+    void mapScanline(const float *values, size_t count, float levelMin, float levelMax, QRgb *out) const;
+
+private:
+    std::array<QRgb, 256> m_table;
+};
+
+#endif // INTENSITYCOLORMAP_H
@@ -1,4 +1,5 @@
 #include "ltwgraph.h"
+#include "uilogging.h"
 #include <QDebug>
 
 /**
@@ -39,75 +40,49 @@ LTWGraph::~LTWGraph()
 }
 
 /**
- * @brief Override draw method to create scatterplots by default
+ * @brief Draw the ADOPTED series as a line; the other series are drawn as binned markers
+ * by drawDecorations
  *
+ * @param seriesId The interned ID of the series
+ * @return SeriesStyle Style used by the base draw paths
  */
-void LTWGraph::draw()
+WaterfallGraph::SeriesStyle LTWGraph::seriesStyle(int seriesId) const
 {
-    qDebug() << "LTW: draw() called";
-    
-    if (!graphicsScene) {
-        qDebug() << "LTW: draw() early return - no graphicsScene";
-        return;
-    }
-    
-    // Prevent concurrent drawing to avoid marker duplication
-    if (isDrawing) {
-        qDebug() << "LTWGraph: draw() already in progress, skipping";
-        return;
-    }
-    
-    isDrawing = true;
-
-    graphicsScene->clear();
-    graphicsScene->update(); // Force immediate update to ensure clearing is visible
-    setupDrawingArea();
-
-    if (gridEnabled)
+    SeriesStyle style = adoptedLineSeriesStyle(seriesId);
+    if (seriesId != adoptedSeriesId())
     {
-        drawGrid();
+        style.drawMarkers = false;
     }
+    return style;
+}
 
-    if (dataSource && !dataSource->isEmpty())
+/**
+ * @brief Draw the binned markers of the non-ADOPTED series and the BTW symbols over the series
+ *
+ */
+void LTWGraph::drawDecorations()
+{
+    if (dataSource && !dataSource->isEmpty() && dataRangesValid)
     {
-        qDebug() << "LTW: draw() - dataSource available, updating ranges and drawing series";
-        updateDataRanges();
-        
         // Draw custom markers for each series with their respective colors
-        std::vector<QString> seriesLabels = dataSource->getDataSeriesLabels();
-        qDebug() << "LTW: draw() - found" << seriesLabels.size() << "series labels";
-        
-        for (const QString &seriesLabel : seriesLabels)
+        const int adoptedId = adoptedSeriesId();
+        for (int seriesId : dataSource->getDataSeriesIds())
         {
-            qDebug() << "LTW: draw() - processing series:" << seriesLabel << "visible:" << isSeriesVisible(seriesLabel);
-            if (isSeriesVisible(seriesLabel))
+            if (seriesId != adoptedId && isSeriesVisible(seriesId))
             {
-                QColor seriesColor = getSeriesColor(seriesLabel);
-                
-                if (seriesLabel == "ADOPTED")
-                {
-                    // Draw curve for ADOPTED series without points
-                    qDebug() << "LTW: draw() - drawing ADOPTED series as line";
-                    drawDataLine(seriesLabel, false);
-                }
-                else
-                {
-                    // Draw custom markers for other series with adaptive sampling
-                    qDebug() << "LTW: draw() - drawing custom markers for series:" << seriesLabel;
-                    drawCustomMarkers(seriesLabel, seriesColor);
-                }
+                // Draw custom markers for other series with adaptive sampling
+                UI_DEBUG(lcWaterfallDraw) << "LTW: drawDecorations() - drawing custom markers for series:" << SeriesRegistry::label(seriesId);
+                drawCustomMarkers(seriesId, getSeriesColor(seriesId));
             }
         }
     }
     else
     {
-        qDebug() << "LTW: draw() - no dataSource or dataSource is empty";
+        UI_DEBUG(lcWaterfallDraw) << "LTW: drawDecorations() - no dataSource, dataSource is empty or ranges are invalid";
     }
     
     // Draw BTW symbols (magenta circles) if any exist in data source
     drawBTWSymbols();
-    
-    isDrawing = false;
 }
 
 /**
@@ -150,76 +125,61 @@ void LTWGraph::drawLTWScatterplot()
  * @brief Draw custom markers for LTW graph with adaptive time-based binning
  * Uses 1/5 of the current time interval as the bin duration for sampling
  *
- * @param seriesLabel The series label to draw markers for
+ * @param seriesId The interned ID of the series to draw markers for
  * @param markerColor The color for the markers
  */
-void LTWGraph::drawCustomMarkers(const QString &seriesLabel, const QColor &markerColor)
+void LTWGraph::drawCustomMarkers(int seriesId, const QColor &markerColor)
 {
     if (!dataSource || !graphicsScene) {
-        qDebug() << "LTW: drawCustomMarkers early return - no dataSource or graphicsScene";
+        UI_DEBUG(lcWaterfallDraw) << "LTW: drawCustomMarkers early return - no dataSource or graphicsScene";
         return;
     }
 
     // Get total data size for comparison
-    size_t totalDataSize = dataSource->getDataSeriesSize(seriesLabel);
-    qDebug() << "LTW: drawCustomMarkers called for series" << seriesLabel << "with total data size:" << totalDataSize;
+    size_t totalDataSize = dataSource->getDataSeriesSize(seriesId);
+    UI_DEBUG(lcWaterfallDraw) << "LTW: drawCustomMarkers called for series" << SeriesRegistry::label(seriesId) << "with total data size:" << totalDataSize;
 
     if (totalDataSize == 0) {
-        qDebug() << "LTW: No data available for series" << seriesLabel;
+        UI_DEBUG(lcWaterfallDraw) << "LTW: No data available for series" << SeriesRegistry::label(seriesId);
         return;
     }
 
     // Use the static binning method to sample data based on time intervals
-    qint64 samplingIntervalMs = 300000; // 3 seconds
+    qint64 samplingIntervalMs = 300000; // 5 minutes
 
-    // Convert to QTime for the binning method
-    QTime binDuration = QTime(0, 0, 0).addMSecs(samplingIntervalMs);
-    
-    // Get raw data and use static binning method
-    const std::vector<qreal>& yData = dataSource->getYDataSeries(seriesLabel);
-    const std::vector<QDateTime>& timestamps = dataSource->getTimestampsSeries(seriesLabel);
-    std::vector<std::pair<qreal, QDateTime>> binnedData = WaterfallData::binDataByTime(yData, timestamps, binDuration);
-    
-    // Filter binned data to only include points within the visible time range
-    std::vector<std::pair<qreal, QDateTime>> visibleBinnedData;
-    for (const auto& point : binnedData) {
-        if (point.second >= timeMin && point.second <= timeMax) {
-            visibleBinnedData.push_back(point);
-        }
-    }
-    
-    qDebug() << "LTW: Time range filtering - Total binned:" << binnedData.size() 
-             << "- Visible binned:" << visibleBinnedData.size()
-             << "- Time range:" << timeMin.toString() << "to" << timeMax.toString();
+    // Bin only the visible slice, with bins aligned to the epoch (floor(t / samplingIntervalMs)) so
+    // bin edges stay fixed while scrolling and when retention evicts the oldest samples
+    WaterfallSeriesView visibleSeries = getVisibleSeriesView(seriesId);
+    std::vector<std::pair<qreal, qint64>> visibleBinnedData =
+        WaterfallData::binDataByTimeMs(visibleSeries, samplingIntervalMs, 0);
 
-    qDebug() << "LTW: Binning completed for series" << seriesLabel 
+    UI_DEBUG(lcWaterfallDraw) << "LTW: Binning completed for series" << SeriesRegistry::label(seriesId) 
              << "- Total data:" << totalDataSize 
-             << "- Binned data:" << binnedData.size()
+             << "- Visible data:" << visibleSeries.size()
              << "- Visible binned data:" << visibleBinnedData.size()
-             << "- Bin duration:" << samplingIntervalMs << "ms";
+             << "- Bin duration:" << samplingIntervalMs << "ms"
+             << "- Time range:" << timeMin.toString() << "to" << timeMax.toString();
 
     // Check if time range is valid and reasonable before drawing markers
     // Use the robust helper function that checks validity, range size, and reasonableness
     if (!isTimeRangeValidForDrawing()) {
-        qDebug() << "LTW: Time range is invalid or unreasonable - skipping marker drawing until time range is properly set";
-        qDebug() << "LTW: timeMin:" << timeMin.toString() << "valid:" << timeMin.isValid();
-        qDebug() << "LTW: timeMax:" << timeMax.toString() << "valid:" << timeMax.isValid();
-        qDebug() << "LTW: customTimeRangeEnabled:" << customTimeRangeEnabled;
+        UI_DEBUG(lcWaterfallDraw) << "LTW: Time range is invalid or unreasonable - skipping marker drawing until time range is properly set";
+        UI_DEBUG(lcWaterfallDraw) << "LTW: timeMin:" << timeMin.toString() << "valid:" << timeMin.isValid();
+        UI_DEBUG(lcWaterfallDraw) << "LTW: timeMax:" << timeMax.toString() << "valid:" << timeMax.isValid();
+        UI_DEBUG(lcWaterfallDraw) << "LTW: customTimeRangeEnabled:" << customTimeRangeEnabled;
         return;
     }
 
     if (visibleBinnedData.empty()) {
-        qDebug() << "LTW: No visible binned data available for series" << seriesLabel;
-        qDebug() << "LTW: Time range is valid but no data points within range - skipping marker drawing";
+        UI_DEBUG(lcWaterfallDraw) << "LTW: No visible binned data available for series" << SeriesRegistry::label(seriesId);
+        UI_DEBUG(lcWaterfallDraw) << "LTW: Time range is valid but no data points within range - skipping marker drawing";
         return;
     }
 
     // Draw markers for each visible binned point
     int markersDrawn = 0;
     for (const auto& point : visibleBinnedData) {
-        qreal yValue = point.first;
-        QDateTime timestamp = point.second;
-        QPointF screenPos = mapDataToScreen(yValue, timestamp);
+        QPointF screenPos = mapDataToScreen(point.first, point.second);
         
         // Check if point is within visible area
         if (drawingArea.contains(screenPos)) {
@@ -238,7 +198,7 @@ void LTWGraph::drawCustomMarkers(const QString &seriesLabel, const QColor &marke
             square->setPen(QPen(Qt::white, 1.0));
             square->setBrush(QBrush(Qt::transparent));
             square->setZValue(500); // Lower z-value than triangle
-            graphicsScene->addItem(square);
+            addDecorationItem(square);
             
             // Draw cyan triangle
             QPolygonF triangle;
@@ -250,12 +210,12 @@ void LTWGraph::drawCustomMarkers(const QString &seriesLabel, const QColor &marke
             triangleItem->setPen(QPen(Qt::white, 1.0));
             triangleItem->setBrush(QBrush(Qt::white));
             triangleItem->setZValue(600); // Higher z-value than square
-            graphicsScene->addItem(triangleItem);
+            addDecorationItem(triangleItem);
             
             markersDrawn++;
         }
     }
     
-    qDebug() << "LTW: Successfully drew" << markersDrawn << "markers for series" << seriesLabel;
+    UI_DEBUG(lcWaterfallDraw) << "LTW: Successfully drew" << markersDrawn << "markers for series" << SeriesRegistry::label(seriesId);
 }
 
@@ -18,8 +18,9 @@ public:
     ~LTWGraph();
 
 protected:
-    // Override the draw method to create scatterplots by default
-    void draw() override;
+    // Draw the ADOPTED series as a line and the other series as binned markers
+    SeriesStyle seriesStyle(int seriesId) const override;
+    void drawDecorations() override;
 
     // Override mouse event handlers if needed
     void onMouseClick(const QPointF &scenePos) override;
@@ -33,7 +34,7 @@ protected:
 private:
     // LTW-specific properties and methods can be added here
     void drawLTWScatterplot();
-    void drawCustomMarkers(const QString &seriesLabel, const QColor &markerColor);
+    void drawCustomMarkers(int seriesId, const QColor &markerColor);
 };
 
 #endif // LTWGRAPH_H
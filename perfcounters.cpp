@@ -0,0 +1,197 @@
+#include "perfcounters.h"
+#include <QDebug>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QTextStream>
+#include <algorithm>
+
+namespace
+{
+// Serializes stage registration only; recording never takes it
+QMutex &registrationMutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+} // namespace
+
+quint64 PerfStageSnapshot::percentile(double fraction) const
+{
+    if (count == 0 || buckets.empty())
+    {
+        return 0;
+    }
+
+    quint64 rank = static_cast<quint64>(fraction * (count - 1)) + 1;
+    quint64 seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i)
+    {
+        seen += buckets[i];
+        if (seen >= rank)
+        {
+            quint64 upper = (i == 0) ? 0 : (quint64(1) << i) - 1;
+            return std::min(upper, max);
+        }
+    }
+    return max;
+}
+
+PerfStage::PerfStage()
+    : m_isTimer(true), m_count(0), m_total(0), m_max(0)
+{
+    for (int i = 0; i < kBucketCount; ++i)
+    {
+        m_buckets[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+PerfStageSnapshot PerfStage::snapshot() const
+{
+    PerfStageSnapshot result;
+    result.name = m_name;
+    result.isTimer = m_isTimer;
+    result.count = m_count.load(std::memory_order_relaxed);
+    result.total = m_total.load(std::memory_order_relaxed);
+    result.max = m_max.load(std::memory_order_relaxed);
+    result.buckets.resize(kBucketCount);
+    for (int i = 0; i < kBucketCount; ++i)
+    {
+        result.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+void PerfStage::reset()
+{
+    m_count.store(0, std::memory_order_relaxed);
+    m_total.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+    for (int i = 0; i < kBucketCount; ++i)
+    {
+        m_buckets[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+PerfRegistry::PerfRegistry()
+    : m_stageCount(0)
+{
+    m_overflow.m_name = "(overflow)";
+}
+
+PerfRegistry &PerfRegistry::instance()
+{
+    static PerfRegistry registry;
+    return registry;
+}
+
+/**
+ * @brief Find or register the stage with the given name.
+ *
+ * Call sites cache the result, so this runs once per site.
+ *
+ * @param name Stage name, e.g. "WaterfallGraph::draw"
+ * @param isTimer true if the stage records durations in nanoseconds
+ * @return PerfStage* Stage to record into (never null)
+ */
+PerfStage *PerfRegistry::stage(const char *name, bool isTimer)
+{
+    QMutexLocker locker(&registrationMutex());
+
+    QString stageName = QString::fromLatin1(name);
+    int count = m_stageCount.load(std::memory_order_relaxed);
+    for (int i = 0; i < count; ++i)
+    {
+        if (m_stages[i].m_name == stageName)
+        {
+            return &m_stages[i];
+        }
+    }
+
+    if (count >= kMaxStages)
+    {
+        qDebug() << "PerfRegistry: Too many stages, recording" << stageName << "as overflow";
+        return &m_overflow;
+    }
+
+    m_stages[count].m_name = stageName;
+    m_stages[count].m_isTimer = isTimer;
+    m_stageCount.store(count + 1, std::memory_order_release);
+    return &m_stages[count];
+}
+
+/**
+ * @brief Take a snapshot of every registered stage.
+ *
+ * Counts are read without stopping writers, so a snapshot taken while stages are being
+ * recorded may be off by the samples in flight.
+ */
+std::vector<PerfStageSnapshot> PerfRegistry::snapshot() const
+{
+    std::vector<PerfStageSnapshot> result;
+    int count = m_stageCount.load(std::memory_order_acquire);
+    result.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        result.push_back(m_stages[i].snapshot());
+    }
+    if (m_overflow.m_count.load(std::memory_order_relaxed) > 0)
+    {
+        result.push_back(m_overflow.snapshot());
+    }
+    return result;
+}
+
+bool PerfRegistry::snapshot(const QString &name, PerfStageSnapshot &result) const
+{
+    int count = m_stageCount.load(std::memory_order_acquire);
+    for (int i = 0; i < count; ++i)
+    {
+        if (m_stages[i].m_name == name)
+        {
+            result = m_stages[i].snapshot();
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Write a table of every stage (count, mean, percentiles, max) to a text file.
+ *
+ * Timer stages are reported in microseconds, counter stages in their own units.
+ *
+ * @param filePath Output file, overwritten
+ * @return true if the file was written
+ */
+bool PerfRegistry::dumpToFile(const QString &filePath) const
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    {
+        qDebug() << "PerfRegistry: Cannot write" << filePath << ":" << file.errorString();
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << "stage\tunit\tcount\tmean\tp50\tp90\tp99\tmax\ttotal\n";
+    for (const PerfStageSnapshot &stage : snapshot())
+    {
+        double scale = stage.isTimer ? 1e-3 : 1.0; // ns to us for timers
+        out << stage.name << '\t' << (stage.isTimer ? "us" : "value") << '\t' << stage.count << '\t'
+            << stage.mean() * scale << '\t' << stage.percentile(0.5) * scale << '\t'
+            << stage.percentile(0.9) * scale << '\t' << stage.percentile(0.99) * scale << '\t'
+            << stage.max * scale << '\t' << stage.total * scale << '\n';
+    }
+    return true;
+}
+
+void PerfRegistry::reset()
+{
+    int count = m_stageCount.load(std::memory_order_acquire);
+    for (int i = 0; i < count; ++i)
+    {
+        m_stages[i].reset();
+    }
+    m_overflow.reset();
+}
@@ -0,0 +1,148 @@
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+// Low-overhead hot-path instrumentation.
+//
+//   PERF_SCOPE("WaterfallGraph::draw");       // times the enclosing scope
+//   PERF_COUNT("ScatterPlotItem::points", n); // records a value
+//
+// Each call site resolves its stage once (a function-local static); after that recording is
+// a handful of relaxed atomic increments into a log2 histogram, safe from any thread.
+// Without ENABLE_PERF_COUNTERS defined both macros compile to nothing. The registry itself
+// is always built so code that queries or dumps it does not need to be conditional.
+
+// Distribution of one stage: durations in nanoseconds for timers, raw values for counters
+struct PerfStageSnapshot
+{
+    QString name;
+    bool isTimer = true;
+    quint64 count = 0;
+    quint64 total = 0;
+    quint64 max = 0;
+    std::vector<quint64> buckets; // buckets[i] counts values in [2^(i-1), 2^i), bucket 0 holds 0
+
+    double mean() const { return count ? static_cast<double>(total) / count : 0.0; }
+    quint64 percentile(double fraction) const; // Upper bound of the bucket holding the percentile
+};
+
+class PerfStage
+{
+public:
+    static const int kBucketCount = 64;
+
+    PerfStage();
+
+    void record(quint64 value)
+    {
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_total.fetch_add(value, std::memory_order_relaxed);
+        m_buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+
+        quint64 previous = m_max.load(std::memory_order_relaxed);
+        while (value > previous && !m_max.compare_exchange_weak(previous, value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    PerfStageSnapshot snapshot() const;
+    void reset();
+
+private:
+    friend class PerfRegistry;
+
+    static int bucketIndex(quint64 value)
+    {
+        int index = 0;
+        while (value != 0 && index < kBucketCount - 1)
+        {
+            value >>= 1;
+            ++index;
+        }
+        return index;
+    }
+
+    QString m_name;
+    bool m_isTimer;
+    std::atomic<quint64> m_count;
+    std::atomic<quint64> m_total;
+    std::atomic<quint64> m_max;
+    std::atomic<quint64> m_buckets[kBucketCount];
+};
+
+// Process-wide set of stages; stages are never removed, so pointers stay valid
+class PerfRegistry
+{
+public:
+    static PerfRegistry &instance();
+
+    PerfStage *stage(const char *name, bool isTimer);
+
+    std::vector<PerfStageSnapshot> snapshot() const;
+    bool snapshot(const QString &name, PerfStageSnapshot &result) const;
+    bool dumpToFile(const QString &filePath) const;
+    void reset();
+
+private:
+    static const int kMaxStages = 256;
+
+    PerfRegistry();
+    Q_DISABLE_COPY(PerfRegistry)
+
+    PerfStage m_stages[kMaxStages];
+    std::atomic<int> m_stageCount; // Published after the stage is initialized
+    PerfStage m_overflow;          // Shared by stages registered past kMaxStages
+};
+
+// Records the lifetime of a scope into a timer stage
+class PerfScopedTimer
+{
+public:
+    explicit PerfScopedTimer(PerfStage *stage)
+        : m_stage(stage), m_start(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~PerfScopedTimer()
+    {
+        auto elapsed = std::chrono::steady_clock::now() - m_start;
+        m_stage->record(static_cast<quint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+private:
+    Q_DISABLE_COPY(PerfScopedTimer)
+
+    PerfStage *m_stage;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+#define PERF_CONCAT_INNER(a, b) a##b
+#define PERF_CONCAT(a, b) PERF_CONCAT_INNER(a, b)
+
+#ifdef ENABLE_PERF_COUNTERS
+#define PERF_SCOPE(name)                                                                                     \
+    static PerfStage *const PERF_CONCAT(perfStage_, __LINE__) = PerfRegistry::instance().stage(name, true); \
+    PerfScopedTimer PERF_CONCAT(perfScope_, __LINE__)(PERF_CONCAT(perfStage_, __LINE__))
+#define PERF_COUNT(name, value)                                                                            \
+    do                                                                                                     \
+    {                                                                                                      \
+        static PerfStage *const perfCounterStage = PerfRegistry::instance().stage(name, false);           \
+        perfCounterStage->record(static_cast<quint64>(value));                                            \
+    } while (0)
+#else
+#define PERF_SCOPE(name) \
+    do                   \
+    {                    \
+    } while (0)
+#define PERF_COUNT(name, value) \
+    do                          \
+    {                           \
+    } while (0)
+#endif
+
+#endif // PERFCOUNTERS_H
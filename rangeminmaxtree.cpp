@@ -0,0 +1,118 @@
+#include "rangeminmaxtree.h"
+#include <algorithm>
+#include <limits>
+
+RangeMinMaxTree::RangeMinMaxTree()
+    : m_capacity(0), m_count(0)
+{
+}
+
+/**
+ * @brief Rebuild the tree over a value column, leaving room to append as many values again.
+ *
+ * @param values Pointer to the first value
+ * @param count Number of values
+ */
+void RangeMinMaxTree::rebuild(const qreal *values, size_t count)
+{
+    size_t capacity = 16;
+    while (capacity < count * 2)
+    {
+        capacity *= 2;
+    }
+
+    m_capacity = capacity;
+    m_count = count;
+    m_mins.assign(capacity * 2, std::numeric_limits<qreal>::max());
+    m_maxs.assign(capacity * 2, std::numeric_limits<qreal>::lowest());
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        m_mins[capacity + i] = values[i];
+        m_maxs[capacity + i] = values[i];
+    }
+    for (size_t node = capacity - 1; node > 0; --node)
+    {
+        m_mins[node] = std::min(m_mins[node * 2], m_mins[node * 2 + 1]);
+        m_maxs[node] = std::max(m_maxs[node * 2], m_maxs[node * 2 + 1]);
+    }
+}
+
+/**
+ * @brief Append a value after the last leaf.
+ *
+ * @param value Value to append
+ * @return false if the tree is full and must be rebuilt
+ */
+bool RangeMinMaxTree::append(qreal value)
+{
+    if (m_count >= m_capacity)
+    {
+        return false;
+    }
+    setLeaf(m_count, value);
+    ++m_count;
+    return true;
+}
+
+/**
+ * @brief Release all storage.
+ *
+ */
+void RangeMinMaxTree::clear()
+{
+    m_mins.clear();
+    m_maxs.clear();
+    m_capacity = 0;
+    m_count = 0;
+}
+
+/**
+ * @brief Query min and max over [first, last).
+ *
+ * @param first First index (inclusive)
+ * @param last Last index (exclusive)
+ * @return std::pair<qreal, qreal> Min and max, or (0, 0) for an empty range
+ */
+std::pair<qreal, qreal> RangeMinMaxTree::query(size_t first, size_t last) const
+{
+    last = std::min(last, m_count);
+    if (first >= last)
+    {
+        return std::make_pair(0.0, 0.0);
+    }
+
+    qreal minValue = std::numeric_limits<qreal>::max();
+    qreal maxValue = std::numeric_limits<qreal>::lowest();
+
+    // Bottom-up walk over the half-open leaf range
+    for (size_t lo = first + m_capacity, hi = last + m_capacity; lo < hi; lo /= 2, hi /= 2)
+    {
+        if (lo & 1)
+        {
+            minValue = std::min(minValue, m_mins[lo]);
+            maxValue = std::max(maxValue, m_maxs[lo]);
+            ++lo;
+        }
+        if (hi & 1)
+        {
+            --hi;
+            minValue = std::min(minValue, m_mins[hi]);
+            maxValue = std::max(maxValue, m_maxs[hi]);
+        }
+    }
+
+    return std::make_pair(minValue, maxValue);
+}
+
+void RangeMinMaxTree::setLeaf(size_t index, qreal value)
+{
+    size_t node = m_capacity + index;
+    m_mins[node] = value;
+    m_maxs[node] = value;
+    for (node /= 2; node > 0; node /= 2)
+    {
+        m_mins[node] = std::min(m_mins[node * 2], m_mins[node * 2 + 1]);
+        m_maxs[node] = std::max(m_maxs[node * 2], m_maxs[node * 2 + 1]);
+    }
+}
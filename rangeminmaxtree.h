@@ -0,0 +1,35 @@
+#ifndef RANGEMINMAXTREE_H
+#define RANGEMINMAXTREE_H
+
+#include <QtGlobal>
+#include <utility>
+#include <vector>
+
+// Segment tree answering min/max over an index range of a value column in O(log n).
+// Appends are O(log n) while there is spare capacity; growing past the capacity
+// requires a rebuild, which the owner triggers lazily on the next query.
+class RangeMinMaxTree
+{
+public:
+    RangeMinMaxTree();
+
+    void rebuild(const qreal *values, size_t count);
+    bool append(qreal value);
+    void clear();
+
+    // Min/max over the half-open index range [first, last); (0, 0) if the range is empty
+    std::pair<qreal, qreal> query(size_t first, size_t last) const;
+
+    size_t size() const { return m_count; }
+    size_t capacity() const { return m_capacity; }
+
+private:
+    void setLeaf(size_t index, qreal value);
+
+    std::vector<qreal> m_mins;
+    std::vector<qreal> m_maxs;
+    size_t m_capacity; // Leaf count, always a power of two
+    size_t m_count;    // Leaves in use
+};
+
+#endif // RANGEMINMAXTREE_H
@@ -0,0 +1,226 @@
+#include "replayengine.h"
+#include <QDateTime>
+#include <QDebug>
+#include <algorithm>
+
+ReplayEngine::ReplayEngine(QObject *parent, GraphLayout *graphLayout)
+    : QObject(parent), m_graphLayout(graphLayout), m_frameTimer(nullptr), m_speed(1.0), m_fastStepMs(1000),
+      m_seekHistoryMs(15 * 60 * 1000), m_startMs(0), m_endMs(0), m_positionMs(0), m_pendingMs(0.0),
+      m_samplesDelivered(0)
+{
+    m_frameTimer = new QTimer(this);
+    m_frameTimer->setInterval(16);
+    connect(m_frameTimer, &QTimer::timeout, this, &ReplayEngine::onFrameTick);
+}
+
+ReplayEngine::~ReplayEngine()
+{
+    close();
+}
+
+bool ReplayEngine::open(const QString &filePath)
+{
+    close();
+
+    if (!m_graphLayout)
+    {
+        qDebug() << "ReplayEngine: No graph layout to replay into";
+        return false;
+    }
+
+    if (!m_reader.open(filePath) || !m_reader.getTimeRangeMs(m_startMs, m_endMs))
+    {
+        qDebug() << "ReplayEngine: Nothing to replay in" << filePath;
+        m_reader.close();
+        return false;
+    }
+
+    for (const GraphType &graphType : m_reader.getGraphTypes())
+    {
+        if (!m_graphLayout->hasDataSource(graphType))
+        {
+            qDebug() << "ReplayEngine: Skipping" << graphTypeToString(graphType) << "- not in this layout";
+            continue;
+        }
+        for (const QString &seriesLabel : m_reader.getSeriesLabels(graphType))
+        {
+            m_streams.push_back(std::make_pair(graphType, seriesLabel));
+        }
+    }
+
+    m_samplesDelivered = 0;
+    seek(m_startMs);
+
+    qDebug() << "ReplayEngine: Opened" << filePath << "-" << m_streams.size() << "series from"
+             << QDateTime::fromMSecsSinceEpoch(m_startMs).toString() << "to" << QDateTime::fromMSecsSinceEpoch(m_endMs).toString();
+    return true;
+}
+
+void ReplayEngine::close()
+{
+    pause();
+    m_streams.clear();
+    m_reader.close();
+    m_startMs = 0;
+    m_endMs = 0;
+    m_positionMs = 0;
+
+    // Hand the layout back to the wall clock
+    if (m_graphLayout)
+    {
+        m_graphLayout->clearReplayClock();
+    }
+}
+
+void ReplayEngine::start()
+{
+    if (!m_reader.isOpen() || m_frameTimer->isActive())
+    {
+        return;
+    }
+
+    if (m_positionMs >= m_endMs)
+    {
+        seek(m_startMs);
+    }
+
+    m_clock.start();
+    m_pendingMs = 0.0;
+    m_frameTimer->start();
+    qDebug() << "ReplayEngine: Started at" << (m_speed > 0.0 ? QString::number(m_speed) + "x" : QString("full speed"));
+}
+
+void ReplayEngine::pause()
+{
+    if (m_frameTimer && m_frameTimer->isActive())
+    {
+        m_frameTimer->stop();
+        qDebug() << "ReplayEngine: Paused at" << QDateTime::fromMSecsSinceEpoch(m_positionMs).toString()
+                 << "-" << m_samplesDelivered << "samples delivered";
+    }
+}
+
+bool ReplayEngine::isRunning() const
+{
+    return m_frameTimer && m_frameTimer->isActive();
+}
+
+void ReplayEngine::setSpeed(qreal speed)
+{
+    m_speed = std::max<qreal>(0.0, speed);
+
+    // As fast as possible: tick whenever the event loop is idle
+    m_frameTimer->setInterval(m_speed > 0.0 ? 16 : 0);
+    m_clock.restart();
+    m_pendingMs = 0.0;
+}
+
+qreal ReplayEngine::getSpeed() const
+{
+    return m_speed;
+}
+
+void ReplayEngine::setFastStepMs(qint64 stepMs)
+{
+    m_fastStepMs = std::max<qint64>(1, stepMs);
+}
+
+void ReplayEngine::setSeekHistoryMs(qint64 historyMs)
+{
+    m_seekHistoryMs = std::max<qint64>(0, historyMs);
+}
+
+void ReplayEngine::seek(qint64 timeMs)
+{
+    if (!m_reader.isOpen())
+    {
+        return;
+    }
+
+    timeMs = std::max(m_startMs, std::min(timeMs, m_endMs));
+    for (const auto &stream : m_streams)
+    {
+        m_graphLayout->clearDataSource(stream.first, stream.second);
+    }
+
+    deliver(timeMs - m_seekHistoryMs - 1, timeMs);
+    m_positionMs = timeMs;
+    m_pendingMs = 0.0;
+    m_clock.restart();
+
+    m_graphLayout->setReplayClock(m_positionMs);
+    emit positionChanged(m_positionMs);
+}
+
+qint64 ReplayEngine::getPositionMs() const
+{
+    return m_positionMs;
+}
+
+qint64 ReplayEngine::getStartMs() const
+{
+    return m_startMs;
+}
+
+qint64 ReplayEngine::getEndMs() const
+{
+    return m_endMs;
+}
+
+quint64 ReplayEngine::getSamplesDelivered() const
+{
+    return m_samplesDelivered;
+}
+
+void ReplayEngine::onFrameTick()
+{
+    qint64 targetMs = m_positionMs;
+    if (m_speed > 0.0)
+    {
+        // Carry the sub-millisecond remainder so slow speeds do not drift
+        m_pendingMs += m_clock.restart() * m_speed;
+        qint64 advanceMs = static_cast<qint64>(m_pendingMs);
+        m_pendingMs -= advanceMs;
+        targetMs += advanceMs;
+    }
+    else
+    {
+        targetMs += m_fastStepMs;
+    }
+    targetMs = std::min(targetMs, m_endMs);
+
+    if (targetMs > m_positionMs)
+    {
+        deliver(m_positionMs, targetMs);
+        m_positionMs = targetMs;
+
+        // Drive the layout clock from the recording so follow mode tracks the replay
+        m_graphLayout->setReplayClock(m_positionMs);
+        emit positionChanged(m_positionMs);
+    }
+
+    if (m_positionMs >= m_endMs)
+    {
+        pause();
+        qDebug() << "ReplayEngine: Reached end of recording -" << m_samplesDelivered << "samples delivered";
+        emit finished();
+    }
+}
+
+size_t ReplayEngine::deliver(qint64 fromMs, qint64 toMs)
+{
+    size_t delivered = 0;
+    for (const auto &stream : m_streams)
+    {
+        // (fromMs, toMs] so consecutive frames never deliver a sample twice
+        std::vector<WaterfallSeriesView> views = m_reader.getSeriesViews(stream.first, stream.second, fromMs + 1, toMs);
+        for (const WaterfallSeriesView &view : views)
+        {
+            m_graphLayout->addDataPointsToDataSource(stream.first, stream.second, view.yData, view.timestampsMs, view.count);
+            delivered += view.count;
+        }
+    }
+
+    m_samplesDelivered += delivered;
+    return delivered;
+}
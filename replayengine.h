@@ -0,0 +1,149 @@
+#ifndef REPLAYENGINE_H
+#define REPLAYENGINE_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QString>
+#include "graphlayout.h"
+#include "graphtype.h"
+#include "sessionrecording.h"
+#include <utility>
+#include <vector>
+
+/**
+ * @brief The ReplayEngine class plays a session recording back into a GraphLayout
+ *
+ * Once per frame the replay clock advances by the elapsed wall time times the replay speed,
+ * and every recorded sample that falls in the advanced interval is handed to the layout
+ * in one bulk append per series, straight from the memory-mapped recording. A speed of 0
+ * replays as fast as possible: the frame timer fires whenever the event loop is idle and
+ * each frame advances by a fixed step of recording time, which makes the engine a
+ * repeatable load generator for the rendering pipeline.
+ */
+class ReplayEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Construct a new ReplayEngine object
+     *
+     * @param parent Parent QObject
+     * @param graphLayout GraphLayout fed with the replayed samples
+     */
+    explicit ReplayEngine(QObject *parent, GraphLayout *graphLayout);
+
+    /**
+     * @brief Destroy the ReplayEngine object
+     */
+    ~ReplayEngine();
+
+    /**
+     * @brief Open a recording and seek to its start
+     *
+     * @param filePath Path of the session recording
+     * @return true if the recording was opened
+     */
+    bool open(const QString &filePath);
+
+    /**
+     * @brief Stop playback, close the recording and return the layout to the wall clock
+     */
+    void close();
+
+    /**
+     * @brief Start or resume playback
+     */
+    void start();
+
+    /**
+     * @brief Pause playback
+     */
+    void pause();
+
+    /**
+     * @brief Check if playback is running
+     *
+     * @return true if playback is running
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief Set the replay speed
+     *
+     * @param speed Multiple of real time (1, 10, 100...), or 0 for as fast as possible
+     */
+    void setSpeed(qreal speed);
+    qreal getSpeed() const;
+
+    /**
+     * @brief Set how much recording time each frame covers when replaying as fast as possible
+     *
+     * @param stepMs Recording time per frame in milliseconds
+     */
+    void setFastStepMs(qint64 stepMs);
+
+    /**
+     * @brief Set how much history is loaded before the seek position
+     *
+     * @param historyMs History length in milliseconds
+     */
+    void setSeekHistoryMs(qint64 historyMs);
+
+    /**
+     * @brief Jump to a recording time
+     *
+     * The replayed series are cleared and reloaded with the history preceding the new
+     * position; each series is located through the recording's time index in O(log n).
+     *
+     * @param timeMs Recording time in milliseconds since epoch
+     */
+    void seek(qint64 timeMs);
+
+    qint64 getPositionMs() const;
+    qint64 getStartMs() const;
+    qint64 getEndMs() const;
+
+    /**
+     * @brief Get the number of samples handed to the layout since the recording was opened
+     *
+     * @return quint64 Sample count
+     */
+    quint64 getSamplesDelivered() const;
+
+signals:
+    void positionChanged(qint64 timeMs);
+    void finished();
+
+private slots:
+    /**
+     * @brief Frame timer handler - advances the replay clock and delivers the due samples
+     */
+    void onFrameTick();
+
+private:
+    /**
+     * @brief Deliver every sample in the half-open interval (fromMs, toMs] to the layout
+     *
+     * @return size_t Number of samples delivered
+     */
+    size_t deliver(qint64 fromMs, qint64 toMs);
+
+    QPointer<GraphLayout> m_graphLayout;    ///< GraphLayout fed with samples (may be destroyed first)
+    SessionRecordingReader m_reader;        ///< Memory-mapped recording
+    std::vector<std::pair<GraphType, QString>> m_streams; ///< Replayed series
+    QTimer *m_frameTimer;                   ///< Frame timer
+    QElapsedTimer m_clock;                  ///< Wall time since the previous frame
+    qreal m_speed;                          ///< Replay speed, 0 for as fast as possible
+    qint64 m_fastStepMs;                    ///< Recording time per frame at full speed
+    qint64 m_seekHistoryMs;                 ///< History loaded on seek
+    qint64 m_startMs;                       ///< First recorded sample time
+    qint64 m_endMs;                         ///< Last recorded sample time
+    qint64 m_positionMs;                    ///< Time of the last delivered interval end
+    qreal m_pendingMs;                      ///< Fractional replay time carried to the next frame
+    quint64 m_samplesDelivered;             ///< Samples delivered since open
+};
+
+#endif // REPLAYENGINE_H
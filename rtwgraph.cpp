@@ -1,4 +1,5 @@
 #include "rtwgraph.h"
+#include "uilogging.h"
 #include "waterfalldata.h"  // For RTWRMarkerData
 #include <QDebug>
 #include <QGraphicsTextItem>
@@ -35,90 +36,27 @@ RTWGraph::~RTWGraph()
 }
 
 /**
- * @brief Override draw method to create scatterplots by default
+ * @brief Draw the ADOPTED series as a line and the other series as scatterplots
  *
+ * @param seriesId The interned ID of the series
+ * @return SeriesStyle Style used by the base draw paths
  */
-void RTWGraph::draw()
+WaterfallGraph::SeriesStyle RTWGraph::seriesStyle(int seriesId) const
 {
-    qDebug() << "RTW: draw() called";
-    
-    if (!graphicsScene) {
-        qDebug() << "RTW: draw() early return - no graphicsScene";
-        return;
-    }
-    
-    // Prevent concurrent drawing to avoid marker duplication
-    if (isDrawing) {
-        qDebug() << "RTWGraph: draw() already in progress, skipping";
-        return;
-    }
-    
-    isDrawing = true;
-
-    // Clear existing items - ensure complete clearing before drawing
-    graphicsScene->clear();
-    graphicsScene->update(); // Force immediate update to ensure clearing is visible
-    
-    setupDrawingArea();
-
-    if (gridEnabled)
-    {
-        drawGrid();
-    }
-
-    if (dataSource && !dataSource->isEmpty())
-    {
-        qDebug() << "RTW: draw() - dataSource available, updating ranges and drawing series";
-        updateDataRanges();
-        
-        // Debug: Show current Y range
-        qDebug() << "RTW: Current Y range:" << yMin << "to" << yMax;
-        
-        // Debug: Show data source info
-        qDebug() << "RTW: Data source title:" << dataSource->getDataTitle();
-        qDebug() << "RTW: Data source empty?" << dataSource->isEmpty();
-        
-        // RTW should only have 1 series - get the first (and only) series
-        std::vector<QString> seriesLabels = dataSource->getDataSeriesLabels();
-        qDebug() << "RTW: draw() - found" << seriesLabels.size() << "series labels";
-        
-        // Debug: Show all series labels
-        for (const QString& label : seriesLabels) {
-            qDebug() << "RTW: Series label:" << label << "size:" << dataSource->getDataSeriesSize(label);
-        }
-        
-        // Draw all series - ADOPTED as line, others as R markers
-        for (const QString &seriesLabel : seriesLabels)
-        {
-            if (isSeriesVisible(seriesLabel))
-            {
-                if (seriesLabel == "ADOPTED")
-                {
-                    // Draw ADOPTED series as line
-                    qDebug() << "RTW: draw() - drawing ADOPTED series as line";
-                    drawDataLine(seriesLabel, false);
-                }
-                else
-                {
-                    // RTW R markers are now manually placed through data source - no automatic generation
-                    // Draw data as scatterplot for other series
-                    drawScatterplot(seriesLabel, getSeriesColor(seriesLabel), 3.0, Qt::black);
-                }
-            }
-        }
-    }
-    else
-    {
-        qDebug() << "RTW: draw() - no dataSource or dataSource is empty";
-    }
+    return adoptedLineSeriesStyle(seriesId);
+}
 
+/**
+ * @brief Draw the manually placed R markers and the RTW symbols over the series
+ *
+ */
+void RTWGraph::drawDecorations()
+{
     // Draw manually placed RTW R markers from data source
     drawCustomRMarkers();
     
     // Draw RTW symbols
     drawRTWSymbols();
-    
-    isDrawing = false;
 }
 
 /**
@@ -219,7 +157,7 @@ void RTWGraph::onMouseDrag(const QPointF &scenePos)
 void RTWGraph::drawCustomRMarkers()
 {
     if (!dataSource || !graphicsScene) {
-        qDebug() << "RTW: drawCustomRMarkers early return - no dataSource or graphicsScene";
+        UI_DEBUG(lcWaterfallDraw) << "RTW: drawCustomRMarkers early return - no dataSource or graphicsScene";
         return;
     }
 
@@ -227,7 +165,7 @@ void RTWGraph::drawCustomRMarkers()
     std::vector<RTWRMarkerData> rMarkers = dataSource->getRTWRMarkers();
     
     if (rMarkers.empty()) {
-        qDebug() << "RTW: No manually placed R markers in data source";
+        UI_DEBUG(lcWaterfallDraw) << "RTW: No manually placed R markers in data source";
         return;
     }
 
@@ -246,13 +184,13 @@ void RTWGraph::drawCustomRMarkers()
     }
 
     if (visibleMarkers.empty()) {
-        qDebug() << "RTW: No visible R markers within time range";
+        UI_DEBUG(lcWaterfallDraw) << "RTW: No visible R markers within time range";
         return;
     }
 
     // Draw yellow "R" markers for each visible marker
     int markersDrawn = 0;
-    qDebug() << "RTW: Drawing" << visibleMarkers.size() << "manually placed R markers";
+    UI_DEBUG(lcWaterfallDraw) << "RTW: Drawing" << visibleMarkers.size() << "manually placed R markers";
     
     for (const auto& markerData : visibleMarkers) {
         QDateTime timestamp = markerData.timestamp;
@@ -283,12 +221,12 @@ void RTWGraph::drawCustomRMarkers()
             rMarker->setAcceptedMouseButtons(Qt::LeftButton | Qt::RightButton);
             rMarker->setAcceptHoverEvents(true);
             
-            graphicsScene->addItem(rMarker);
+            addDecorationItem(rMarker);
             markersDrawn++;
         }
     }
     
-    qDebug() << "RTW: Successfully drew" << markersDrawn << "manually placed yellow R markers";
+    UI_DEBUG(lcWaterfallDraw) << "RTW: Successfully drew" << markersDrawn << "manually placed yellow R markers";
 }
 
 /**
@@ -382,12 +320,12 @@ void RTWGraph::drawRTWSymbols()
     // Get symbols from dataSource (same pattern as R markers get data from dataSource)
     std::vector<RTWSymbolData> rtwSymbols = dataSource->getRTWSymbols();
     
-    qDebug() << "RTW: drawRTWSymbols() - dataSource pointer:" << dataSource;
-    qDebug() << "RTW: drawRTWSymbols() - symbols count from dataSource:" << rtwSymbols.size();
+    UI_DEBUG(lcWaterfallDraw) << "RTW: drawRTWSymbols() - dataSource pointer:" << dataSource;
+    UI_DEBUG(lcWaterfallDraw) << "RTW: drawRTWSymbols() - symbols count from dataSource:" << rtwSymbols.size();
     
     if (rtwSymbols.empty())
     {
-        qDebug() << "RTW: No symbols in dataSource (dataSource pointer:" << dataSource << ")";
+        UI_DEBUG(lcWaterfallDraw) << "RTW: No symbols in dataSource (dataSource pointer:" << dataSource << ")";
         return;
     }
     
@@ -410,7 +348,7 @@ void RTWGraph::drawRTWSymbols()
     else
     {
         // No valid time range - include all symbols and update time range from symbols
-        qDebug() << "RTW: No valid time range, using all symbols and updating time range";
+        UI_DEBUG(lcWaterfallDraw) << "RTW: No valid time range, using all symbols and updating time range";
         visibleSymbols = rtwSymbols;
         
         // Update time range from symbols if we have any
@@ -427,31 +365,31 @@ void RTWGraph::drawRTWSymbols()
             // Set time range to include all symbols with some padding
             timeMax = symbolTimeMax.addSecs(60); // Add 1 minute padding
             timeMin = symbolTimeMin.addSecs(-60); // Subtract 1 minute padding
-            qDebug() << "RTW: Updated time range from symbols:" << timeMin.toString() << "to" << timeMax.toString();
+            UI_DEBUG(lcWaterfallDraw) << "RTW: Updated time range from symbols:" << timeMin.toString() << "to" << timeMax.toString();
         }
     }
     
-    qDebug() << "RTW: Time range filtering - Total symbols:" << rtwSymbols.size() 
+    UI_DEBUG(lcWaterfallDraw) << "RTW: Time range filtering - Total symbols:" << rtwSymbols.size() 
              << "- Visible symbols:" << visibleSymbols.size()
              << "- Time range:" << timeMin.toString() << "to" << timeMax.toString()
              << "- Time range valid:" << timeRangeValid;
     
     if (visibleSymbols.empty())
     {
-        qDebug() << "RTW: No visible symbols after filtering";
+        UI_DEBUG(lcWaterfallDraw) << "RTW: No visible symbols after filtering";
         return;
     }
     
     // Draw symbols (same approach as R markers)
     int symbolsDrawn = 0;
-    qDebug() << "RTW: Drawing area:" << drawingArea;
+    UI_DEBUG(lcWaterfallDraw) << "RTW: Drawing area:" << drawingArea;
     for (const auto& symbolData : visibleSymbols)
     {
         // Map symbol position to screen coordinates (same as R markers)
         QPointF screenPos = mapDataToScreen(symbolData.range, symbolData.timestamp);
         
         // Debug all symbols to diagnose issues
-        qDebug() << "RTW: Processing symbol" << symbolsDrawn << "- Name:" << symbolData.symbolName 
+        UI_DEBUG(lcWaterfallDraw) << "RTW: Processing symbol" << symbolsDrawn << "- Name:" << symbolData.symbolName 
                  << "Range:" << symbolData.range << "Time:" << symbolData.timestamp.toString() 
                  << "Screen:" << screenPos << "In area:" << drawingArea.contains(screenPos)
                  << "Drawing area:" << drawingArea;
@@ -459,7 +397,7 @@ void RTWGraph::drawRTWSymbols()
         // Check if point is within visible area (same check as R markers use)
         if (!drawingArea.contains(screenPos))
         {
-            qDebug() << "RTW: Symbol" << symbolData.symbolName << "outside drawing area, skipping";
+            UI_DEBUG(lcWaterfallDraw) << "RTW: Symbol" << symbolData.symbolName << "outside drawing area, skipping";
             continue;
         }
         
@@ -472,7 +410,7 @@ void RTWGraph::drawRTWSymbols()
         // Validate pixmap before using it
         if (symbolPixmap.isNull() || symbolPixmap.width() <= 0 || symbolPixmap.height() <= 0)
         {
-            qDebug() << "RTW: Invalid pixmap for symbol" << symbolData.symbolName << "type" << static_cast<int>(symbolType) << "- skipping";
+            UI_DEBUG(lcWaterfallDraw) << "RTW: Invalid pixmap for symbol" << symbolData.symbolName << "type" << static_cast<int>(symbolType) << "- skipping";
             continue;
         }
         
@@ -482,7 +420,7 @@ void RTWGraph::drawRTWSymbols()
         // Validate pixmap item was created successfully
         if (!pixmapItem)
         {
-            qDebug() << "RTW: Failed to create pixmap item for symbol" << symbolData.symbolName << "- skipping";
+            UI_DEBUG(lcWaterfallDraw) << "RTW: Failed to create pixmap item for symbol" << symbolData.symbolName << "- skipping";
             continue;
         }
         
@@ -490,7 +428,7 @@ void RTWGraph::drawRTWSymbols()
         QRectF pixmapRect = pixmapItem->boundingRect();
         if (pixmapRect.width() <= 0 || pixmapRect.height() <= 0)
         {
-            qDebug() << "RTW: Invalid pixmap rect for symbol" << symbolData.symbolName << "- skipping";
+            UI_DEBUG(lcWaterfallDraw) << "RTW: Invalid pixmap rect for symbol" << symbolData.symbolName << "- skipping";
             delete pixmapItem;
             continue;
         }
@@ -499,12 +437,12 @@ void RTWGraph::drawRTWSymbols()
                           screenPos.y() - pixmapRect.height() / 2);
         pixmapItem->setZValue(1000); // High z-value to ensure visibility above other elements
         
-        graphicsScene->addItem(pixmapItem);
+        addDecorationItem(pixmapItem);
         symbolsDrawn++;
     }
     
     if (symbolsDrawn > 0)
     {
-        qDebug() << "RTW: Drew" << symbolsDrawn << "RTW symbols out of" << rtwSymbols.size() << "total";
+        UI_DEBUG(lcWaterfallDraw) << "RTW: Drew" << symbolsDrawn << "RTW symbols out of" << rtwSymbols.size() << "total";
     }
 }
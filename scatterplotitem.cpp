@@ -0,0 +1,220 @@
+#include "scatterplotitem.h"
+#include <QStyleOptionGraphicsItem>
+#include <QtMath>
+
+ScatterPlotItem::ScatterPlotItem(QGraphicsItem *parent)
+    : QGraphicsItem(parent)
+    , m_head(0)
+    , m_pointSize(3.0)
+    , m_pen(Qt::NoPen)
+    , m_brush(Qt::white)
+    , m_stampDevicePixelRatio(0.0)
+{
+    // Needed for exposedRect, used to skip markers outside the repainted area
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);
+}
+
+QRectF ScatterPlotItem::boundingRect() const
+{
+    if (getPointCount() == 0)
+    {
+        return QRectF();
+    }
+
+    // Markers extend half their size (plus the outline) beyond their centres
+    qreal margin = m_pointSize / 2 + qMax<qreal>(m_pen.widthF(), 1.0);
+    return m_pointBounds.adjusted(-margin, -margin, margin, margin);
+}
+
+void ScatterPlotItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_UNUSED(widget);
+
+    if (getPointCount() == 0)
+    {
+        return;
+    }
+
+    const QPixmap &marker = stamp(painter->device() ? painter->device()->devicePixelRatioF() : 1.0);
+    const QSizeF markerSize = marker.size() / marker.devicePixelRatio();
+    const QRectF sourceRect(QPointF(0, 0), marker.size());
+    const QRectF exposed = option->exposedRect.adjusted(-markerSize.width(), -markerSize.height(), markerSize.width(), markerSize.height());
+
+    // One fragment per visible marker, blitted in a single call
+    QVector<QPainter::PixmapFragment> fragments;
+    fragments.reserve(getPointCount());
+    for (int i = m_head; i < m_points.size(); ++i)
+    {
+        const QPointF &point = m_points[i];
+        if (exposed.contains(point))
+        {
+            fragments.append(QPainter::PixmapFragment::create(point, sourceRect));
+        }
+    }
+
+    if (!fragments.isEmpty())
+    {
+        painter->drawPixmapFragments(fragments.constData(), fragments.size(), marker);
+    }
+}
+
+void ScatterPlotItem::setPoints(const QVector<QPointF> &points)
+{
+    prepareGeometryChange();
+    m_points = points;
+    m_head = 0;
+    updateBounds();
+    update();
+}
+
+void ScatterPlotItem::addPoint(const QPointF &point)
+{
+    addPoints(&point, 1);
+}
+
+void ScatterPlotItem::addPoints(const QPointF *points, int count)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    prepareGeometryChange();
+    if (getPointCount() == 0)
+    {
+        m_pointBounds = QRectF(points[0], QSizeF(0, 0));
+    }
+    qreal left = m_pointBounds.left();
+    qreal right = m_pointBounds.right();
+    qreal top = m_pointBounds.top();
+    qreal bottom = m_pointBounds.bottom();
+    for (int i = 0; i < count; ++i)
+    {
+        left = qMin(left, points[i].x());
+        right = qMax(right, points[i].x());
+        top = qMin(top, points[i].y());
+        bottom = qMax(bottom, points[i].y());
+    }
+    m_pointBounds = QRectF(QPointF(left, top), QPointF(right, bottom));
+    m_points.reserve(m_points.size() + count);
+    for (int i = 0; i < count; ++i)
+    {
+        m_points.append(points[i]);
+    }
+    update();
+}
+
+void ScatterPlotItem::removeFirstPoints(int count)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+    m_head += qMin(count, getPointCount());
+
+    // Compact once the dead prefix is as large as the live markers, so each marker
+    // is moved at most once per removal and the bounds shrink to the live markers
+    if (m_head > 0 && m_head >= getPointCount())
+    {
+        compact();
+    }
+    update();
+}
+
+void ScatterPlotItem::clearPoints()
+{
+    prepareGeometryChange();
+    m_points.clear();
+    m_head = 0;
+    m_pointBounds = QRectF();
+    update();
+}
+
+void ScatterPlotItem::setPointSize(qreal size)
+{
+    prepareGeometryChange();
+    m_pointSize = size;
+    invalidateStamp();
+}
+
+void ScatterPlotItem::setPen(const QPen &pen)
+{
+    prepareGeometryChange();
+    m_pen = pen;
+    invalidateStamp();
+}
+
+void ScatterPlotItem::setBrush(const QBrush &brush)
+{
+    m_brush = brush;
+    invalidateStamp();
+}
+
+void ScatterPlotItem::updateBounds()
+{
+    if (getPointCount() == 0)
+    {
+        m_pointBounds = QRectF();
+        return;
+    }
+
+    qreal left = m_points[m_head].x();
+    qreal right = left;
+    qreal top = m_points[m_head].y();
+    qreal bottom = top;
+    for (int i = m_head; i < m_points.size(); ++i)
+    {
+        const QPointF &point = m_points[i];
+        left = qMin(left, point.x());
+        right = qMax(right, point.x());
+        top = qMin(top, point.y());
+        bottom = qMax(bottom, point.y());
+    }
+    m_pointBounds = QRectF(QPointF(left, top), QPointF(right, bottom));
+}
+
+void ScatterPlotItem::compact()
+{
+    prepareGeometryChange();
+    m_points.remove(0, m_head);
+    m_head = 0;
+    updateBounds();
+}
+
+void ScatterPlotItem::invalidateStamp()
+{
+    m_stamp = QPixmap();
+    m_stampDevicePixelRatio = 0.0;
+    update();
+}
+
+/**
+ * @brief Get the pre-rendered marker, drawing it the same way as a QGraphicsEllipseItem
+ *
+ * @param devicePixelRatio Device pixel ratio of the paint device
+ * @return const QPixmap& Marker pixmap centred on its middle pixel
+ */
+const QPixmap &ScatterPlotItem::stamp(qreal devicePixelRatio) const
+{
+    if (!m_stamp.isNull() && m_stampDevicePixelRatio == devicePixelRatio)
+    {
+        return m_stamp;
+    }
+
+    qreal penWidth = (m_pen.style() == Qt::NoPen) ? 0.0 : qMax<qreal>(m_pen.widthF(), 1.0);
+    int extent = qCeil(m_pointSize + penWidth) + 2;
+
+    m_stamp = QPixmap(qCeil(extent * devicePixelRatio), qCeil(extent * devicePixelRatio));
+    m_stamp.setDevicePixelRatio(devicePixelRatio);
+    m_stamp.fill(Qt::transparent);
+
+    QPainter stampPainter(&m_stamp);
+    stampPainter.setRenderHint(QPainter::Antialiasing, true);
+    stampPainter.setPen(m_pen);
+    stampPainter.setBrush(m_brush);
+    stampPainter.drawEllipse(QPointF(extent / 2.0, extent / 2.0), m_pointSize / 2, m_pointSize / 2);
+    stampPainter.end();
+
+    m_stampDevicePixelRatio = devicePixelRatio;
+    return m_stamp;
+}
@@ -0,0 +1,107 @@
+#ifndef SCATTERPLOTITEM_H
+#define SCATTERPLOTITEM_H
+
+#include <QGraphicsItem>
+#include <QPainter>
+#include <QPen>
+#include <QBrush>
+#include <QPixmap>
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+
+/**
+ * @brief Graphics item that draws a whole series of scatter markers
+ *
+ * Holds a flat array of marker centres (in item coordinates) and paints all of
+ * them in a single paint() call by stamping a cached marker pixmap, so a series
+ * costs one entry in the scene index instead of one item per point. Markers removed
+ * from the front only advance a head index; the dead prefix is compacted once it is
+ * as large as the live markers, so scrolling stays amortized O(1) per marker.
+ */
+class ScatterPlotItem : public QGraphicsItem
+{
+public:
+    /**
+     * @brief Constructor
+     * @param parent Parent graphics item
+     */
+    explicit ScatterPlotItem(QGraphicsItem *parent = nullptr);
+
+    // QGraphicsItem interface
+    QRectF boundingRect() const override;
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+
+    /**
+     * @brief Replace all marker centres
+     * @param points Marker centres in item coordinates
+     */
+    void setPoints(const QVector<QPointF> &points);
+
+    /**
+     * @brief Append a single marker centre
+     * @param point Marker centre in item coordinates
+     */
+    void addPoint(const QPointF &point);
+
+    /**
+     * @brief Append a run of marker centres with a single geometry change and repaint
+     * @param points Marker centres in item coordinates
+     * @param count Number of marker centres
+     */
+    void addPoints(const QPointF *points, int count);
+
+    /**
+     * @brief Remove the oldest markers (the bounds only shrink when the dead prefix is compacted)
+     * @param count Number of markers to remove from the front
+     */
+    void removeFirstPoints(int count);
+
+    /**
+     * @brief Remove all markers
+     */
+    void clearPoints();
+
+    const QPointF *getPoints() const { return m_points.constData() + m_head; }
+    int getPointCount() const { return m_points.size() - m_head; }
+
+    /**
+     * @brief Set the marker diameter
+     * @param size Diameter in pixels
+     */
+    void setPointSize(qreal size);
+    qreal getPointSize() const { return m_pointSize; }
+
+    /**
+     * @brief Set the marker outline pen
+     * @param pen Outline pen (Qt::NoPen for no outline)
+     */
+    void setPen(const QPen &pen);
+    QPen getPen() const { return m_pen; }
+
+    /**
+     * @brief Set the marker fill brush
+     * @param brush Fill brush (Qt::NoBrush for outline-only markers)
+     */
+    void setBrush(const QBrush &brush);
+    QBrush getBrush() const { return m_brush; }
+
+private:
+    void updateBounds();
+    void compact();
+    void invalidateStamp();
+    const QPixmap &stamp(qreal devicePixelRatio) const;
+
+    QVector<QPointF> m_points;
+    int m_head; // Index of the oldest live marker in m_points
+    QRectF m_pointBounds; // Bounds of the marker centres
+    qreal m_pointSize;
+    QPen m_pen;
+    QBrush m_brush;
+
+    // Pre-rendered marker, rebuilt when the style or device pixel ratio changes
+    mutable QPixmap m_stamp;
+    mutable qreal m_stampDevicePixelRatio;
+};
+
+#endif // SCATTERPLOTITEM_H
@@ -0,0 +1,84 @@
+#include "screentransform.h"
+#include <cmath>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SCREENTRANSFORM_SSE2 1
+#endif
+
+ScreenTransform::ScreenTransform()
+    : m_xScale(0.0)
+    , m_xOffset(0.0)
+    , m_yScale(0.0)
+    , m_yOffset(0.0)
+    , m_timeMaxMs(0)
+{
+}
+
+void ScreenTransform::set(qreal yMin, qreal yMax, qint64 timeMaxMs, qint64 intervalMs, const QRectF &area)
+{
+    m_xScale = area.width() / (yMax - yMin);
+    m_xOffset = area.left() - yMin * m_xScale;
+    m_yScale = area.height() / (qreal)intervalMs;
+    m_yOffset = area.top();
+    m_timeMaxMs = timeMaxMs;
+}
+
+qint64 ScreenTransform::timeAt(qreal y) const
+{
+    if (m_yScale == 0.0)
+    {
+        return m_timeMaxMs;
+    }
+    return m_timeMaxMs - static_cast<qint64>((y - m_yOffset) / m_yScale);
+}
+
+/**
+ * @brief Map columns of samples to scene positions
+ *
+ * The SSE2 path maps two samples per step. Time offsets from timeMax are converted
+ * to double with the 2^52 + 2^51 bias trick (exact for offsets below 2^51 ms, far
+ * beyond any epoch time), and the operations match map() so both paths give the
+ * same positions.
+ *
+ * @param values Pointer to count values
+ * @param timestampsMs Pointer to count timestamps (ms since epoch)
+ * @param count Number of samples
+ * @param out Receives count scene positions
+ */
+void ScreenTransform::mapPoints(const qreal *values, const qint64 *timestampsMs, size_t count, QPointF *out) const
+{
+    size_t i = 0;
+
+#ifdef SCREENTRANSFORM_SSE2
+    if (std::is_same<qreal, double>::value && sizeof(QPointF) == 2 * sizeof(double))
+    {
+        const __m128d bias = _mm_set1_pd(6755399441055744.0); // 2^52 + 2^51
+        const __m128i biasBits = _mm_castpd_si128(bias);
+        const __m128i timeMax = _mm_set1_epi64x(m_timeMaxMs);
+        const __m128d xScale = _mm_set1_pd(m_xScale);
+        const __m128d xOffset = _mm_set1_pd(m_xOffset);
+        const __m128d yScale = _mm_set1_pd(m_yScale);
+        const __m128d yOffset = _mm_set1_pd(m_yOffset);
+        double *dst = reinterpret_cast<double *>(out);
+
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128d x = _mm_add_pd(xOffset, _mm_mul_pd(_mm_loadu_pd(values + i), xScale));
+
+            __m128i offsetMs = _mm_sub_epi64(timeMax, _mm_loadu_si128(reinterpret_cast<const __m128i *>(timestampsMs + i)));
+            __m128d offset = _mm_sub_pd(_mm_castsi128_pd(_mm_add_epi64(offsetMs, biasBits)), bias);
+            __m128d y = _mm_add_pd(yOffset, _mm_mul_pd(offset, yScale));
+
+            _mm_storeu_pd(dst + 2 * i, _mm_unpacklo_pd(x, y));
+            _mm_storeu_pd(dst + 2 * i + 2, _mm_unpackhi_pd(x, y));
+        }
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        out[i] = map(values[i], timestampsMs[i]);
+    }
+}
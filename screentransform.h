@@ -0,0 +1,58 @@
+#ifndef SCREENTRANSFORM_H
+#define SCREENTRANSFORM_H
+
+#include <QPointF>
+#include <QRectF>
+#include <QtGlobal>
+
+/**
+ * @brief Affine data-to-screen mapping of the waterfall graphs
+ *
+ * Values run horizontally across the drawing area and time runs vertically, with
+ * timeMax on the top row. The scale and offset of both axes are computed once by
+ * set(), so mapping a sample is two multiply-adds; mapPoints() converts whole
+ * value and epoch-ms columns in one pass and uses SSE2 where the target has it.
+ */
+class ScreenTransform
+{
+public:
+    ScreenTransform();
+
+    /**
+     * @brief Compute the mapping
+     * @param yMin Value at the left edge of the area
+     * @param yMax Value at the right edge of the area
+     * @param timeMaxMs Time at the top edge (ms since epoch)
+     * @param intervalMs Time span covered by the area height
+     * @param area Drawing area in scene coordinates
+     */
+    void set(qreal yMin, qreal yMax, qint64 timeMaxMs, qint64 intervalMs, const QRectF &area);
+
+    QPointF map(qreal value, qint64 timestampMs) const
+    {
+        return QPointF(m_xOffset + value * m_xScale, m_yOffset + (m_timeMaxMs - timestampMs) * m_yScale);
+    }
+
+    qreal mapTime(qint64 timestampMs) const { return m_yOffset + (m_timeMaxMs - timestampMs) * m_yScale; }
+    qint64 timeAt(qreal y) const; // Inverse of mapTime
+
+    /**
+     * @brief Map count samples from value and timestamp columns
+     * @param values Pointer to count values
+     * @param timestampsMs Pointer to count timestamps (ms since epoch)
+     * @param count Number of samples
+     * @param out Receives count scene positions
+     */
+    void mapPoints(const qreal *values, const qint64 *timestampsMs, size_t count, QPointF *out) const;
+
+    qint64 timeMaxMs() const { return m_timeMaxMs; }
+
+private:
+    qreal m_xScale;
+    qreal m_xOffset;
+    qreal m_yScale;  // Rows per ms before timeMax
+    qreal m_yOffset; // Row of timeMax
+    qint64 m_timeMaxMs;
+};
+
+#endif // SCREENTRANSFORM_H
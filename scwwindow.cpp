@@ -955,6 +955,28 @@ void SCWWindow::addDataPoints(SCW_SERIES_E series, const std::vector<qreal>& yDa
     qDebug() << "addDataPoints called for series:" << seriesLabel << "with" << yData.size() << "points";
 }
 
+void SCWWindow::setRasterRenderingEnabled(bool enabled)
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        if (m_waterfallGraphs[i])
+        {
+            m_waterfallGraphs[i]->setRasterRenderingEnabled(enabled);
+        }
+    }
+}
+
+void SCWWindow::setScrollingBitmapEnabled(bool enabled)
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        if (m_waterfallGraphs[i])
+        {
+            m_waterfallGraphs[i]->setScrollingBitmapEnabled(enabled);
+        }
+    }
+}
+
 // Slot implementations for button clicks (old definitions removed - see below)
 
 // Helper methods for cycling series
@@ -85,6 +85,12 @@ public:
     void setDataPoints(SCW_SERIES_E series, const std::vector<qreal> &yData, const std::vector<QDateTime> &timestamps);
     void addDataPoints(SCW_SERIES_E series, const std::vector<qreal> &yData, const std::vector<QDateTime> &timestamps);
 
+    // Rasterize the series of all 8 panes on the thread pool instead of the GUI thread
+    void setRasterRenderingEnabled(bool enabled);
+
+    // Scroll a backing bitmap of each pane and render only the newly exposed rows
+    void setScrollingBitmapEnabled(bool enabled);
+
 signals:
     void seriesSelected(const QString &seriesName);
 
@@ -0,0 +1,156 @@
+#include "seriespathdecimator.h"
+#include <QtMath>
+
+SeriesPathDecimator::SeriesPathDecimator()
+    : m_head(0)
+    , m_bucketOpen(false)
+    , m_bucketRow(0)
+    , m_first{0, QPointF()}
+    , m_min{0, QPointF()}
+    , m_max{0, QPointF()}
+    , m_last{0, QPointF()}
+    , m_timeMaxMs(0)
+    , m_rowsPerMs(0.0)
+{
+}
+
+void SeriesPathDecimator::reset(qint64 timeMaxMs, qreal rowsPerMs)
+{
+    m_vertices.clear();
+    m_head = 0;
+    m_bucketOpen = false;
+    m_timeMaxMs = timeMaxMs;
+    m_rowsPerMs = rowsPerMs;
+}
+
+/**
+ * @brief Add a sample; the min/max of a row are taken along X, which is where the value is plotted
+ *
+ * @param timestampMs Sample time (ms since epoch)
+ * @param point Sample position in scene coordinates
+ */
+void SeriesPathDecimator::addSample(qint64 timestampMs, const QPointF &point)
+{
+    Vertex vertex{timestampMs, point};
+    qint64 row = rowOf(timestampMs);
+
+    if (!m_bucketOpen || row != m_bucketRow)
+    {
+        closeBucket();
+        m_bucketOpen = true;
+        m_bucketRow = row;
+        m_first = m_min = m_max = m_last = vertex;
+        return;
+    }
+
+    if (point.x() < m_min.point.x())
+    {
+        m_min = vertex;
+    }
+    if (point.x() > m_max.point.x())
+    {
+        m_max = vertex;
+    }
+    m_last = vertex;
+}
+
+void SeriesPathDecimator::trimBefore(qint64 timestampMs)
+{
+    while (m_head < m_vertices.size() && m_vertices[m_head].timestampMs < timestampMs)
+    {
+        ++m_head;
+    }
+
+    // Compact once the dropped prefix is as large as what is left
+    if (m_head > 0 && m_head >= m_vertices.size() - m_head)
+    {
+        m_vertices.erase(m_vertices.begin(), m_vertices.begin() + m_head);
+        m_head = 0;
+    }
+}
+
+QPainterPath SeriesPathDecimator::path() const
+{
+    std::vector<Vertex> openVertices;
+    openBucketVertices(openVertices);
+
+    QPainterPath path;
+    bool started = false;
+    auto addVertex = [&](const Vertex &vertex) {
+        if (!started)
+        {
+            path.moveTo(vertex.point);
+            started = true;
+        }
+        else
+        {
+            path.lineTo(vertex.point);
+        }
+    };
+
+    for (size_t i = m_head; i < m_vertices.size(); ++i)
+    {
+        addVertex(m_vertices[i]);
+    }
+    for (const Vertex &vertex : openVertices)
+    {
+        addVertex(vertex);
+    }
+    return path;
+}
+
+size_t SeriesPathDecimator::vertexCount() const
+{
+    std::vector<Vertex> openVertices;
+    openBucketVertices(openVertices);
+    return m_vertices.size() - m_head + openVertices.size();
+}
+
+qint64 SeriesPathDecimator::rowOf(qint64 timestampMs) const
+{
+    return (qint64)qFloor((m_timeMaxMs - timestampMs) * m_rowsPerMs);
+}
+
+void SeriesPathDecimator::closeBucket()
+{
+    if (!m_bucketOpen)
+    {
+        return;
+    }
+
+    openBucketVertices(m_vertices);
+    m_bucketOpen = false;
+}
+
+/**
+ * @brief Get the first, min, max and last vertices of the open bucket in time order, without repeats
+ *
+ * @param vertices Receives the vertices
+ */
+void SeriesPathDecimator::openBucketVertices(std::vector<Vertex> &vertices) const
+{
+    if (!m_bucketOpen)
+    {
+        return;
+    }
+
+    const Vertex &low = (m_min.timestampMs <= m_max.timestampMs) ? m_min : m_max;
+    const Vertex &high = (m_min.timestampMs <= m_max.timestampMs) ? m_max : m_min;
+    auto sameVertex = [](const Vertex &a, const Vertex &b) {
+        return a.timestampMs == b.timestampMs && a.point == b.point;
+    };
+
+    vertices.push_back(m_first);
+    if (!sameVertex(low, m_first))
+    {
+        vertices.push_back(low);
+    }
+    if (!sameVertex(high, vertices.back()))
+    {
+        vertices.push_back(high);
+    }
+    if (!sameVertex(m_last, vertices.back()))
+    {
+        vertices.push_back(m_last);
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef SERIESPATHDECIMATOR_H
+#define SERIESPATHDECIMATOR_H
+
+#include <QPainterPath>
+#include <QPointF>
+#include <QtGlobal>
+#include <vector>
+
+/**
+ * @brief Incremental min/max-preserving decimator for waterfall series lines
+ *
+ * Time runs vertically on the waterfall graphs, so every screen row is one time
+ * bucket. Each bucket keeps at most its first, min, max and last vertices (in time
+ * order), which draws the same line while bounding the path size by the widget
+ * height. Samples are fed in time order; closed buckets are kept so that newly
+ * arrived samples only touch the newest bucket.
+ */
+class SeriesPathDecimator
+{
+public:
+    SeriesPathDecimator();
+
+    /**
+     * @brief Drop all vertices and set the time-to-row mapping
+     * @param timeMaxMs Time at the top row (ms since epoch)
+     * @param rowsPerMs Screen rows per millisecond
+     */
+    void reset(qint64 timeMaxMs, qreal rowsPerMs);
+
+    /**
+     * @brief Add the next sample in time order
+     * @param timestampMs Sample time (ms since epoch)
+     * @param point Sample position in scene coordinates
+     */
+    void addSample(qint64 timestampMs, const QPointF &point);
+
+    /**
+     * @brief Drop vertices older than the given time
+     * @param timestampMs Oldest time to keep (ms since epoch)
+     */
+    void trimBefore(qint64 timestampMs);
+
+    QPainterPath path() const;
+    size_t vertexCount() const;
+    bool isEmpty() const { return vertexCount() == 0; }
+
+private:
+    struct Vertex
+    {
+        qint64 timestampMs;
+        QPointF point;
+    };
+
+    qint64 rowOf(qint64 timestampMs) const;
+    void closeBucket();
+    void openBucketVertices(std::vector<Vertex> &vertices) const;
+
+    std::vector<Vertex> m_vertices; // Vertices of closed buckets, in time order
+    size_t m_head;                  // First live entry of m_vertices
+
+    // Newest bucket, still accepting samples
+    bool m_bucketOpen;
+    qint64 m_bucketRow;
+    Vertex m_first;
+    Vertex m_min;
+    Vertex m_max;
+    Vertex m_last;
+
+    qint64 m_timeMaxMs;
+    qreal m_rowsPerMs;
+};
+
+#endif // SERIESPATHDECIMATOR_H
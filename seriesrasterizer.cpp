@@ -0,0 +1,167 @@
+#include "seriesrasterizer.h"
+#include "seriespathdecimator.h"
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <QtMath>
+#include <algorithm>
+
+/**
+ * @brief Render all layers of a job into a transparent image covering its drawing area
+ *
+ * @param job Snapshot of the layers and the screen mapping
+ * @return QImage Image with the device pixel ratio of the job (null if the area is empty)
+ */
+QImage SeriesRasterizer::rasterize(const SeriesRasterJob &job)
+{
+    if (job.area.isEmpty())
+    {
+        return QImage();
+    }
+
+    QImage image(qCeil(job.area.width() * job.devicePixelRatio), qCeil(job.area.height() * job.devicePixelRatio),
+                 QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(job.devicePixelRatio);
+    image.fill(Qt::transparent);
+
+    std::vector<const SeriesRasterLayer *> layers;
+    layers.reserve(job.layers.size());
+    for (const SeriesRasterLayer &layer : job.layers)
+    {
+        layers.push_back(&layer);
+    }
+    std::stable_sort(layers.begin(), layers.end(),
+                     [](const SeriesRasterLayer *a, const SeriesRasterLayer *b) { return a->zValue < b->zValue; });
+
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.translate(-job.area.topLeft());
+    for (const SeriesRasterLayer *layer : layers)
+    {
+        paintLayer(painter, job, *layer);
+    }
+    painter.end();
+
+    return image;
+}
+
+void SeriesRasterizer::paintLayer(QPainter &painter, const SeriesRasterJob &job, const SeriesRasterLayer &layer)
+{
+    if (layer.kind == SeriesRasterLayer::Kind::Line)
+    {
+        drawLine(painter, job, layer);
+    }
+    else
+    {
+        drawMarkers(painter, job, layer);
+    }
+}
+
+void SeriesRasterizer::drawLine(QPainter &painter, const SeriesRasterJob &job, const SeriesRasterLayer &layer)
+{
+    size_t count = layer.timestampsMs.size();
+    if (count < 2)
+    {
+        return;
+    }
+
+    std::vector<QPointF> points(count);
+    job.transform.mapPoints(layer.yData.data(), layer.timestampsMs.data(), count, points.data());
+
+    SeriesPathDecimator decimator;
+    decimator.reset(job.transform.timeMaxMs(), job.rowsPerMs);
+    for (size_t i = 0; i < count; ++i)
+    {
+        decimator.addSample(layer.timestampsMs[i], points[i]);
+    }
+
+    painter.setPen(layer.pen);
+    painter.setBrush(Qt::NoBrush);
+    painter.drawPath(decimator.path());
+}
+
+/**
+ * @brief Stamp one pre-rendered marker per sample, drawn like ScatterPlotItem markers
+ */
+void SeriesRasterizer::drawMarkers(QPainter &painter, const SeriesRasterJob &job, const SeriesRasterLayer &layer)
+{
+    size_t count = layer.timestampsMs.size();
+    if (count == 0)
+    {
+        return;
+    }
+
+    qreal penWidth = (layer.pen.style() == Qt::NoPen) ? 0.0 : qMax<qreal>(layer.pen.widthF(), 1.0);
+    int extent = qCeil(layer.pointSize + penWidth) + 2;
+
+    QImage marker(qCeil(extent * job.devicePixelRatio), qCeil(extent * job.devicePixelRatio), QImage::Format_ARGB32_Premultiplied);
+    marker.setDevicePixelRatio(job.devicePixelRatio);
+    marker.fill(Qt::transparent);
+    QPainter markerPainter(&marker);
+    markerPainter.setRenderHint(QPainter::Antialiasing, true);
+    markerPainter.setPen(layer.pen);
+    markerPainter.setBrush(layer.brush);
+    markerPainter.drawEllipse(QPointF(extent / 2.0, extent / 2.0), layer.pointSize / 2, layer.pointSize / 2);
+    markerPainter.end();
+
+    std::vector<QPointF> points(count);
+    job.transform.mapPoints(layer.yData.data(), layer.timestampsMs.data(), count, points.data());
+
+    const QRectF visible = job.area.adjusted(-extent, -extent, extent, extent);
+    const QPointF centre(extent / 2.0, extent / 2.0);
+    for (const QPointF &point : points)
+    {
+        if (visible.contains(point))
+        {
+            painter.drawImage(point - centre, marker);
+        }
+    }
+}
+
+SeriesRasterItem::SeriesRasterItem(QGraphicsItem *parent)
+    : QGraphicsItem(parent), m_topRow(0)
+{
+}
+
+QRectF SeriesRasterItem::boundingRect() const
+{
+    return m_area;
+}
+
+void SeriesRasterItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_UNUSED(option);
+    Q_UNUSED(widget);
+
+    if (m_image.isNull())
+    {
+        return;
+    }
+
+    const int height = m_image.height();
+    if (m_topRow <= 0 || m_topRow >= height)
+    {
+        painter->drawImage(m_area.topLeft(), m_image);
+        return;
+    }
+
+    // Ring buffer: rows from the top row to the end of the image, then the wrapped rows from its start
+    const qreal dpr = m_image.devicePixelRatio();
+    const qreal width = m_image.width() / dpr;
+    const qreal upperHeight = (height - m_topRow) / dpr;
+    painter->drawImage(QRectF(m_area.left(), m_area.top(), width, upperHeight),
+                       m_image, QRectF(0, m_topRow, m_image.width(), height - m_topRow));
+    painter->drawImage(QRectF(m_area.left(), m_area.top() + upperHeight, width, m_topRow / dpr),
+                       m_image, QRectF(0, 0, m_image.width(), m_topRow));
+}
+
+void SeriesRasterItem::setImage(const QImage &image, const QRectF &area, int topRow)
+{
+    if (area != m_area)
+    {
+        prepareGeometryChange();
+        m_area = area;
+    }
+    m_image = image;
+    m_topRow = topRow;
+    update();
+}
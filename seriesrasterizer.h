@@ -0,0 +1,97 @@
+#ifndef SERIESRASTERIZER_H
+#define SERIESRASTERIZER_H
+
+#include "screentransform.h"
+#include <QBrush>
+#include <QGraphicsItem>
+#include <QImage>
+#include <QPen>
+#include <QRectF>
+#include <QtGlobal>
+#include <vector>
+
+/**
+ * @brief One series line or marker set to rasterize, with its own copy of the samples
+ */
+struct SeriesRasterLayer
+{
+    enum class Kind
+    {
+        Line,   // Decimated per pixel row like WaterfallGraph::decimateSeries
+        Markers // One marker per sample
+    };
+
+    Kind kind = Kind::Line;
+    std::vector<qint64> timestampsMs;
+    std::vector<qreal> yData;
+    QPen pen;
+    QBrush brush;
+    qreal pointSize = 0.0;
+    qreal zValue = 0.0; // Layers are painted in z order, then in the order they were added
+};
+
+/**
+ * @brief Everything a worker thread needs to rasterize the series of one graph
+ *
+ * Jobs are self-contained snapshots: they never point into WaterfallData, so the
+ * GUI thread can keep ingesting while a job is rendered.
+ */
+struct SeriesRasterJob
+{
+    ScreenTransform transform;
+    QRectF area;          // Drawing area in scene coordinates; the image covers exactly this
+    qreal rowsPerMs = 0.0;
+    qreal devicePixelRatio = 1.0;
+    std::vector<SeriesRasterLayer> layers;
+};
+
+/**
+ * @brief Renders series raster jobs into images, safe to call from any thread
+ */
+class SeriesRasterizer
+{
+public:
+    static QImage rasterize(const SeriesRasterJob &job);
+
+    /**
+     * @brief Paint one layer with the mapping of a job onto a painter in scene coordinates
+     * @param painter Painter of an image covering job.area
+     * @param job Mapping, area and device pixel ratio (its layers are not used)
+     * @param layer Layer to paint
+     */
+    static void paintLayer(QPainter &painter, const SeriesRasterJob &job, const SeriesRasterLayer &layer);
+
+private:
+    static void drawLine(QPainter &painter, const SeriesRasterJob &job, const SeriesRasterLayer &layer);
+    static void drawMarkers(QPainter &painter, const SeriesRasterJob &job, const SeriesRasterLayer &layer);
+};
+
+/**
+ * @brief Graphics item blitting a finished series image at its drawing area
+ */
+class SeriesRasterItem : public QGraphicsItem
+{
+public:
+    explicit SeriesRasterItem(QGraphicsItem *parent = nullptr);
+
+    QRectF boundingRect() const override;
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+
+    /**
+     * @brief Replace the image
+     * @param image Image with its device pixel ratio set
+     * @param area Scene rectangle the image covers
+     * @param topRow Image row shown at the top of the area; the rows above it wrap around below
+     */
+    void setImage(const QImage &image, const QRectF &area, int topRow = 0);
+
+    // Drop the reference to the image, so that its owner can modify it without a copy
+    void releaseImage() { m_image = QImage(); }
+
+private:
+    QImage m_image;
+    QRectF m_area;
+    int m_topRow; // Ring buffer start row of the image
+};
+
+#endif // SERIESRASTERIZER_H
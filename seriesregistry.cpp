@@ -0,0 +1,77 @@
+#include "seriesregistry.h"
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <vector>
+
+namespace
+{
+struct RegistryTables
+{
+    QMutex mutex;
+    QHash<QString, int> idsByLabel;
+    std::vector<QString> labelsById;
+};
+
+RegistryTables &tables()
+{
+    static RegistryTables registry;
+    return registry;
+}
+} // namespace
+
+const int SeriesRegistry::kInvalidId;
+
+/**
+ * @brief Get the ID of a series label, assigning the next free ID on first use.
+ *
+ * @param seriesLabel Series label
+ * @return int Series ID (stable for the lifetime of the process)
+ */
+int SeriesRegistry::intern(const QString &seriesLabel)
+{
+    RegistryTables &registry = tables();
+    QMutexLocker locker(&registry.mutex);
+
+    auto it = registry.idsByLabel.constFind(seriesLabel);
+    if (it != registry.idsByLabel.constEnd())
+    {
+        return it.value();
+    }
+
+    int seriesId = static_cast<int>(registry.labelsById.size());
+    registry.labelsById.push_back(seriesLabel);
+    registry.idsByLabel.insert(seriesLabel, seriesId);
+    return seriesId;
+}
+
+/**
+ * @brief Get the ID of a series label without assigning one.
+ *
+ * @param seriesLabel Series label
+ * @return int Series ID, or kInvalidId if the label was never interned
+ */
+int SeriesRegistry::find(const QString &seriesLabel)
+{
+    RegistryTables &registry = tables();
+    QMutexLocker locker(&registry.mutex);
+    return registry.idsByLabel.value(seriesLabel, kInvalidId);
+}
+
+QString SeriesRegistry::label(int seriesId)
+{
+    RegistryTables &registry = tables();
+    QMutexLocker locker(&registry.mutex);
+    if (seriesId < 0 || seriesId >= static_cast<int>(registry.labelsById.size()))
+    {
+        return QString();
+    }
+    return registry.labelsById[seriesId];
+}
+
+int SeriesRegistry::count()
+{
+    RegistryTables &registry = tables();
+    QMutexLocker locker(&registry.mutex);
+    return static_cast<int>(registry.labelsById.size());
+}
@@ -0,0 +1,22 @@
+#ifndef SERIESREGISTRY_H
+#define SERIESREGISTRY_H
+
+#include <QString>
+
+// Process-wide interning of series labels into dense integer IDs.
+//
+// A label gets its ID the first time it is interned; the ID never changes and is never
+// reused, so data sources and graphs can keep per-series state in vectors indexed by it
+// and only translate labels at their public API. All methods are thread-safe.
+class SeriesRegistry
+{
+public:
+    static const int kInvalidId = -1;
+
+    static int intern(const QString &seriesLabel); // Assigns an ID on first use
+    static int find(const QString &seriesLabel);   // kInvalidId if never interned
+    static QString label(int seriesId);            // Empty for unknown IDs
+    static int count();                            // IDs are 0 .. count() - 1
+};
+
+#endif // SERIESREGISTRY_H
@@ -0,0 +1,850 @@
+#include "sessionrecording.h"
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+const char kFileMagic[8] = {'W', 'F', 'S', 'R', 'E', 'C', '0', '1'};
+const char kTrailerMagic[8] = {'W', 'F', 'S', 'R', 'I', 'D', 'X', '1'};
+const quint32 kFormatVersion = 1;
+
+const quint32 kSeriesBlock = 1;
+const quint32 kAnnotationBlock = 2;
+const quint32 kIndexBlock = 3;
+
+const quint32 kRTWSymbol = 0;
+const quint32 kBTWSymbol = 1;
+const quint32 kBTWMarker = 2;
+const quint32 kRTWRMarker = 3;
+
+struct FileHeader
+{
+    char magic[8];
+    quint32 version;
+    quint32 reserved;
+};
+
+struct BlockHeader
+{
+    quint32 type;
+    qint32 graphType;
+    quint64 payloadBytes;
+};
+
+struct ChunkHeader
+{
+    quint64 count;
+    qint64 firstMs;
+    qint64 lastMs;
+    quint32 labelBytes;
+    quint32 reserved;
+};
+
+struct AnnotationRecord
+{
+    quint32 kind;
+    quint32 nameBytes;
+    qint64 timestampMs;
+    double range;
+    double delta;
+};
+
+struct IndexChunkEntry
+{
+    qint32 graphType;
+    quint32 labelBytes;
+    quint64 blockOffset;
+    qint64 firstMs;
+    qint64 lastMs;
+    quint64 count;
+};
+
+struct IndexAnnotationEntry
+{
+    qint32 graphType;
+    quint32 reserved;
+    quint64 blockOffset;
+};
+
+struct Trailer
+{
+    quint64 indexOffset;
+    char magic[8];
+};
+
+quint64 padded(quint64 bytes)
+{
+    return (bytes + 7) & ~quint64(7);
+}
+
+// Byte offset of the timestamp column within a series block
+quint64 chunkColumnsOffset(quint32 labelBytes)
+{
+    return sizeof(BlockHeader) + sizeof(ChunkHeader) + padded(labelBytes);
+}
+
+template <typename T>
+bool readStruct(const uchar *data, quint64 size, quint64 offset, T &out)
+{
+    if (offset > size || size - offset < sizeof(T))
+    {
+        return false;
+    }
+    std::memcpy(&out, data + offset, sizeof(T));
+    return true;
+}
+} // namespace
+
+SessionRecorder::SessionRecorder()
+    : m_offset(0), m_writeFailed(false)
+{
+    m_writer.setMaxThreadCount(1);
+}
+
+SessionRecorder::~SessionRecorder()
+{
+    close();
+}
+
+/**
+ * @brief Create (or truncate) a recording file and write its header.
+ *
+ * @param filePath Path of the recording
+ * @return true if the file is ready for recording
+ */
+bool SessionRecorder::open(const QString &filePath)
+{
+    close();
+
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qDebug() << "SessionRecorder: Cannot open" << filePath << "for writing:" << m_file.errorString();
+        return false;
+    }
+
+    m_offset = 0;
+    m_buffer.clear();
+    m_writeFailed = false;
+    m_index.clear();
+    m_annotationIndex.clear();
+    m_lastRecordedMs.clear();
+    m_annotationRevisions.clear();
+
+    FileHeader header;
+    std::memcpy(header.magic, kFileMagic, sizeof(header.magic));
+    header.version = kFormatVersion;
+    header.reserved = 0;
+    if (!writeRaw(&header, sizeof(header)))
+    {
+        return false;
+    }
+    flushBuffer();
+
+    qDebug() << "SessionRecorder: Recording to" << filePath;
+    return true;
+}
+
+/**
+ * @brief Write the time index block and trailer, wait for the writer, then close the file.
+ *
+ */
+void SessionRecorder::close()
+{
+    if (!m_file.isOpen())
+    {
+        return;
+    }
+
+    quint64 payloadBytes = sizeof(quint64) + sizeof(quint64);
+    for (const SessionRecordingChunk &chunk : m_index)
+    {
+        payloadBytes += sizeof(IndexChunkEntry) + padded(chunk.seriesLabel.toUtf8().size());
+    }
+    payloadBytes += m_annotationIndex.size() * sizeof(IndexAnnotationEntry);
+
+    quint64 indexOffset = m_offset;
+    bool ok = writeBlockHeader(kIndexBlock, -1, payloadBytes);
+
+    quint64 chunkCount = m_index.size();
+    ok = ok && writeRaw(&chunkCount, sizeof(chunkCount));
+    for (size_t i = 0; ok && i < m_index.size(); ++i)
+    {
+        const SessionRecordingChunk &chunk = m_index[i];
+        QByteArray label = chunk.seriesLabel.toUtf8();
+
+        IndexChunkEntry entry;
+        entry.graphType = static_cast<qint32>(chunk.graphType);
+        entry.labelBytes = static_cast<quint32>(label.size());
+        entry.blockOffset = chunk.blockOffset;
+        entry.firstMs = chunk.firstMs;
+        entry.lastMs = chunk.lastMs;
+        entry.count = chunk.count;
+        ok = writeRaw(&entry, sizeof(entry)) && writeRaw(label.constData(), label.size()) && writePadding();
+    }
+
+    quint64 annotationCount = m_annotationIndex.size();
+    ok = ok && writeRaw(&annotationCount, sizeof(annotationCount));
+    for (size_t i = 0; ok && i < m_annotationIndex.size(); ++i)
+    {
+        IndexAnnotationEntry entry;
+        entry.graphType = m_annotationIndex[i].first;
+        entry.reserved = 0;
+        entry.blockOffset = m_annotationIndex[i].second;
+        ok = writeRaw(&entry, sizeof(entry));
+    }
+
+    Trailer trailer;
+    trailer.indexOffset = indexOffset;
+    std::memcpy(trailer.magic, kTrailerMagic, sizeof(trailer.magic));
+    ok = ok && writeRaw(&trailer, sizeof(trailer));
+
+    flushBuffer();
+    m_writer.waitForDone();
+    ok = ok && !m_writeFailed.load();
+
+    qDebug() << "SessionRecorder: Closed recording" << m_file.fileName() << "-" << m_index.size() << "chunks," << m_offset << "bytes" << (ok ? "" : "(index incomplete)");
+    m_file.close();
+}
+
+/**
+ * @brief Append the samples and annotations of a data source recorded since the last call.
+ *
+ * @param graphType Graph type of the data source
+ * @param dataSource Data source to record
+ */
+void SessionRecorder::recordDataSource(const GraphType &graphType, const WaterfallData &dataSource)
+{
+    if (!m_file.isOpen())
+    {
+        return;
+    }
+
+    qint32 type = static_cast<qint32>(graphType);
+    for (const QString &seriesLabel : dataSource.getDataSeriesLabels())
+    {
+        WaterfallSeriesView view = dataSource.getDataSeriesView(seriesLabel);
+        if (view.empty())
+        {
+            continue;
+        }
+
+        // Only samples newer than the last recorded one are appended
+        std::pair<qint32, QString> key(type, seriesLabel);
+        size_t first = 0;
+        auto lastIt = m_lastRecordedMs.find(key);
+        if (lastIt != m_lastRecordedMs.end())
+        {
+            first = static_cast<size_t>(std::upper_bound(view.timestampsMs, view.timestampsMs + view.count, lastIt->second) - view.timestampsMs);
+        }
+        if (first >= view.count)
+        {
+            continue;
+        }
+
+        size_t count = view.count - first;
+        QByteArray label = seriesLabel.toUtf8();
+
+        ChunkHeader chunkHeader;
+        chunkHeader.count = count;
+        chunkHeader.firstMs = view.timestampsMs[first];
+        chunkHeader.lastMs = view.timestampsMs[view.count - 1];
+        chunkHeader.labelBytes = static_cast<quint32>(label.size());
+        chunkHeader.reserved = 0;
+
+        quint64 blockOffset = m_offset;
+        quint64 payloadBytes = sizeof(ChunkHeader) + padded(label.size()) + count * (sizeof(qint64) + sizeof(qreal));
+        if (!writeBlockHeader(kSeriesBlock, type, payloadBytes) ||
+            !writeRaw(&chunkHeader, sizeof(chunkHeader)) ||
+            !writeRaw(label.constData(), label.size()) || !writePadding() ||
+            !writeRaw(view.timestampsMs + first, count * sizeof(qint64)) ||
+            !writeRaw(view.yData + first, count * sizeof(qreal)))
+        {
+            return;
+        }
+
+        SessionRecordingChunk chunk;
+        chunk.graphType = graphType;
+        chunk.seriesLabel = seriesLabel;
+        chunk.firstMs = chunkHeader.firstMs;
+        chunk.lastMs = chunkHeader.lastMs;
+        chunk.blockOffset = blockOffset;
+        chunk.count = count;
+        m_index.push_back(chunk);
+        m_lastRecordedMs[key] = chunkHeader.lastMs;
+    }
+
+    recordAnnotations(graphType, dataSource);
+    flushBuffer();
+}
+
+/**
+ * @brief Append a snapshot of the symbols and markers of a data source if any of them changed.
+ *
+ * @param graphType Graph type of the data source
+ * @param dataSource Data source to record
+ */
+void SessionRecorder::recordAnnotations(const GraphType &graphType, const WaterfallData &dataSource)
+{
+    qint32 type = static_cast<qint32>(graphType);
+
+    // The revision catches moves, edits and a delete plus add within one interval, which
+    // leave the counts unchanged; a source that never had annotations is not snapshotted
+    quint64 revision = dataSource.getAnnotationRevision();
+    auto revisionIt = m_annotationRevisions.find(type);
+    bool unchanged = (revisionIt != m_annotationRevisions.end()) ? revisionIt->second == revision : revision == 0;
+    if (unchanged)
+    {
+        return;
+    }
+
+    std::vector<size_t> counts = {dataSource.getRTWSymbolsCount(), dataSource.getBTWSymbolsCount(),
+                                  dataSource.getBTWMarkersCount(), dataSource.getRTWRMarkersCount()};
+
+    // Serialize every annotation as a fixed record followed by its (possibly empty) name
+    QByteArray payload;
+    quint64 recordCount = counts[0] + counts[1] + counts[2] + counts[3];
+    payload.append(reinterpret_cast<const char *>(&recordCount), sizeof(recordCount));
+    auto appendRecord = [&payload](quint32 kind, const QString &name, const QDateTime &timestamp, qreal range, qreal delta) {
+        QByteArray nameBytes = name.toUtf8();
+        AnnotationRecord record;
+        record.kind = kind;
+        record.nameBytes = static_cast<quint32>(nameBytes.size());
+        record.timestampMs = timestamp.toMSecsSinceEpoch();
+        record.range = range;
+        record.delta = delta;
+        payload.append(reinterpret_cast<const char *>(&record), sizeof(record));
+        payload.append(nameBytes);
+        payload.append(QByteArray(static_cast<int>(padded(nameBytes.size()) - nameBytes.size()), '\0'));
+    };
+
+    for (const RTWSymbolData &symbol : dataSource.getRTWSymbols())
+    {
+        appendRecord(kRTWSymbol, symbol.symbolName, symbol.timestamp, symbol.range, 0.0);
+    }
+    for (const BTWSymbolData &symbol : dataSource.getBTWSymbols())
+    {
+        appendRecord(kBTWSymbol, symbol.symbolName, symbol.timestamp, symbol.range, 0.0);
+    }
+    for (const BTWMarkerData &marker : dataSource.getBTWMarkers())
+    {
+        appendRecord(kBTWMarker, QString(), marker.timestamp, marker.range, marker.delta);
+    }
+    for (const RTWRMarkerData &marker : dataSource.getRTWRMarkers())
+    {
+        appendRecord(kRTWRMarker, QString(), marker.timestamp, marker.range, 0.0);
+    }
+
+    quint64 blockOffset = m_offset;
+    if (!writeBlockHeader(kAnnotationBlock, type, payload.size()) || !writeRaw(payload.constData(), payload.size()))
+    {
+        return;
+    }
+    m_annotationIndex.push_back(std::make_pair(type, blockOffset));
+    m_annotationRevisions[type] = revision;
+}
+
+bool SessionRecorder::writeBlockHeader(quint32 type, qint32 graphType, quint64 payloadBytes)
+{
+    BlockHeader header;
+    header.type = type;
+    header.graphType = graphType;
+    header.payloadBytes = payloadBytes;
+    return writeRaw(&header, sizeof(header));
+}
+
+bool SessionRecorder::writeRaw(const void *data, quint64 bytes)
+{
+    // The writer thread failed earlier; the recording is stopped
+    if (m_writeFailed.load())
+    {
+        return false;
+    }
+
+    if (bytes == 0)
+    {
+        return true;
+    }
+
+    m_buffer.append(static_cast<const char *>(data), static_cast<qsizetype>(bytes));
+    m_offset += bytes;
+    return true;
+}
+
+/**
+ * @brief Hand the blocks built so far to the writer thread, which writes and flushes them.
+ *
+ * Offsets are assigned when the blocks are built, so the index never waits for the disk.
+ */
+void SessionRecorder::flushBuffer()
+{
+    if (m_buffer.isEmpty() || m_writeFailed.load())
+    {
+        return;
+    }
+
+    QByteArray buffer;
+    buffer.swap(m_buffer);
+    m_writer.start([this, buffer]() {
+        if (m_writeFailed.load())
+        {
+            return;
+        }
+        if (m_file.write(buffer) != buffer.size() || !m_file.flush())
+        {
+            qDebug() << "SessionRecorder: Write failed, recording stopped:" << m_file.errorString();
+            m_writeFailed = true;
+        }
+    });
+}
+
+bool SessionRecorder::writePadding()
+{
+    static const char zeros[8] = {0};
+    return writeRaw(zeros, padded(m_offset) - m_offset);
+}
+
+SessionRecordingReader::SessionRecordingReader()
+    : m_data(nullptr), m_size(0)
+{
+}
+
+SessionRecordingReader::~SessionRecordingReader()
+{
+    close();
+}
+
+/**
+ * @brief Map a recording and load its time index.
+ *
+ * Uses the index block written on close; a recording without one (cut short) is
+ * recovered by walking its blocks up to the last complete one.
+ *
+ * @param filePath Path of the recording
+ * @return true if the recording was opened
+ */
+bool SessionRecordingReader::open(const QString &filePath)
+{
+    close();
+
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly))
+    {
+        qDebug() << "SessionRecordingReader: Cannot open" << filePath << ":" << m_file.errorString();
+        return false;
+    }
+
+    m_size = static_cast<quint64>(m_file.size());
+    m_data = m_size > 0 ? m_file.map(0, m_file.size()) : nullptr;
+    if (!m_data)
+    {
+        qDebug() << "SessionRecordingReader: Cannot map" << filePath;
+        close();
+        return false;
+    }
+
+    FileHeader header;
+    if (!readStruct(m_data, m_size, 0, header) || std::memcmp(header.magic, kFileMagic, sizeof(header.magic)) != 0 ||
+        header.version != kFormatVersion)
+    {
+        qDebug() << "SessionRecordingReader: Not a session recording:" << filePath;
+        close();
+        return false;
+    }
+
+    if (!readIndex())
+    {
+        qDebug() << "SessionRecordingReader: No index in" << filePath << "- scanning blocks";
+        m_chunks.clear();
+        m_latestAnnotations.clear();
+        scanBlocks();
+    }
+
+    // Chunks of a series are recorded in time order; number their samples across chunks
+    for (auto &pair : m_chunks)
+    {
+        std::stable_sort(pair.second.begin(), pair.second.end(),
+                         [](const SessionRecordingChunk &a, const SessionRecordingChunk &b) { return a.firstMs < b.firstMs; });
+        size_t seriesIndex = 0;
+        for (SessionRecordingChunk &chunk : pair.second)
+        {
+            chunk.seriesIndex = seriesIndex;
+            seriesIndex += chunk.count;
+        }
+    }
+
+    qDebug() << "SessionRecordingReader: Opened" << filePath << "-" << m_chunks.size() << "series," << m_size << "bytes";
+    return true;
+}
+
+void SessionRecordingReader::close()
+{
+    if (m_data)
+    {
+        m_file.unmap(const_cast<uchar *>(m_data));
+        m_data = nullptr;
+    }
+    if (m_file.isOpen())
+    {
+        m_file.close();
+    }
+    m_size = 0;
+    m_chunks.clear();
+    m_latestAnnotations.clear();
+}
+
+/**
+ * @brief Load the chunk and annotation offsets from the index block named by the trailer.
+ *
+ * @return false if the trailer or index is missing or malformed
+ */
+bool SessionRecordingReader::readIndex()
+{
+    Trailer trailer;
+    if (m_size < sizeof(FileHeader) + sizeof(Trailer) || !readStruct(m_data, m_size, m_size - sizeof(Trailer), trailer) ||
+        std::memcmp(trailer.magic, kTrailerMagic, sizeof(trailer.magic)) != 0)
+    {
+        return false;
+    }
+
+    BlockHeader blockHeader;
+    if (!readStruct(m_data, m_size, trailer.indexOffset, blockHeader) || blockHeader.type != kIndexBlock)
+    {
+        return false;
+    }
+
+    quint64 offset = trailer.indexOffset + sizeof(BlockHeader);
+    quint64 chunkCount = 0;
+    if (!readStruct(m_data, m_size, offset, chunkCount))
+    {
+        return false;
+    }
+    offset += sizeof(chunkCount);
+
+    for (quint64 i = 0; i < chunkCount; ++i)
+    {
+        IndexChunkEntry entry;
+        if (!readStruct(m_data, m_size, offset, entry) || entry.labelBytes > m_size - offset - sizeof(entry))
+        {
+            return false;
+        }
+        offset += sizeof(entry);
+
+        // Column bounds are checked against the index position since chunks precede it
+        quint64 columnsOffset = entry.blockOffset + chunkColumnsOffset(entry.labelBytes);
+        if (columnsOffset > trailer.indexOffset || entry.count > (trailer.indexOffset - columnsOffset) / (sizeof(qint64) + sizeof(qreal)))
+        {
+            return false;
+        }
+
+        SessionRecordingChunk chunk;
+        chunk.graphType = static_cast<GraphType>(entry.graphType);
+        chunk.seriesLabel = QString::fromUtf8(reinterpret_cast<const char *>(m_data + offset), static_cast<int>(entry.labelBytes));
+        chunk.firstMs = entry.firstMs;
+        chunk.lastMs = entry.lastMs;
+        chunk.blockOffset = entry.blockOffset;
+        chunk.count = static_cast<size_t>(entry.count);
+        chunk.timestampsMs = reinterpret_cast<const qint64 *>(m_data + columnsOffset);
+        chunk.yData = reinterpret_cast<const qreal *>(m_data + columnsOffset + entry.count * sizeof(qint64));
+        m_chunks[std::make_pair(entry.graphType, chunk.seriesLabel)].push_back(chunk);
+        offset += padded(entry.labelBytes);
+    }
+
+    quint64 annotationCount = 0;
+    if (!readStruct(m_data, m_size, offset, annotationCount))
+    {
+        return false;
+    }
+    offset += sizeof(annotationCount);
+
+    for (quint64 i = 0; i < annotationCount; ++i)
+    {
+        IndexAnnotationEntry entry;
+        if (!readStruct(m_data, m_size, offset, entry))
+        {
+            return false;
+        }
+        offset += sizeof(entry);
+        m_latestAnnotations[entry.graphType] = entry.blockOffset; // Later snapshots replace earlier ones
+    }
+
+    return true;
+}
+
+/**
+ * @brief Rebuild the time index by walking every complete block of the file.
+ *
+ * @return true if at least one block was read
+ */
+bool SessionRecordingReader::scanBlocks()
+{
+    quint64 offset = sizeof(FileHeader);
+    bool found = false;
+
+    BlockHeader header;
+    while (readStruct(m_data, m_size, offset, header))
+    {
+        quint64 payloadOffset = offset + sizeof(BlockHeader);
+        if (header.payloadBytes > m_size - payloadOffset)
+        {
+            break; // Truncated block: the recording ends here
+        }
+
+        if (header.type == kSeriesBlock)
+        {
+            if (!addChunk(header.graphType, offset))
+            {
+                break;
+            }
+        }
+        else if (header.type == kAnnotationBlock)
+        {
+            m_latestAnnotations[header.graphType] = offset;
+        }
+
+        found = true;
+        offset = payloadOffset + padded(header.payloadBytes);
+    }
+
+    return found;
+}
+
+/**
+ * @brief Add the series chunk stored at a block offset to the time index.
+ *
+ * @param graphType Graph type from the block header
+ * @param blockOffset Offset of the block header
+ * @return false if the chunk does not fit in its block
+ */
+bool SessionRecordingReader::addChunk(qint32 graphType, quint64 blockOffset)
+{
+    BlockHeader blockHeader;
+    ChunkHeader chunkHeader;
+    if (!readStruct(m_data, m_size, blockOffset, blockHeader) ||
+        !readStruct(m_data, m_size, blockOffset + sizeof(BlockHeader), chunkHeader))
+    {
+        return false;
+    }
+
+    quint64 blockEnd = blockOffset + sizeof(BlockHeader) + blockHeader.payloadBytes;
+    quint64 columnsOffset = blockOffset + chunkColumnsOffset(chunkHeader.labelBytes);
+    if (columnsOffset > blockEnd || chunkHeader.count > (blockEnd - columnsOffset) / (sizeof(qint64) + sizeof(qreal)))
+    {
+        return false;
+    }
+
+    SessionRecordingChunk chunk;
+    chunk.graphType = static_cast<GraphType>(graphType);
+    chunk.seriesLabel = QString::fromUtf8(reinterpret_cast<const char *>(m_data + blockOffset + sizeof(BlockHeader) + sizeof(ChunkHeader)),
+                                          static_cast<int>(chunkHeader.labelBytes));
+    chunk.firstMs = chunkHeader.firstMs;
+    chunk.lastMs = chunkHeader.lastMs;
+    chunk.blockOffset = blockOffset;
+    chunk.count = static_cast<size_t>(chunkHeader.count);
+    chunk.timestampsMs = reinterpret_cast<const qint64 *>(m_data + columnsOffset);
+    chunk.yData = reinterpret_cast<const qreal *>(m_data + columnsOffset + chunkHeader.count * sizeof(qint64));
+    m_chunks[std::make_pair(graphType, chunk.seriesLabel)].push_back(chunk);
+    return true;
+}
+
+std::vector<GraphType> SessionRecordingReader::getGraphTypes() const
+{
+    std::vector<GraphType> graphTypes;
+    for (const auto &pair : m_chunks)
+    {
+        GraphType graphType = static_cast<GraphType>(pair.first.first);
+        if (std::find(graphTypes.begin(), graphTypes.end(), graphType) == graphTypes.end())
+        {
+            graphTypes.push_back(graphType);
+        }
+    }
+    for (const auto &pair : m_latestAnnotations)
+    {
+        GraphType graphType = static_cast<GraphType>(pair.first);
+        if (std::find(graphTypes.begin(), graphTypes.end(), graphType) == graphTypes.end())
+        {
+            graphTypes.push_back(graphType);
+        }
+    }
+    return graphTypes;
+}
+
+std::vector<QString> SessionRecordingReader::getSeriesLabels(const GraphType &graphType) const
+{
+    std::vector<QString> labels;
+    for (const auto &pair : m_chunks)
+    {
+        if (pair.first.first == static_cast<qint32>(graphType))
+        {
+            labels.push_back(pair.first.second);
+        }
+    }
+    return labels;
+}
+
+/**
+ * @brief Get the time span covered by all recorded series.
+ *
+ * @param startMs Receives the earliest sample time
+ * @param endMs Receives the latest sample time
+ * @return false if the recording holds no samples
+ */
+bool SessionRecordingReader::getTimeRangeMs(qint64 &startMs, qint64 &endMs) const
+{
+    bool found = false;
+    for (const auto &pair : m_chunks)
+    {
+        if (pair.second.empty())
+        {
+            continue;
+        }
+        qint64 first = pair.second.front().firstMs;
+        qint64 last = pair.second.back().lastMs;
+        startMs = found ? std::min(startMs, first) : first;
+        endMs = found ? std::max(endMs, last) : last;
+        found = true;
+    }
+    return found;
+}
+
+/**
+ * @brief Get zero-copy views of the samples of a series within a time range.
+ *
+ * Chunks are located through the time index by binary search, then trimmed by binary
+ * search on their timestamp columns. Views stay valid until the reader is closed.
+ *
+ * @param graphType Graph type
+ * @param seriesLabel Series label
+ * @param startMs Range start in milliseconds since epoch (inclusive)
+ * @param endMs Range end in milliseconds since epoch (inclusive)
+ * @return One view per chunk that overlaps the range, in time order
+ */
+std::vector<WaterfallSeriesView> SessionRecordingReader::getSeriesViews(const GraphType &graphType, const QString &seriesLabel,
+                                                                        qint64 startMs, qint64 endMs) const
+{
+    std::vector<WaterfallSeriesView> views;
+    auto it = m_chunks.find(std::make_pair(static_cast<qint32>(graphType), seriesLabel));
+    if (it == m_chunks.end() || startMs > endMs)
+    {
+        return views;
+    }
+
+    const std::vector<SessionRecordingChunk> &chunks = it->second;
+    auto chunkIt = std::lower_bound(chunks.begin(), chunks.end(), startMs,
+                                    [](const SessionRecordingChunk &chunk, qint64 ms) { return chunk.lastMs < ms; });
+    for (; chunkIt != chunks.end() && chunkIt->firstMs <= endMs; ++chunkIt)
+    {
+        const qint64 *begin = chunkIt->timestampsMs;
+        const qint64 *end = begin + chunkIt->count;
+        const qint64 *first = std::lower_bound(begin, end, startMs);
+        const qint64 *last = std::upper_bound(first, end, endMs);
+        if (first == last)
+        {
+            continue;
+        }
+
+        WaterfallSeriesView view;
+        view.timestampsMs = first;
+        view.yData = chunkIt->yData + (first - begin);
+        view.count = static_cast<size_t>(last - first);
+        view.firstIndex = chunkIt->seriesIndex + static_cast<size_t>(first - begin);
+        views.push_back(view);
+    }
+    return views;
+}
+
+/**
+ * @brief Replace the recorded series and annotations of a data source.
+ *
+ * Samples are bulk-appended straight from the mapped columns.
+ *
+ * @param graphType Graph type to load
+ * @param dataSource Data source receiving the recorded data
+ * @return false if the recording holds nothing for this graph type
+ */
+bool SessionRecordingReader::loadInto(const GraphType &graphType, WaterfallData &dataSource) const
+{
+    qint32 type = static_cast<qint32>(graphType);
+    bool found = false;
+
+    for (const auto &pair : m_chunks)
+    {
+        if (pair.first.first != type)
+        {
+            continue;
+        }
+
+        dataSource.clearDataSeries(pair.first.second);
+        for (const SessionRecordingChunk &chunk : pair.second)
+        {
+            dataSource.addDataPointsToSeries(pair.first.second, chunk.yData, chunk.timestampsMs, chunk.count);
+        }
+        found = true;
+    }
+
+    auto annotationIt = m_latestAnnotations.find(type);
+    if (annotationIt != m_latestAnnotations.end())
+    {
+        restoreAnnotations(annotationIt->second, dataSource);
+        found = true;
+    }
+
+    return found;
+}
+
+/**
+ * @brief Replace the symbols and markers of a data source with an annotation snapshot.
+ *
+ * @param blockOffset Offset of the annotation block
+ * @param dataSource Data source receiving the annotations
+ */
+void SessionRecordingReader::restoreAnnotations(quint64 blockOffset, WaterfallData &dataSource) const
+{
+    BlockHeader blockHeader;
+    quint64 recordCount = 0;
+    if (!readStruct(m_data, m_size, blockOffset, blockHeader) ||
+        !readStruct(m_data, m_size, blockOffset + sizeof(BlockHeader), recordCount))
+    {
+        return;
+    }
+
+    dataSource.clearRTWSymbols();
+    dataSource.clearBTWSymbols();
+    dataSource.clearBTWMarkers();
+    dataSource.clearRTWRMarkers();
+
+    quint64 offset = blockOffset + sizeof(BlockHeader) + sizeof(recordCount);
+    for (quint64 i = 0; i < recordCount; ++i)
+    {
+        AnnotationRecord record;
+        if (!readStruct(m_data, m_size, offset, record) || record.nameBytes > m_size - offset - sizeof(record))
+        {
+            qDebug() << "SessionRecordingReader: Truncated annotation block at" << blockOffset;
+            return;
+        }
+        offset += sizeof(record);
+
+        QString name = QString::fromUtf8(reinterpret_cast<const char *>(m_data + offset), static_cast<int>(record.nameBytes));
+        QDateTime timestamp = QDateTime::fromMSecsSinceEpoch(record.timestampMs);
+        offset += padded(record.nameBytes);
+
+        switch (record.kind)
+        {
+        case kRTWSymbol:
+            dataSource.addRTWSymbol(name, timestamp, record.range);
+            break;
+        case kBTWSymbol:
+            dataSource.addBTWSymbol(name, timestamp, record.range);
+            break;
+        case kBTWMarker:
+            dataSource.addBTWMarker(timestamp, record.range, record.delta);
+            break;
+        case kRTWRMarker:
+            dataSource.addRTWRMarker(timestamp, record.range);
+            break;
+        default:
+            break;
+        }
+    }
+}
@@ -0,0 +1,116 @@
+#ifndef SESSIONRECORDING_H
+#define SESSIONRECORDING_H
+
+#include "graphtype.h"
+#include "waterfalldata.h"
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QThreadPool>
+#include <QtGlobal>
+#include <atomic>
+#include <map>
+#include <utility>
+#include <vector>
+
+// Append-only binary recording of the data sources of a session.
+//
+// Layout (native byte order, every block starts on an 8-byte boundary):
+//   header   "WFSREC01", quint32 version, quint32 reserved
+//   block    quint32 type, qint32 graphType, quint64 payloadBytes, payload padded to 8 bytes
+//   trailer  quint64 indexOffset, "WFSRIDX1" (written by close())
+//
+// Series blocks hold one time-ordered chunk of a series as two columns (all timestamps,
+// then all values) that the reader exposes in place from the mapped file. Annotation blocks
+// hold a full snapshot of a graph type's symbols and markers; the latest one wins. The index
+// block lists every chunk with its time extents so a reopened recording needs no scan; a
+// recording cut short before close() has no trailer and is recovered by walking the blocks.
+
+// Time index entry for one chunk of a series
+struct SessionRecordingChunk
+{
+    GraphType graphType = GraphType::BDW;
+    QString seriesLabel;
+    qint64 firstMs = 0;
+    qint64 lastMs = 0;
+    quint64 blockOffset = 0;
+    size_t count = 0;
+    size_t seriesIndex = 0; // Index of the chunk's first sample within the whole series
+    const qint64 *timestampsMs = nullptr; // Points into the mapped file (reader only)
+    const qreal *yData = nullptr;
+};
+
+// Writes a recording incrementally: each recordDataSource() call appends only the samples
+// newer than the newest one already recorded for each series (late samples that land before
+// it are not recorded), plus an annotation snapshot when the annotations changed. Blocks are
+// built on the calling thread and written and flushed to disk by a single writer thread.
+class SessionRecorder
+{
+public:
+    SessionRecorder();
+    ~SessionRecorder();
+
+    bool open(const QString &filePath);
+    void close();
+    bool isOpen() const { return m_file.isOpen(); }
+
+    void recordDataSource(const GraphType &graphType, const WaterfallData &dataSource);
+
+    quint64 bytesWritten() const { return m_offset; } // Including bytes still queued for the writer
+
+private:
+    bool writeBlockHeader(quint32 type, qint32 graphType, quint64 payloadBytes);
+    bool writeRaw(const void *data, quint64 bytes);
+    bool writePadding();
+    void flushBuffer();
+    void recordAnnotations(const GraphType &graphType, const WaterfallData &dataSource);
+
+    QFile m_file;
+    quint64 m_offset;
+    QByteArray m_buffer;                // Blocks built since the last flushBuffer()
+    QThreadPool m_writer;               // One thread, so buffers reach the file in order
+    std::atomic<bool> m_writeFailed;    // Set by the writer thread; no further blocks are queued
+    std::vector<SessionRecordingChunk> m_index;
+    std::vector<std::pair<qint32, quint64>> m_annotationIndex; // Graph type, block offset
+    std::map<std::pair<qint32, QString>, qint64> m_lastRecordedMs;
+    std::map<qint32, quint64> m_annotationRevisions; // Annotation revision of the last snapshot
+};
+
+// Opens a recording by memory-mapping it; series data is read in place, never copied
+class SessionRecordingReader
+{
+public:
+    SessionRecordingReader();
+    ~SessionRecordingReader();
+
+    bool open(const QString &filePath);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+
+    std::vector<GraphType> getGraphTypes() const;
+    std::vector<QString> getSeriesLabels(const GraphType &graphType) const;
+    bool getTimeRangeMs(qint64 &startMs, qint64 &endMs) const;
+
+    // Zero-copy views of the samples of a series within [startMs, endMs], one per chunk
+    std::vector<WaterfallSeriesView> getSeriesViews(const GraphType &graphType, const QString &seriesLabel,
+                                                    qint64 startMs, qint64 endMs) const;
+
+    // Replace the series and annotations of a data source with the recorded ones
+    bool loadInto(const GraphType &graphType, WaterfallData &dataSource) const;
+
+private:
+    bool readIndex();
+    bool scanBlocks();
+    bool addChunk(qint32 graphType, quint64 blockOffset);
+    void restoreAnnotations(quint64 blockOffset, WaterfallData &dataSource) const;
+
+    QFile m_file;
+    const uchar *m_data;
+    quint64 m_size;
+
+    // Chunks per series in time order, the time index used by range queries
+    std::map<std::pair<qint32, QString>, std::vector<SessionRecordingChunk>> m_chunks;
+    std::map<qint32, quint64> m_latestAnnotations; // Graph type to annotation block offset
+};
+
+#endif // SESSIONRECORDING_H
@@ -15,7 +15,10 @@ public:
           hasInterval(false), 
           hasTimeScope(false), 
           hasCursorTime(false), 
+          cursorRevision(0),
           hasCurrentNavTime(false),
+          replayClockMs(0),
+          hasReplayClock(false),
           isGraphContainerInFollowMode(true),
           hasManoeuvres(false)
     {
@@ -29,14 +32,49 @@ public:
     TimeSelectionSpan currentTimeScope;
     bool hasTimeScope;
 
-    // Cursor time synchronization
+    // Cursor time synchronization; the setters bump cursorRevision so that the
+    // cursor layers of the graphs only repaint after an actual change
     QDateTime cursorTime;
     bool hasCursorTime;
+    quint64 cursorRevision;
+
+    void setCursorTime(const QDateTime &time)
+    {
+        if (!time.isValid())
+        {
+            clearCursorTime();
+            return;
+        }
+        if (!hasCursorTime || cursorTime != time)
+        {
+            cursorTime = time;
+            hasCursorTime = true;
+            ++cursorRevision;
+        }
+    }
+
+    void clearCursorTime()
+    {
+        if (hasCursorTime)
+        {
+            hasCursorTime = false;
+            ++cursorRevision;
+        }
+    }
 
     // Current navtime synchronization
     QDateTime currentNavTime;
     bool hasCurrentNavTime;
 
+    // Replay clock; while set it replaces the wall clock as the current time of the containers
+    qint64 replayClockMs;
+    bool hasReplayClock;
+
+    QDateTime currentClockTime() const
+    {
+        return hasReplayClock ? QDateTime::fromMSecsSinceEpoch(replayClockMs) : QDateTime::currentDateTime();
+    }
+
     // Graph Container data follower synchronization
     bool isGraphContainerInFollowMode = true;
 
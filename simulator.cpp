@@ -10,6 +10,7 @@ Simulator::Simulator(QObject *parent, QTimer *timer, GraphLayout *graphLayout)
     // Initialize configurations and current values
     initializeConfigurations();
     initializeCurrentValues();
+    initializeSeries();
 
     // Connect timer to our tick handler
     if (m_timer)
@@ -140,24 +141,13 @@ void Simulator::addDataPoints()
         return;
     }
 
-    QDateTime currentTime = QDateTime::currentDateTime();
-
-    // Add new data points to each graph data source with precise timestamping
-    m_graphLayout->addDataPointToDataSource(GraphType::FDW, "FDW-1", m_currentFDWValue, currentTime);
-    m_graphLayout->addDataPointToDataSource(GraphType::FDW, "FDW-2", m_currentFDWValue + 10, currentTime);
-    m_graphLayout->addDataPointToDataSource(GraphType::BDW, "BDW-1", m_currentBDWValue, currentTime);
-    m_graphLayout->addDataPointToDataSource(GraphType::BDW, "BDW-2", m_currentBDWValue + 10, currentTime);
-    m_graphLayout->addDataPointToDataSource(GraphType::BRW, "BRW-1", m_currentBRWValue, currentTime);
-    m_graphLayout->addDataPointToDataSource(GraphType::BRW, "BRW-2", m_currentBRWValue + 10, currentTime);
-    m_graphLayout->addDataPointToDataSource(GraphType::LTW, "LTW-1", m_currentLTWValue, currentTime);
-    m_graphLayout->addDataPointToDataSource(GraphType::LTW, "LTW-2", m_currentLTWValue + 10, currentTime);
-    m_graphLayout->addDataPointToDataSource(GraphType::BTW, "BTW-1", m_currentBTWValue, currentTime);
-    m_graphLayout->addDataPointToDataSource(GraphType::BTW, "BTW-2", m_currentBTWValue + 10, currentTime);
-    m_graphLayout->addDataPointToDataSource(GraphType::BTW, "BTW-3", m_currentBTWValue + 10, currentTime);
-    m_graphLayout->addDataPointToDataSource(GraphType::RTW, "RTW-1", m_currentRTWValue, currentTime);
-    m_graphLayout->addDataPointToDataSource(GraphType::RTW, "ADOPTED", m_currentRTWValue + 10, currentTime);
-    m_graphLayout->addDataPointToDataSource(GraphType::FTW, "FTW-1", m_currentFTWValue, currentTime);
-    m_graphLayout->addDataPointToDataSource(GraphType::FTW, "FTW-2", m_currentFTWValue + 10, currentTime);
+    const qint64 currentTimeMs = QDateTime::currentMSecsSinceEpoch();
+
+    // Queue new data points by series ID; the layout applies them on its next frame
+    for (const SimulatedSeries &series : m_series)
+    {
+        m_graphLayout->enqueueDataPoint(series.graphType, series.seriesId, *series.value + series.offset, currentTimeMs);
+    }
 
     qDebug() << "Added data points - FDW:" << m_currentFDWValue
              << "BDW:" << m_currentBDWValue
@@ -295,3 +285,27 @@ void Simulator::initializeCurrentValues()
     m_currentRTWValue = m_rtwConfig.startValue; // Middle of 0.0-25.0 range
     m_currentFTWValue = m_ftwConfig.startValue; // Middle of 15.0-30.0 range
 }
+
+void Simulator::initializeSeries()
+{
+    // Labels are interned here, not per sample, to keep the registry lock off the tick path
+    auto add = [this](GraphType graphType, const QString &label, const qreal *value, qreal offset)
+    {
+        m_series.push_back(SimulatedSeries{graphType, SeriesRegistry::intern(label), value, offset});
+    };
+    add(GraphType::FDW, "FDW-1", &m_currentFDWValue, 0.0);
+    add(GraphType::FDW, "FDW-2", &m_currentFDWValue, 10.0);
+    add(GraphType::BDW, "BDW-1", &m_currentBDWValue, 0.0);
+    add(GraphType::BDW, "BDW-2", &m_currentBDWValue, 10.0);
+    add(GraphType::BRW, "BRW-1", &m_currentBRWValue, 0.0);
+    add(GraphType::BRW, "BRW-2", &m_currentBRWValue, 10.0);
+    add(GraphType::LTW, "LTW-1", &m_currentLTWValue, 0.0);
+    add(GraphType::LTW, "LTW-2", &m_currentLTWValue, 10.0);
+    add(GraphType::BTW, "BTW-1", &m_currentBTWValue, 0.0);
+    add(GraphType::BTW, "BTW-2", &m_currentBTWValue, 10.0);
+    add(GraphType::BTW, "BTW-3", &m_currentBTWValue, 10.0);
+    add(GraphType::RTW, "RTW-1", &m_currentRTWValue, 0.0);
+    add(GraphType::RTW, "ADOPTED", &m_currentRTWValue, 10.0);
+    add(GraphType::FTW, "FTW-1", &m_currentFTWValue, 0.0);
+    add(GraphType::FTW, "FTW-2", &m_currentFTWValue, 10.0);
+}
@@ -27,6 +27,18 @@ struct SimulatorConfig
     qreal deltaValue;         ///< Delta value
 };
 
+/**
+ * @brief A simulated series, with its label interned once
+ * 
+ */
+struct SimulatedSeries
+{
+    GraphType graphType;      ///< Graph type whose data source receives the samples
+    int seriesId;             ///< Interned series ID
+    const qreal *value;       ///< Current value the samples follow
+    qreal offset;             ///< Offset added to the current value
+};
+
 
 /**
  * @brief The Simulator class handles the simulation of data for all graph types
@@ -136,6 +148,8 @@ private:
     SimulatorConfig m_rtwConfig;            ///< RTW configuration
     SimulatorConfig m_ftwConfig;            ///< FTW configuration
 
+    std::vector<SimulatedSeries> m_series;  ///< Series fed on every tick
+
     /**
      * @brief Initialize default configurations for all graph types
      */
@@ -145,6 +159,11 @@ private:
      * @brief Initialize current values for all graph types
      */
     void initializeCurrentValues();
+
+    /**
+     * @brief Intern the simulated series labels once
+     */
+    void initializeSeries();
 };
 
 #endif // SIMULATOR_H
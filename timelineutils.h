@@ -64,6 +64,12 @@ inline QTime timeIntervalToQTime(TimeInterval interval)
     return QTime(hours, minutes, 0);
 }
 
+// Utility function to convert TimeInterval enum to milliseconds
+inline qint64 timeIntervalToMs(TimeInterval interval)
+{
+    return static_cast<qint64>(interval) * 60 * 1000;
+}
+
 // Utility function to get display name for TimeInterval
 inline QString timeIntervalToString(TimeInterval interval)
 {
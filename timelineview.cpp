@@ -1,4 +1,5 @@
 #include "timelineview.h"
+#include "perfcounters.h"
 #include "navtimeutils.h"
 #include <QBrush>
 #include <QDebug>
@@ -654,6 +655,7 @@ QString TimelineView::getChevronLabel3() const
 
 void TimelineVisualizerWidget::paintEvent(QPaintEvent * /* event */)
 {
+    PERF_SCOPE("TimelineVisualizerWidget::paintEvent");
     QPainter painter(this);
     painter.setRenderHint(QPainter::Antialiasing);
 
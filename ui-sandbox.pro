@@ -1,4 +1,4 @@
-QT       += core gui
+QT       += core gui concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -20,9 +20,17 @@ DEFINES += QT_DEPRECATED_WARNINGS
 # In order to do so, uncomment the following line.
 # You can also select to disable deprecated APIs only up to a certain version of Qt.
 
+# Hot-path timing counters (see perfcounters.h); they compile to nothing unless enabled.
+# DEFINES += ENABLE_PERF_COUNTERS
+
+# Compile-time log level for the per-tick logging categories (see uilogging.h):
+# 0 = none, 1 = warnings, 2 = info, 3 = debug. Defaults to 1 in release and 3 in debug builds.
+# DEFINES += UI_LOG_LEVEL=1
+
 SOURCES += \
     graphcontainer.cpp \
     graphlayout.cpp \
+    ingestqueue.cpp \
     graphtype.cpp \
     main.cpp \
     mainwindow.cpp \
@@ -33,6 +41,7 @@ SOURCES += \
     twoaxisdata.cpp \
     twoaxisgraph.cpp \
     waterfalldata.cpp \
+    rangeminmaxtree.cpp \
     waterfallgraph.cpp \
     drawutils.cpp \
     zoompanel.cpp \
@@ -47,6 +56,17 @@ SOURCES += \
     btwsymboldrawing.cpp \
     simulator.cpp \
     interactivegraphicsitem.cpp \
+    scatterplotitem.cpp \
+    seriespathdecimator.cpp \
+    screentransform.cpp \
+    seriesrasterizer.cpp \
+    intensitycolormap.cpp \
+    cursorframescheduler.cpp \
+    sessionrecording.cpp \
+    replayengine.cpp \
+    perfcounters.cpp \
+    uilogging.cpp \
+    seriesregistry.cpp \
     btwinteractiveoverlay.cpp \
     navtimeutils.cpp \
     scwwindow.cpp \
@@ -56,6 +76,7 @@ SOURCES += \
 HEADERS += \
     graphcontainer.h \
     graphlayout.h \
+    ingestqueue.h \
     graphtype.h \
     mainwindow.h \
     tacticalsolutionview.h \
@@ -65,6 +86,7 @@ HEADERS += \
     twoaxisdata.h \
     twoaxisgraph.h \
     waterfalldata.h \
+    rangeminmaxtree.h \
     waterfallgraph.h \
     drawutils.h \
     zoompanel.h\
@@ -79,6 +101,17 @@ HEADERS += \
     btwsymboldrawing.h \
     simulator.h \
     interactivegraphicsitem.h \
+    scatterplotitem.h \
+    seriespathdecimator.h \
+    screentransform.h \
+    seriesrasterizer.h \
+    intensitycolormap.h \
+    cursorframescheduler.h \
+    sessionrecording.h \
+    replayengine.h \
+    perfcounters.h \
+    uilogging.h \
+    seriesregistry.h \
     btwinteractiveoverlay.h \
     navtimeutils.h  \
     scwwindow.h \
@@ -0,0 +1,6 @@
+#include "uilogging.h"
+
+// Per-tick categories only emit warnings and above unless enabled by logging rules
+Q_LOGGING_CATEGORY(lcWaterfallData, "cppui.waterfall.data", QtWarningMsg)
+Q_LOGGING_CATEGORY(lcWaterfallDraw, "cppui.waterfall.draw", QtWarningMsg)
+Q_LOGGING_CATEGORY(lcGraphContainer, "cppui.container", QtWarningMsg)
@@ -0,0 +1,47 @@
+#ifndef UILOGGING_H
+#define UILOGGING_H
+
+#include <QDebug>
+#include <QLoggingCategory>
+
+// Logging categories for the per-tick paths (ingest, container updates, drawing).
+//
+// They are quiet by default and can be switched on at runtime for field diagnosis, e.g.
+//   QT_LOGGING_RULES="cppui.waterfall.draw.debug=true"
+// or QLoggingCategory::setFilterRules(). qCDebug-style macros skip formatting entirely
+// while a category is disabled.
+//
+// UI_LOG_LEVEL removes messages at compile time: 0 = none, 1 = warnings, 2 = info,
+// 3 = debug. Release builds (QT_NO_DEBUG) default to warnings only, so their hot paths
+// contain no formatting or stream work at all.
+Q_DECLARE_LOGGING_CATEGORY(lcWaterfallData)  // cppui.waterfall.data: sample ingest into data sources
+Q_DECLARE_LOGGING_CATEGORY(lcWaterfallDraw)  // cppui.waterfall.draw: graph drawing and range updates
+Q_DECLARE_LOGGING_CATEGORY(lcGraphContainer) // cppui.container: per-tick container updates
+
+#ifndef UI_LOG_LEVEL
+#ifdef QT_NO_DEBUG
+#define UI_LOG_LEVEL 1
+#else
+#define UI_LOG_LEVEL 3
+#endif
+#endif
+
+#if UI_LOG_LEVEL >= 3
+#define UI_DEBUG(category) qCDebug(category)
+#else
+#define UI_DEBUG(category) while (false) QMessageLogger().noDebug()
+#endif
+
+#if UI_LOG_LEVEL >= 2
+#define UI_INFO(category) qCInfo(category)
+#else
+#define UI_INFO(category) while (false) QMessageLogger().noDebug()
+#endif
+
+#if UI_LOG_LEVEL >= 1
+#define UI_WARNING(category) qCWarning(category)
+#else
+#define UI_WARNING(category) while (false) QMessageLogger().noDebug()
+#endif
+
+#endif // UILOGGING_H
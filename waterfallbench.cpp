@@ -0,0 +1,372 @@
+#include "bdwgraph.h"
+#include "brwgraph.h"
+#include "btwgraph.h"
+#include "fdwgraph.h"
+#include "ftwgraph.h"
+#include "graphlayout.h"
+#include "ltwgraph.h"
+#include "rtwgraph.h"
+#include "simulator.h"
+#include "waterfalldata.h"
+#include "waterfallgraph.h"
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QTextStream>
+#include <QTimer>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+/**
+ * @brief Headless benchmark for the waterfall rendering pipeline
+ *
+ * For each requested size, fills every graph type with synthetic series generated by
+ * Simulator::generateBulkData and reports ingest, updateDataRanges(), draw() and
+ * drawIncremental() timings, scene item counts and peak RSS. A GraphLayout is then filled
+ * and redrawn the same way to cover GraphContainer and GraphLayout.
+ */
+
+namespace
+{
+const int kSeriesCount = 2;
+const int kGraphWidth = 800;
+const int kGraphHeight = 600;
+const int kIncrementalAppends = 100;
+const qint64 kMinMeasureNs = 200 * 1000 * 1000; // Repeat short measurements for at least 200 ms
+
+bool g_verbose = false;
+
+void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    Q_UNUSED(context);
+    if (g_verbose || type != QtDebugMsg)
+    {
+        QTextStream(stderr) << message << "\n";
+    }
+}
+
+/**
+ * @brief Peak resident set size of the process in MiB
+ */
+double peakRssMiB()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+    }
+    return 0.0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0.0;
+    }
+#if defined(Q_OS_MACOS)
+    return usage.ru_maxrss / (1024.0 * 1024.0); // Bytes on macOS
+#else
+    return usage.ru_maxrss / 1024.0; // KiB on Linux
+#endif
+#endif
+}
+
+/**
+ * @brief Median wall time of an operation in milliseconds, repeated until enough time was spent
+ */
+double measureMs(const std::function<void()> &operation)
+{
+    std::vector<double> samples;
+    QElapsedTimer total;
+    total.start();
+    do
+    {
+        QElapsedTimer timer;
+        timer.start();
+        operation();
+        samples.push_back(timer.nsecsElapsed() / 1e6);
+    } while (total.nsecsElapsed() < kMinMeasureNs && samples.size() < 50);
+
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+std::vector<QString> seriesLabels()
+{
+    std::vector<QString> labels;
+    for (int i = 0; i < kSeriesCount; ++i)
+    {
+        labels.push_back(QString("Series-%1").arg(i + 1));
+    }
+    return labels;
+}
+
+// Exposes the protected pipeline stages of a graph type to the benchmark
+template <typename Graph>
+class BenchGraph : public Graph
+{
+public:
+    BenchGraph() : Graph(nullptr, true, 10, TimeInterval::TwelveHours) {}
+
+    using Graph::drawIncremental;
+    using Graph::markRangeUpdateNeeded;
+    using Graph::markSeriesDirty;
+    using Graph::updateDataRanges;
+
+    int sceneItemCount() const { return this->graphicsScene ? static_cast<int>(this->graphicsScene->items().size()) : 0; }
+};
+
+struct GraphCase
+{
+    const char *name;
+    GraphType graphType;
+    std::function<WaterfallGraph *()> create;
+    std::function<void(WaterfallGraph *)> updateDataRanges;
+    std::function<void(WaterfallGraph *, int)> drawIncremental;
+    std::function<int(WaterfallGraph *)> sceneItemCount;
+};
+
+template <typename Graph>
+GraphCase makeCase(const char *name, GraphType graphType)
+{
+    GraphCase graphCase;
+    graphCase.name = name;
+    graphCase.graphType = graphType;
+    graphCase.create = []() -> WaterfallGraph * { return new BenchGraph<Graph>(); };
+    graphCase.updateDataRanges = [](WaterfallGraph *graph) { static_cast<BenchGraph<Graph> *>(graph)->updateDataRanges(); };
+    graphCase.drawIncremental = [](WaterfallGraph *graph, int seriesId) {
+        BenchGraph<Graph> *bench = static_cast<BenchGraph<Graph> *>(graph);
+        bench->markSeriesDirty(seriesId);
+        bench->markRangeUpdateNeeded();
+        bench->drawIncremental();
+    };
+    graphCase.sceneItemCount = [](WaterfallGraph *graph) { return static_cast<BenchGraph<Graph> *>(graph)->sceneItemCount(); };
+    return graphCase;
+}
+
+SimulatorConfig configFor(GraphType graphType)
+{
+    // Same ranges the sandbox uses for its bulk data
+    switch (graphType)
+    {
+    case GraphType::BDW:
+        return SimulatorConfig{-30.0, 30.0, 0.0, 6.0};
+    case GraphType::BTW:
+        return SimulatorConfig{5.0, 40.0, 22.5, 3.5};
+    case GraphType::RTW:
+        return SimulatorConfig{0.0, 25.0, 12.5, 2.5};
+    case GraphType::LTW:
+    case GraphType::FTW:
+        return SimulatorConfig{15.0, 30.0, 22.5, 1.5};
+    default:
+        return SimulatorConfig{8.0, 30.0, 19.0, 2.2};
+    }
+}
+
+/**
+ * @brief Benchmark one graph type with the given number of points per series
+ */
+void benchmarkGraph(QTextStream &out, const GraphCase &graphCase, int points)
+{
+    WaterfallData data(graphCase.name, seriesLabels());
+
+    QElapsedTimer timer;
+    timer.start();
+    Simulator::generateBulkData(&data, configFor(graphCase.graphType), points);
+    double generateMs = timer.nsecsElapsed() / 1e6;
+
+    // Bulk epoch-ms ingest of the same columns into a fresh data source
+    std::vector<std::vector<qreal>> yColumns;
+    std::vector<std::vector<qint64>> tColumns;
+    for (const QString &label : seriesLabels())
+    {
+        yColumns.push_back(data.getYDataSeries(label));
+        tColumns.push_back(data.getTimestampsMsSeries(label));
+    }
+    WaterfallData bulk(graphCase.name, seriesLabels());
+    timer.restart();
+    for (size_t i = 0; i < yColumns.size(); ++i)
+    {
+        bulk.addDataPointsToSeries(seriesLabels()[i], yColumns[i].data(), tColumns[i].data(), yColumns[i].size());
+    }
+    double ingestMs = timer.nsecsElapsed() / 1e6;
+    yColumns.clear();
+    tColumns.clear();
+
+    std::unique_ptr<WaterfallGraph> graph(graphCase.create());
+    graph->resize(kGraphWidth, kGraphHeight);
+    graph->show();
+    graph->setDataSource(data);
+
+    QDateTime latest = data.getLatestTime();
+    QDateTime earliest = data.getEarliestTime();
+    struct Window
+    {
+        const char *name;
+        QDateTime start;
+    };
+    const Window windows[] = {{"12h", latest.addMSecs(-timeIntervalToMs(TimeInterval::TwelveHours))}, {"all", earliest}};
+
+    for (const Window &window : windows)
+    {
+        graph->setTimeRange(std::max(window.start, earliest), latest);
+        QCoreApplication::processEvents();
+
+        double rangesMs = measureMs([&]() { graphCase.updateDataRanges(graph.get()); });
+        double drawMs = measureMs([&]() { graph->draw(); });
+        int items = graphCase.sceneItemCount(graph.get());
+
+        // Append samples past the newest one, each followed by an incremental draw
+        const int seriesId = SeriesRegistry::intern(seriesLabels().front());
+        qint64 nextMs = data.getLatestTime().toMSecsSinceEpoch();
+        timer.restart();
+        for (int i = 0; i < kIncrementalAppends; ++i)
+        {
+            nextMs += 10;
+            data.addDataPointToSeries(seriesId, 0.0, nextMs);
+            graphCase.drawIncremental(graph.get(), seriesId);
+        }
+        double incrementalMs = timer.nsecsElapsed() / 1e6 / kIncrementalAppends;
+
+        out << QString("%1 %2 %3 %4 %5 %6 %7 %8 %9 %10\n")
+                   .arg(graphCase.name, -5)
+                   .arg(points, 10)
+                   .arg(window.name, 5)
+                   .arg(generateMs, 12, 'f', 2)
+                   .arg(ingestMs, 10, 'f', 2)
+                   .arg(rangesMs, 10, 'f', 3)
+                   .arg(drawMs, 10, 'f', 3)
+                   .arg(incrementalMs, 12, 'f', 3)
+                   .arg(items, 7)
+                   .arg(peakRssMiB(), 10, 'f', 1);
+        out.flush();
+    }
+}
+
+/**
+ * @brief Benchmark a single-window GraphLayout (GraphLayout, GraphContainer and all graph types)
+ */
+void benchmarkLayout(QTextStream &out, int points)
+{
+    std::map<GraphType, std::vector<QPair<QString, QColor>>> labelsMap;
+    for (GraphType graphType : getAllGraphTypes())
+    {
+        for (const QString &label : seriesLabels())
+        {
+            labelsMap[graphType].push_back(qMakePair(label, QColor(Qt::green)));
+        }
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    GraphLayout layout(nullptr, LayoutType::GPW1W, nullptr, labelsMap);
+    layout.resize(kGraphWidth * 2, kGraphHeight * 2);
+    layout.show();
+    QCoreApplication::processEvents();
+    double constructMs = timer.nsecsElapsed() / 1e6;
+
+    timer.restart();
+    for (GraphType graphType : getAllGraphTypes())
+    {
+        Simulator::generateBulkData(layout.getDataSource(graphType), configFor(graphType), points);
+    }
+    double generateMs = timer.nsecsElapsed() / 1e6;
+
+    double redrawMs = measureMs([&]() { layout.redrawAllGraphs(); });
+
+    // Per-sample enqueues by series ID across every graph type, applied and delivered by one frame
+    const int seriesId = SeriesRegistry::intern(seriesLabels().front());
+    timer.restart();
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    for (int i = 0; i < kIncrementalAppends; ++i)
+    {
+        for (GraphType graphType : getAllGraphTypes())
+        {
+            layout.enqueueDataPoint(graphType, seriesId, 0.0, nowMs + i);
+        }
+    }
+    layout.onFrameTick();
+    double addFlushMs = timer.nsecsElapsed() / 1e6;
+
+    out << QString("layout %1 construct %2 ms, generate %3 ms, redrawAll %4 ms, %5 enqueues+frame %6 ms, peak RSS %7 MiB\n")
+               .arg(points)
+               .arg(constructMs, 0, 'f', 2)
+               .arg(generateMs, 0, 'f', 2)
+               .arg(redrawMs, 0, 'f', 3)
+               .arg(kIncrementalAppends * static_cast<int>(getAllGraphTypes().size()))
+               .arg(addFlushMs, 0, 'f', 2)
+               .arg(peakRssMiB(), 0, 'f', 1);
+    out.flush();
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    qInstallMessageHandler(messageHandler);
+
+    QApplication app(argc, argv);
+
+    std::vector<int> sizes;
+    const QStringList arguments = QCoreApplication::arguments();
+    for (int i = 1; i < arguments.size(); ++i)
+    {
+        bool ok = false;
+        int points = arguments[i].toInt(&ok);
+        if (arguments[i] == "--verbose")
+        {
+            g_verbose = true;
+        }
+        else if (ok && points > 0)
+        {
+            sizes.push_back(points);
+        }
+        else
+        {
+            QTextStream(stderr) << "usage: waterfallbench [--verbose] [points ...]\n";
+            return 1;
+        }
+    }
+    if (sizes.empty())
+    {
+        sizes = {10000, 100000, 1000000, 10000000};
+    }
+
+    std::vector<GraphCase> cases = {
+        makeCase<BDWGraph>("BDW", GraphType::BDW),
+        makeCase<BRWGraph>("BRW", GraphType::BRW),
+        makeCase<BTWGraph>("BTW", GraphType::BTW),
+        makeCase<FDWGraph>("FDW", GraphType::FDW),
+        makeCase<FTWGraph>("FTW", GraphType::FTW),
+        makeCase<LTWGraph>("LTW", GraphType::LTW),
+        makeCase<RTWGraph>("RTW", GraphType::RTW),
+    };
+
+    QTextStream out(stdout);
+    out << QString("%1 %2 %3 %4 %5 %6 %7 %8 %9 %10\n")
+               .arg("graph", -5).arg("points", 10).arg("view", 5).arg("generate_ms", 12).arg("ingest_ms", 10)
+               .arg("ranges_ms", 10).arg("draw_ms", 10).arg("incr_ms", 12).arg("items", 7).arg("rss_mib", 10);
+
+    for (int points : sizes)
+    {
+        for (const GraphCase &graphCase : cases)
+        {
+            benchmarkGraph(out, graphCase, points);
+        }
+        benchmarkLayout(out, points);
+    }
+
+    return 0;
+}
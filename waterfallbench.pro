@@ -0,0 +1,25 @@
+# Headless benchmark for the waterfall rendering pipeline
+#
+# Builds every library source of ui-sandbox.pro plus waterfallbench.cpp instead of the
+# sandbox main window, so new sources added to ui-sandbox.pro are picked up automatically.
+#
+#   qmake waterfallbench.pro && make
+#   ./waterfallbench [--verbose] [points ...]     (defaults to 10k 100k 1M 10M points)
+#
+# The benchmark forces QT_QPA_PLATFORM=offscreen unless a platform is set explicitly.
+
+TARGET = waterfallbench
+
+include(ui-sandbox.pro)
+
+CONFIG += console
+CONFIG -= app_bundle
+
+SOURCES -= main.cpp mainwindow.cpp
+HEADERS -= mainwindow.h
+FORMS -= mainwindow.ui
+
+SOURCES += waterfallbench.cpp
+
+# Peak working set size
+win32: LIBS += -lpsapi
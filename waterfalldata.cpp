@@ -1,34 +1,347 @@
 #include "waterfalldata.h"
 #include <algorithm>
 #include <limits>
+#include <numeric>
 #include <QStringList>
 
+namespace
+{
+    // Convert QDateTime values into the epoch-millisecond column representation
+    std::vector<qint64> toEpochMs(const std::vector<QDateTime>& timestamps)
+    {
+        std::vector<qint64> result;
+        result.reserve(timestamps.size());
+        for (const QDateTime& t : timestamps) {
+            result.push_back(t.toMSecsSinceEpoch());
+        }
+        return result;
+    }
+
+    // Convert epoch-millisecond timestamps back into QDateTime values (API edge only)
+    std::vector<QDateTime> fromEpochMs(const qint64* timestampsMs, size_t count)
+    {
+        std::vector<QDateTime> result;
+        result.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            result.push_back(QDateTime::fromMSecsSinceEpoch(timestampsMs[i]));
+        }
+        return result;
+    }
+
+    // Start of the bucket of the given size containing the timestamp (floor, also for pre-epoch times)
+    qint64 alignToBucket(qint64 timestampMs, qint64 bucketMs)
+    {
+        qint64 remainder = timestampMs % bucketMs;
+        if (remainder < 0) {
+            remainder += bucketMs;
+        }
+        return timestampMs - remainder;
+    }
+}
+
+// WaterfallLodBucket implementation
+
+void WaterfallLodBucket::add(qint64 timestampMs, qreal value)
+{
+    if (count == 0) {
+        firstMs = minMs = maxMs = timestampMs;
+        first = min = max = value;
+    }
+    else {
+        if (value < min) {
+            min = value;
+            minMs = timestampMs;
+        }
+        if (value > max) {
+            max = value;
+            maxMs = timestampMs;
+        }
+    }
+    lastMs = timestampMs;
+    last = value;
+    ++count;
+}
+
+// WaterfallSeriesColumns implementation
+
+WaterfallSeriesView WaterfallSeriesColumns::view() const
+{
+    WaterfallSeriesView result;
+    if (empty()) {
+        return result;
+    }
+    result.timestampsMs = timestampsMs.data() + head;
+    result.yData = yData.data() + head;
+    result.count = size();
+    return result;
+}
+
+void WaterfallSeriesColumns::dropFront(size_t count)
+{
+    count = std::min(count, size());
+
+    // Evicting a sample equal to a running extent means the extent must be recomputed
+    if (yExtentsValid) {
+        for (size_t i = head; i < head + count; ++i) {
+            if (yData[i] <= yMinCached || yData[i] >= yMaxCached) {
+                yExtentsValid = false;
+                break;
+            }
+        }
+    }
+
+    head += count;
+
+    // Drop pyramid buckets that only held evicted samples; the bucket holding the last
+    // evicted sample is flagged so refreshLod() re-aggregates it from the live samples
+    if (lodValid && count > 0) {
+        if (empty()) {
+            lodValid = false;
+        }
+        else {
+            qint64 firstLiveMs = timestampsMs[head];
+            qint64 lastEvictedMs = timestampsMs[head - 1];
+            for (WaterfallLodLevel& level : lodLevels) {
+                while (level.head < level.buckets.size() && level.buckets[level.head].lastMs < firstLiveMs) {
+                    ++level.head;
+                    level.frontStale = false;
+                }
+                if (level.head < level.buckets.size() && level.buckets[level.head].startMs <= lastEvictedMs) {
+                    level.frontStale = true;
+                }
+                if (level.head > 0 && level.head >= level.buckets.size() - level.head) {
+                    level.buckets.erase(level.buckets.begin(), level.buckets.begin() + level.head);
+                    level.head = 0;
+                }
+            }
+        }
+    }
+
+    // Compact once the evicted prefix is at least as large as the live window.
+    // Each sample is moved at most once per eviction, so dropping stays amortized O(1).
+    if (head > 0 && head >= size()) {
+        compact();
+    }
+}
+
+void WaterfallSeriesColumns::compact()
+{
+    if (head == 0) {
+        return;
+    }
+    timestampsMs.erase(timestampsMs.begin(), timestampsMs.begin() + head);
+    yData.erase(yData.begin(), yData.begin() + head);
+    lodFoldedEnd = lodFoldedEnd > head ? lodFoldedEnd - head : 0;
+    head = 0;
+    yTreeValid = false;
+}
+
+void WaterfallSeriesColumns::clear()
+{
+    timestampsMs.clear();
+    yData.clear();
+    head = 0;
+    yExtentsValid = false;
+    yTreeValid = false;
+    yTree.clear();
+    lodValid = false;
+    lodLevels.clear();
+    lodFoldedEnd = 0;
+}
+
+size_t WaterfallIntensitySeries::upperBound(qint64 timestampMs) const
+{
+    size_t first = 0;
+    size_t last = count;
+    while (first < last) {
+        size_t mid = first + (last - first) / 2;
+        if (rowTimeMs(mid) <= timestampMs) {
+            first = mid + 1;
+        } else {
+            last = mid;
+        }
+    }
+    return first;
+}
+
+/**
+ * @brief Append a row, overwriting the oldest row once the ring is full.
+ *
+ * @param timestampMs Row time in ms since epoch (not before the newest row)
+ * @param bins Pointer to binCount intensities
+ */
+void WaterfallIntensitySeries::appendRow(qint64 timestampMs, const float* bins)
+{
+    size_t physical;
+    if (count < rowCapacity) {
+        physical = physicalRow(count);
+        ++count;
+    } else {
+        physical = head;
+        head = (head + 1) % rowCapacity;
+    }
+
+    std::copy(bins, bins + binCount, values.begin() + physical * binCount);
+    timestampsMs[physical] = timestampMs;
+}
+
+void WaterfallIntensitySeries::clear()
+{
+    head = 0;
+    count = 0;
+}
+
+void WaterfallSeriesColumns::noteAppended(const qreal* values, size_t count)
+{
+    if (count == 0) {
+        return;
+    }
+
+    // Extend the range tree with the new tail; a full tree is rebuilt on the next windowed query
+    if (yTreeValid) {
+        for (size_t i = yTree.size(); i < yData.size(); ++i) {
+            if (!yTree.append(yData[i])) {
+                yTreeValid = false;
+                break;
+            }
+        }
+    }
+
+    // Fold the new tail into the pyramid if it has been built
+    if (lodValid) {
+        foldLod(lodFoldedEnd, timestampsMs.size());
+    }
+
+    // A series that was empty (or already invalid) starts its extents from the appended values
+    // only when they are the whole live set; otherwise leave the lazy recompute to yExtents()
+    if (!yExtentsValid) {
+        if (size() != count) {
+            return;
+        }
+        yMinCached = values[0];
+        yMaxCached = values[0];
+        yExtentsValid = true;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (values[i] < yMinCached) yMinCached = values[i];
+        if (values[i] > yMaxCached) yMaxCached = values[i];
+    }
+}
+
+std::pair<qreal, qreal> WaterfallSeriesColumns::yExtents() const
+{
+    if (empty()) {
+        return std::make_pair(0.0, 0.0);
+    }
+
+    if (!yExtentsValid) {
+        auto minMax = std::minmax_element(yData.begin() + head, yData.end());
+        yMinCached = *minMax.first;
+        yMaxCached = *minMax.second;
+        yExtentsValid = true;
+    }
+    return std::make_pair(yMinCached, yMaxCached);
+}
+
+std::pair<qreal, qreal> WaterfallSeriesColumns::yExtents(size_t first, size_t last) const
+{
+    last = std::min(last, size());
+    if (first >= last) {
+        return std::make_pair(0.0, 0.0);
+    }
+    if (first == 0 && last == size()) {
+        return yExtents();
+    }
+
+    if (!yTreeValid) {
+        yTree.rebuild(yData.data(), yData.size());
+        yTreeValid = true;
+    }
+    return yTree.query(head + first, head + last);
+}
+
+std::pair<qint64, qint64> WaterfallSeriesColumns::timeExtentsMs() const
+{
+    if (empty()) {
+        return std::make_pair(qint64(0), qint64(0));
+    }
+    return std::make_pair(timestampsMs[head], timestampsMs.back());
+}
+
+void WaterfallSeriesColumns::foldLod(size_t first, size_t last) const
+{
+    for (WaterfallLodLevel& level : lodLevels) {
+        for (size_t i = first; i < last; ++i) {
+            qint64 bucketStart = alignToBucket(timestampsMs[i], level.bucketMs);
+            if (level.head >= level.buckets.size() || level.buckets.back().startMs != bucketStart) {
+                WaterfallLodBucket bucket;
+                bucket.startMs = bucketStart;
+                level.buckets.push_back(bucket);
+            }
+            level.buckets.back().add(timestampsMs[i], yData[i]);
+        }
+    }
+    lodFoldedEnd = last;
+}
+
+void WaterfallSeriesColumns::refreshLod() const
+{
+    if (!lodValid) {
+        const std::vector<qint64>& bucketSizes = WaterfallData::getLodBucketSizesMs();
+        lodLevels.assign(bucketSizes.size(), WaterfallLodLevel());
+        for (size_t i = 0; i < bucketSizes.size(); ++i) {
+            lodLevels[i].bucketMs = bucketSizes[i];
+        }
+        foldLod(head, timestampsMs.size());
+        lodValid = true;
+        return;
+    }
+
+    // Re-aggregate front buckets that still include evicted samples
+    for (WaterfallLodLevel& level : lodLevels) {
+        if (!level.frontStale || level.head >= level.buckets.size()) {
+            level.frontStale = false;
+            continue;
+        }
+        WaterfallLodBucket& front = level.buckets[level.head];
+        auto end = std::lower_bound(timestampsMs.begin() + head, timestampsMs.end(), front.startMs + level.bucketMs);
+        WaterfallLodBucket rebuilt;
+        rebuilt.startMs = front.startMs;
+        for (auto it = timestampsMs.begin() + head; it != end; ++it) {
+            rebuilt.add(*it, yData[it - timestampsMs.begin()]);
+        }
+        front = rebuilt;
+        level.frontStale = false;
+    }
+}
+
 WaterfallData::WaterfallData(const QString& title)
 {
     dataTitle = title;
-    // Initialize empty vectors
-    dataSeriesYData[dataTitle] = std::vector<qreal>();
-    dataSeriesTimestamps[dataTitle] = std::vector<QDateTime>();
+    // Initialize empty columns
+    getOrCreateSeries(dataTitle);
 }
 
 WaterfallData::WaterfallData(const QString& title, const std::vector<QString>& seriesLabels)
 {
     dataTitle = title;
-    
+
     // Initialize empty series for each provided label
     for (const QString& seriesLabel : seriesLabels)
     {
-        dataSeriesYData[seriesLabel] = std::vector<qreal>();
-        dataSeriesTimestamps[seriesLabel] = std::vector<QDateTime>();
+        getOrCreateSeries(seriesLabel);
     }
-    
+
 }
 
 WaterfallData::~WaterfallData()
 {
     // Vectors will be automatically cleaned up
-    dataSeriesYData.clear();
-    dataSeriesTimestamps.clear();
+    seriesById.clear();
+    seriesIds.clear();
+    intensityById.clear();
+    intensityIds.clear();
     rtwSymbols.clear();
     btwSymbols.clear();
     btwMarkers.clear();
@@ -37,34 +350,28 @@ WaterfallData::~WaterfallData()
 
 void WaterfallData::setData(const std::vector<qreal>& yData, const std::vector<QDateTime>& timestamps)
 {
-    // Validate that both vectors have the same size
-    if (yData.size() != timestamps.size()) {
-        qDebug() << "Error: yData and timestamps must have the same size. yData size:" << yData.size() << "timestamps size:" << timestamps.size();
-        return;
-    }
-
-    // Store the data
-    this->dataSeriesYData[dataTitle] = yData;
-    this->dataSeriesTimestamps[dataTitle] = timestamps;
-
-    validateDataConsistency();
+    setDataSeries(dataTitle, yData, timestamps);
 }
 
 void WaterfallData::clearData()
 {
-    dataSeriesYData[dataTitle].clear();
-    dataSeriesTimestamps[dataTitle].clear();
+    getOrCreateSeries(dataTitle).clear();
 }
 
 
 bool WaterfallData::isEmpty() const
 {
     // Check if any series has data
-    for (const auto& pair : dataSeriesYData) {
-        if (!pair.second.empty()) {
+    for (int seriesId : seriesIds) {
+        if (!seriesById[seriesId].empty()) {
             return false; // Found at least one series with data
         }
     }
+    for (int seriesId : intensityIds) {
+        if (!intensityById[seriesId].empty()) {
+            return false;
+        }
+    }
     return true; // No series has data
 }
 
@@ -74,17 +381,36 @@ std::pair<qreal, qreal> WaterfallData::getYRange() const
     bool found = false;
     qreal minY = 0.0, maxY = 0.0;
 
-    for (const auto &pair : dataSeriesYData)
+    // O(series): each series keeps its own running extents
+    for (int seriesId : seriesIds)
     {
-        if (pair.second.empty()) continue;
-        auto minmax = std::minmax_element(pair.second.begin(), pair.second.end());
+        const WaterfallSeriesColumns& columns = seriesById[seriesId];
+        if (columns.empty()) continue;
+        std::pair<qreal, qreal> extents = columns.yExtents();
         if (!found) {
-            minY = *minmax.first;
-            maxY = *minmax.second;
+            minY = extents.first;
+            maxY = extents.second;
             found = true;
         } else {
-            if (*minmax.first < minY) minY = *minmax.first;
-            if (*minmax.second > maxY) maxY = *minmax.second;
+            if (extents.first < minY) minY = extents.first;
+            if (extents.second > maxY) maxY = extents.second;
+        }
+    }
+
+    // Intensity series span their bin axis
+    for (int seriesId : intensityIds)
+    {
+        const WaterfallIntensitySeries& series = intensityById[seriesId];
+        if (series.empty()) continue;
+        qreal low = std::min(series.binStart, series.binEnd);
+        qreal high = std::max(series.binStart, series.binEnd);
+        if (!found) {
+            minY = low;
+            maxY = high;
+            found = true;
+        } else {
+            if (low < minY) minY = low;
+            if (high > maxY) maxY = high;
         }
     }
 
@@ -96,71 +422,23 @@ std::pair<qreal, qreal> WaterfallData::getYRange() const
 
 std::pair<QDateTime, QDateTime> WaterfallData::getTimeRange() const
 {
-    QDateTime minTime, maxTime;
-
-    bool hasValue = false;
-    for (const auto& pair : dataSeriesTimestamps) {
-        for (const auto& t : pair.second) {
-            if (!hasValue) {
-                minTime = maxTime = t;
-                hasValue = true;
-            } else {
-                if (t < minTime) minTime = t;
-                if (t > maxTime) maxTime = t;
-            }
-        }
-    }
-
-    if (!hasValue) {
-        return std::make_pair(QDateTime(), QDateTime());
-    }
-    return std::make_pair(minTime, maxTime);
+    return getCombinedTimeRange();
 }
 
 qreal WaterfallData::getMinY() const
 {
-    bool found = false;
-    qreal minY = 0.0;
-    for (const auto& pair : dataSeriesYData) {
-        if (pair.second.empty()) continue;
-        qreal seriesMin = *std::min_element(pair.second.begin(), pair.second.end());
-        if (!found) {
-            minY = seriesMin;
-            found = true;
-        } else {
-            if (seriesMin < minY) minY = seriesMin;
-        }
-    }
-    if (!found) {
-        return 0.0;
-    }
-    return minY;
+    return getYRange().first;
 }
 
 qreal WaterfallData::getMaxY() const
 {
-    bool found = false;
-    qreal maxY = 0.0;
-    for (const auto& pair : dataSeriesYData) {
-        if (pair.second.empty()) continue;
-        qreal seriesMax = *std::max_element(pair.second.begin(), pair.second.end());
-        if (!found) {
-            maxY = seriesMax;
-            found = true;
-        } else {
-            if (seriesMax > maxY) maxY = seriesMax;
-        }
-    }
-    if (!found) {
-        return 0.0;
-    }
-    return maxY;
+    return getYRange().second;
 }
 
 qint64 WaterfallData::getTimeSpanMs() const
 {
-    auto it = dataSeriesTimestamps.find(dataTitle);
-    if (it == dataSeriesTimestamps.end() || it->second.size() < 2) {
+    const WaterfallSeriesColumns* columns = findSeries(dataTitle);
+    if (!columns || columns->size() < 2) {
         return 0;
     }
 
@@ -170,113 +448,245 @@ qint64 WaterfallData::getTimeSpanMs() const
 
 QDateTime WaterfallData::getEarliestTime() const
 {
-    QDateTime earliestTime;
-    bool hasValue = false;
-
-    for (const auto& pair : dataSeriesTimestamps) {
-        if (!pair.second.empty()) {
-            QDateTime seriesEarliest = *std::min_element(pair.second.begin(), pair.second.end());
-            if (!hasValue) {
-                earliestTime = seriesEarliest;
-                hasValue = true;
-            } else {
-                if (seriesEarliest < earliestTime) {
-                    earliestTime = seriesEarliest;
-                }
-            }
+    return getCombinedTimeRange().first;
+}
+
+QDateTime WaterfallData::getLatestTime() const
+{
+    return getCombinedTimeRange().second;
+}
+
+bool WaterfallData::isValidIndex(size_t index) const
+{
+    return isValidIndexSeries(dataTitle, index);
+}
+
+void WaterfallData::validateDataConsistency() const
+{
+    validateDataSeriesConsistency(dataTitle);
+}
+
+void WaterfallData::validateDataSeriesConsistency(const QString& seriesLabel) const
+{
+    validateDataSeriesConsistency(SeriesRegistry::find(seriesLabel));
+}
+
+void WaterfallData::validateDataSeriesConsistency(int seriesId) const
+{
+    const WaterfallSeriesColumns* columns = findSeries(seriesId);
+
+    if (columns) {
+        if (columns->yData.size() != columns->timestampsMs.size()) {
+            qDebug() << "Warning: Data series inconsistency detected for series" << SeriesRegistry::label(seriesId)
+                << "- yData size:" << columns->yData.size() << "timestamps size:" << columns->timestampsMs.size();
         }
     }
+}
 
-    if (!hasValue) {
-        return QDateTime();
+const WaterfallSeriesColumns* WaterfallData::findSeries(int seriesId) const
+{
+    if (seriesId < 0 || static_cast<size_t>(seriesId) >= seriesById.size() || !seriesById[seriesId].present) {
+        return nullptr;
     }
+    return &seriesById[seriesId];
+}
 
-    return earliestTime;
+const WaterfallSeriesColumns* WaterfallData::findSeries(const QString& seriesLabel) const
+{
+    return findSeries(SeriesRegistry::find(seriesLabel));
 }
 
-QDateTime WaterfallData::getLatestTime() const
+/**
+ * @brief Get the columns of a series, creating the series if this data source lacks it.
+ *
+ * Creating a series may grow the slot table, so references to other series obtained
+ * before the call must not be used after it.
+ *
+ * @param seriesId Interned series ID (see SeriesRegistry)
+ * @return WaterfallSeriesColumns& Columns of the series
+ */
+WaterfallSeriesColumns& WaterfallData::getOrCreateSeries(int seriesId)
 {
-    QDateTime latestTime;
-    bool hasValue = false;
-
-    for (const auto& pair : dataSeriesTimestamps) {
-        if (!pair.second.empty()) {
-            QDateTime seriesLatest = *std::max_element(pair.second.begin(), pair.second.end());
-            if (!hasValue) {
-                latestTime = seriesLatest;
-                hasValue = true;
-            } else {
-                if (seriesLatest > latestTime) {
-                    latestTime = seriesLatest;
-                }
-            }
-        }
+    if (static_cast<size_t>(seriesId) >= seriesById.size()) {
+        seriesById.resize(static_cast<size_t>(seriesId) + 1);
+    }
+    WaterfallSeriesColumns& columns = seriesById[seriesId];
+    if (columns.present) {
+        return columns;
     }
 
-    if (!hasValue) {
-        return QDateTime();
+    // Keep the ID list in label order, as series are listed and drawn in that order
+    QString seriesLabel = SeriesRegistry::label(seriesId);
+    auto pos = std::lower_bound(seriesIds.begin(), seriesIds.end(), seriesLabel,
+                                [](int id, const QString& label) { return SeriesRegistry::label(id) < label; });
+    seriesIds.insert(pos, seriesId);
+
+    // New series inherit the data-wide default retention policy
+    columns.present = true;
+    columns.retention = defaultRetentionPolicy;
+    if (columns.retention.maxSamples > 0) {
+        columns.timestampsMs.reserve(columns.retention.maxSamples * 2);
+        columns.yData.reserve(columns.retention.maxSamples * 2);
     }
-    return latestTime;
+    return columns;
 }
 
-bool WaterfallData::isValidIndex(size_t index) const
+WaterfallSeriesColumns& WaterfallData::getOrCreateSeries(const QString& seriesLabel)
 {
-    auto yIt = dataSeriesYData.find(dataTitle);
-    auto tIt = dataSeriesTimestamps.find(dataTitle);
-    return (yIt != dataSeriesYData.end() && index < yIt->second.size()) && 
-           (tIt != dataSeriesTimestamps.end() && index < tIt->second.size());
+    return getOrCreateSeries(SeriesRegistry::intern(seriesLabel));
 }
 
-void WaterfallData::validateDataConsistency() const
+void WaterfallData::restoreTimeOrder(WaterfallSeriesColumns& columns, size_t firstNewIndex)
 {
-    auto yIt = dataSeriesYData.find(dataTitle);
-    auto tIt = dataSeriesTimestamps.find(dataTitle);
-    
-    if (yIt != dataSeriesYData.end() && tIt != dataSeriesTimestamps.end()) {
-        if (yIt->second.size() != tIt->second.size()) {
-            qDebug() << "Warning: Data inconsistency detected for series" << dataTitle
-                << "- yData size:" << yIt->second.size() << "timestamps size:" << tIt->second.size();
-        }
+    if (columns.timestampsMs.size() != columns.yData.size()) {
+        return; // Inconsistent columns are reported by validateDataSeriesConsistency
+    }
+
+    // Fast path: appended samples are already in order and do not precede the existing tail
+    size_t checkFrom = std::max(columns.head, firstNewIndex > 0 ? firstNewIndex - 1 : 0);
+    if (checkFrom >= columns.timestampsMs.size() || std::is_sorted(columns.timestampsMs.begin() + checkFrom, columns.timestampsMs.end())) {
+        return;
     }
+
+    columns.compact();
+    columns.yTreeValid = false;
+    columns.lodValid = false;
+    std::vector<qint64>& timestampsMs = columns.timestampsMs;
+
+    // Stable sort both columns by timestamp through an index permutation
+    std::vector<size_t> order(timestampsMs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&timestampsMs](size_t a, size_t b) {
+        return timestampsMs[a] < timestampsMs[b];
+    });
+
+    std::vector<qint64> sortedTimestamps;
+    std::vector<qreal> sortedYData;
+    sortedTimestamps.reserve(timestampsMs.capacity());
+    sortedYData.reserve(columns.yData.capacity());
+    for (size_t index : order) {
+        sortedTimestamps.push_back(timestampsMs[index]);
+        sortedYData.push_back(columns.yData[index]);
+    }
+    timestampsMs.swap(sortedTimestamps);
+    columns.yData.swap(sortedYData);
 }
 
-void WaterfallData::validateDataSeriesConsistency(const QString& seriesLabel) const
+size_t WaterfallData::applyRetention(WaterfallSeriesColumns& columns)
 {
-    auto yIt = dataSeriesYData.find(seriesLabel);
-    auto tIt = dataSeriesTimestamps.find(seriesLabel);
+    const WaterfallRetentionPolicy& policy = columns.retention;
+    if (policy.isUnlimited() || columns.empty()) {
+        return 0;
+    }
 
-    if (yIt != dataSeriesYData.end() && tIt != dataSeriesTimestamps.end()) {
-        if (yIt->second.size() != tIt->second.size()) {
-            qDebug() << "Warning: Data series inconsistency detected for series" << seriesLabel
-                << "- yData size:" << yIt->second.size() << "timestamps size:" << tIt->second.size();
-        }
+    size_t dropCount = 0;
+
+    if (policy.maxSamples > 0 && columns.size() > policy.maxSamples) {
+        dropCount = columns.size() - policy.maxSamples;
+    }
+
+    if (policy.maxAgeMs > 0) {
+        // Age is measured against the newest sample so replayed data is trimmed the same way as live data
+        WaterfallSeriesView view = columns.view();
+        const qint64 cutoffMs = view.timestampsMs[view.count - 1] - policy.maxAgeMs;
+        const qint64* firstKept = std::lower_bound(view.timestampsMs, view.timestampsMs + view.count, cutoffMs);
+        dropCount = std::max(dropCount, static_cast<size_t>(firstKept - view.timestampsMs));
+    }
+
+    if (dropCount > 0) {
+        columns.dropFront(dropCount);
     }
+    return dropCount;
 }
 
-// Multiple data series methods implementation
+// Retention policy methods implementation
 
-void WaterfallData::addDataSeries(const QString& seriesLabel, const std::vector<qreal>& yData, const std::vector<QDateTime>& timestamps)
+void WaterfallData::setRetentionPolicy(const WaterfallRetentionPolicy& policy)
 {
-    // Validate that both vectors have the same size
-    if (yData.size() != timestamps.size()) {
-        qDebug() << "Error: yData and timestamps must have the same size for series" << seriesLabel
-            << ". yData size:" << yData.size() << "timestamps size:" << timestamps.size();
-        return;
+    defaultRetentionPolicy = policy;
+
+    // Apply to all existing series as well
+    for (int seriesId : seriesIds) {
+        setSeriesRetentionPolicy(SeriesRegistry::label(seriesId), policy);
     }
 
-    // Store the data series
-    dataSeriesYData[seriesLabel] = yData;
-    dataSeriesTimestamps[seriesLabel] = timestamps;
+    qDebug() << "WaterfallData:" << dataTitle << "retention policy set - max age ms:" << policy.maxAgeMs
+             << "max samples:" << static_cast<qulonglong>(policy.maxSamples);
+}
 
-    validateDataSeriesConsistency(seriesLabel);
+WaterfallRetentionPolicy WaterfallData::getRetentionPolicy() const
+{
+    return defaultRetentionPolicy;
+}
+
+void WaterfallData::setSeriesRetentionPolicy(const QString& seriesLabel, const WaterfallRetentionPolicy& policy)
+{
+    WaterfallSeriesColumns& columns = getOrCreateSeries(seriesLabel);
+    columns.retention = policy;
+
+    // Pre-size count-bounded series so eviction and compaction never reallocate
+    if (policy.maxSamples > 0) {
+        columns.timestampsMs.reserve(policy.maxSamples * 2);
+        columns.yData.reserve(policy.maxSamples * 2);
+    }
+
+    applyRetention(columns);
+}
+
+WaterfallRetentionPolicy WaterfallData::getSeriesRetentionPolicy(const QString& seriesLabel) const
+{
+    const WaterfallSeriesColumns* columns = findSeries(seriesLabel);
+    return columns ? columns->retention : defaultRetentionPolicy;
+}
+
+// Multiple data series methods implementation
+
+void WaterfallData::addDataSeries(const QString& seriesLabel, const std::vector<qreal>& yData, const std::vector<QDateTime>& timestamps)
+{
+    setDataSeries(seriesLabel, yData, timestamps);
 }
 
 void WaterfallData::addDataPointToSeries(const QString& seriesLabel, qreal yValue, const QDateTime& timestamp)
 {
-    dataSeriesYData[seriesLabel].push_back(yValue);
-    dataSeriesTimestamps[seriesLabel].push_back(timestamp);
+    addDataPointToSeries(seriesLabel, yValue, timestamp.toMSecsSinceEpoch());
+}
 
-    validateDataSeriesConsistency(seriesLabel);
+void WaterfallData::addDataPointToSeries(const QString& seriesLabel, qreal yValue, qint64 timestampMs)
+{
+    addDataPointToSeries(SeriesRegistry::intern(seriesLabel), yValue, timestampMs);
+}
+
+/**
+ * @brief Append one sample to a series identified by its interned ID.
+ *
+ * @param seriesId Interned series ID (created in this data source if missing)
+ * @param yValue Sample value
+ * @param timestampMs Sample time in milliseconds since epoch
+ */
+void WaterfallData::addDataPointToSeries(int seriesId, qreal yValue, qint64 timestampMs)
+{
+    if (seriesId < 0) {
+        qDebug() << "Error: invalid series ID" << seriesId;
+        return;
+    }
+
+    WaterfallSeriesColumns& columns = getOrCreateSeries(seriesId);
+    if (columns.empty() || timestampMs >= columns.timestampsMs.back()) {
+        columns.yData.push_back(yValue);
+        columns.timestampsMs.push_back(timestampMs);
+    } else {
+        // Late sample: insert after any equal timestamps to keep the time order
+        auto pos = std::upper_bound(columns.timestampsMs.begin() + columns.head, columns.timestampsMs.end(), timestampMs);
+        size_t index = static_cast<size_t>(pos - columns.timestampsMs.begin());
+        columns.timestampsMs.insert(pos, timestampMs);
+        columns.yData.insert(columns.yData.begin() + index, yValue);
+        columns.yTreeValid = false;
+        columns.lodValid = false;
+    }
+    columns.noteAppended(&yValue, 1);
+
+    applyRetention(columns);
+    validateDataSeriesConsistency(seriesId);
 }
 
 void WaterfallData::addDataPointsToSeries(const QString& seriesLabel, const std::vector<qreal>& yValues, const std::vector<QDateTime>& timestamps)
@@ -289,37 +699,236 @@ void WaterfallData::addDataPointsToSeries(const QString& seriesLabel, const std:
     }
 
     // Append the data to existing series
-    dataSeriesYData[seriesLabel].insert(dataSeriesYData[seriesLabel].end(), yValues.begin(), yValues.end());
-    dataSeriesTimestamps[seriesLabel].insert(dataSeriesTimestamps[seriesLabel].end(), timestamps.begin(), timestamps.end());
+    WaterfallSeriesColumns& columns = getOrCreateSeries(seriesLabel);
+    size_t firstNewIndex = columns.timestampsMs.size();
+    columns.yData.insert(columns.yData.end(), yValues.begin(), yValues.end());
+    columns.timestampsMs.reserve(columns.timestampsMs.size() + timestamps.size());
+    for (const QDateTime& t : timestamps) {
+        columns.timestampsMs.push_back(t.toMSecsSinceEpoch());
+    }
+    columns.noteAppended(yValues.data(), yValues.size());
+    restoreTimeOrder(columns, firstNewIndex);
+
+    applyRetention(columns);
+    validateDataSeriesConsistency(seriesLabel);
+}
+
+/**
+ * @brief Append samples to a series from raw epoch-ms and value columns.
+ *
+ * Both columns are appended with a single copy each; samples may be in any order
+ * (out-of-order input falls back to a stable sort of the series).
+ *
+ * @param seriesLabel Series label (created if missing)
+ * @param yValues Pointer to count values
+ * @param timestampsMs Pointer to count timestamps in milliseconds since epoch
+ * @param count Number of samples
+ */
+void WaterfallData::addDataPointsToSeries(const QString& seriesLabel, const qreal* yValues, const qint64* timestampsMs, size_t count)
+{
+    addDataPointsToSeries(SeriesRegistry::intern(seriesLabel), yValues, timestampsMs, count);
+}
+
+void WaterfallData::addDataPointsToSeries(int seriesId, const qreal* yValues, const qint64* timestampsMs, size_t count)
+{
+    if (count == 0) {
+        return;
+    }
+    if (seriesId < 0 || !yValues || !timestampsMs) {
+        qDebug() << "Error: null data columns or invalid ID passed for series" << seriesId;
+        return;
+    }
+
+    WaterfallSeriesColumns& columns = getOrCreateSeries(seriesId);
+    size_t firstNewIndex = columns.timestampsMs.size();
+    columns.yData.insert(columns.yData.end(), yValues, yValues + count);
+    columns.timestampsMs.insert(columns.timestampsMs.end(), timestampsMs, timestampsMs + count);
+    columns.noteAppended(yValues, count);
+    restoreTimeOrder(columns, firstNewIndex);
+
+    applyRetention(columns);
+    validateDataSeriesConsistency(seriesId);
+}
+
+/**
+ * @brief Create an intensity series, or reconfigure it and drop its rows.
+ *
+ * The ring is allocated once here, so adding rows never allocates.
+ *
+ * @param seriesLabel The label of the series
+ * @param binCount Intensities per row
+ * @param rowCapacity Rows kept before the oldest are overwritten
+ * @param binStart Value-axis position of the leading edge of the first bin
+ * @param binEnd Value-axis position of the trailing edge of the last bin
+ */
+void WaterfallData::setIntensitySeries(const QString& seriesLabel, int binCount, size_t rowCapacity, qreal binStart, qreal binEnd)
+{
+    if (binCount <= 0 || rowCapacity == 0 || binStart == binEnd) {
+        qDebug() << "Error: invalid intensity series layout for" << seriesLabel << "- bins:" << binCount
+                 << "rows:" << rowCapacity << "bin axis:" << binStart << binEnd;
+        return;
+    }
+
+    int seriesId = SeriesRegistry::intern(seriesLabel);
+    if (static_cast<size_t>(seriesId) >= intensityById.size()) {
+        intensityById.resize(static_cast<size_t>(seriesId) + 1);
+    }
+
+    WaterfallIntensitySeries& series = intensityById[seriesId];
+    if (!series.present) {
+        auto pos = std::lower_bound(intensityIds.begin(), intensityIds.end(), seriesLabel,
+                                    [](int id, const QString& label) { return SeriesRegistry::label(id) < label; });
+        intensityIds.insert(pos, seriesId);
+        series.present = true;
+    }
+
+    series.binCount = binCount;
+    series.rowCapacity = rowCapacity;
+    series.binStart = binStart;
+    series.binEnd = binEnd;
+    series.values.assign(rowCapacity * static_cast<size_t>(binCount), 0.0f);
+    series.timestampsMs.assign(rowCapacity, 0);
+    series.clear();
+}
+
+/**
+ * @brief Append one row of intensities to an intensity series.
+ *
+ * @param seriesId Interned ID of a series created by setIntensitySeries
+ * @param timestampMs Row time in ms since epoch
+ * @param bins Pointer to binCount intensities
+ * @param binCount Number of intensities, which must match the series
+ * @return true if the row was added; false for an unknown series, a bin count
+ *         mismatch or a row older than the newest row
+ */
+bool WaterfallData::addIntensityRow(int seriesId, qint64 timestampMs, const float* bins, size_t binCount)
+{
+    if (!hasIntensitySeries(seriesId) || !bins) {
+        qDebug() << "Error: no intensity series with ID" << seriesId;
+        return false;
+    }
+
+    WaterfallIntensitySeries& series = intensityById[seriesId];
+    if (binCount != static_cast<size_t>(series.binCount)) {
+        qDebug() << "Error: intensity row of" << binCount << "bins for series" << SeriesRegistry::label(seriesId)
+                 << "of" << series.binCount << "bins";
+        return false;
+    }
+    if (!series.empty() && timestampMs < series.rowTimeMs(series.size() - 1)) {
+        qDebug() << "Error: out of order intensity row for series" << SeriesRegistry::label(seriesId);
+        return false;
+    }
+
+    series.appendRow(timestampMs, bins);
+    return true;
+}
+
+void WaterfallData::clearIntensitySeries(const QString& seriesLabel)
+{
+    int seriesId = SeriesRegistry::find(seriesLabel);
+    if (!hasIntensitySeries(seriesId)) {
+        return;
+    }
+
+    intensityById[seriesId] = WaterfallIntensitySeries();
+    intensityIds.erase(std::find(intensityIds.begin(), intensityIds.end(), seriesId));
+}
+
+bool WaterfallData::hasIntensitySeries(int seriesId) const
+{
+    return getIntensitySeries(seriesId) != nullptr;
+}
 
+const WaterfallIntensitySeries* WaterfallData::getIntensitySeries(int seriesId) const
+{
+    if (seriesId < 0 || static_cast<size_t>(seriesId) >= intensityById.size() || !intensityById[seriesId].present) {
+        return nullptr;
+    }
+    return &intensityById[seriesId];
+}
+
+const WaterfallIntensitySeries* WaterfallData::getIntensitySeries(const QString& seriesLabel) const
+{
+    return getIntensitySeries(SeriesRegistry::find(seriesLabel));
+}
+
+/**
+ * @brief Append samples to a series, taking ownership of the columns.
+ *
+ * When the series holds no samples the vectors are adopted as its storage without
+ * copying; otherwise they are appended as with the pointer overload.
+ *
+ * @param seriesLabel Series label (created if missing)
+ * @param yValues Values, moved from
+ * @param timestampsMs Timestamps in milliseconds since epoch, moved from
+ */
+void WaterfallData::addDataPointsToSeries(const QString& seriesLabel, std::vector<qreal>&& yValues, std::vector<qint64>&& timestampsMs)
+{
+    if (yValues.size() != timestampsMs.size()) {
+        qDebug() << "Error: yValues and timestampsMs must have the same size for series" << seriesLabel
+            << ". yValues size:" << yValues.size() << "timestampsMs size:" << timestampsMs.size();
+        return;
+    }
+
+    WaterfallSeriesColumns& columns = getOrCreateSeries(seriesLabel);
+    if (!columns.timestampsMs.empty()) {
+        addDataPointsToSeries(seriesLabel, yValues.data(), timestampsMs.data(), yValues.size());
+        return;
+    }
+    if (yValues.empty()) {
+        return;
+    }
+
+    columns.clear();
+    columns.yData = std::move(yValues);
+    columns.timestampsMs = std::move(timestampsMs);
+    columns.noteAppended(columns.yData.data(), columns.yData.size());
+    restoreTimeOrder(columns, 0);
+
+    applyRetention(columns);
     validateDataSeriesConsistency(seriesLabel);
 }
 
+/**
+ * @brief Append samples to several series in one call.
+ *
+ * @param batch One entry per series; entries with null columns are skipped
+ */
+void WaterfallData::addDataBatch(const std::vector<WaterfallSeriesBatch>& batch)
+{
+    for (const WaterfallSeriesBatch& entry : batch) {
+        addDataPointsToSeries(entry.seriesLabel, entry.yData, entry.timestampsMs, entry.count);
+    }
+}
+
 void WaterfallData::clearDataSeries(const QString& seriesLabel)
 {
-    dataSeriesYData.erase(seriesLabel);
-    dataSeriesTimestamps.erase(seriesLabel);
+    int seriesId = SeriesRegistry::find(seriesLabel);
+    if (!findSeries(seriesId)) {
+        return;
+    }
+
+    // Release the storage; the slot is reused if the series is added again
+    seriesById[seriesId] = WaterfallSeriesColumns();
+    seriesIds.erase(std::find(seriesIds.begin(), seriesIds.end(), seriesId));
 }
 
 void WaterfallData::clearAllDataSeries()
 {
-    dataSeriesYData.clear();
-    dataSeriesTimestamps.clear();
+    seriesById.clear();
+    seriesIds.clear();
+    intensityById.clear();
+    intensityIds.clear();
 }
 
 std::vector<std::pair<qreal, QDateTime>> WaterfallData::getDataSeries(const QString& seriesLabel) const
 {
     std::vector<std::pair<qreal, QDateTime>> result;
 
-    auto yIt = dataSeriesYData.find(seriesLabel);
-    auto tIt = dataSeriesTimestamps.find(seriesLabel);
-
-    if (yIt != dataSeriesYData.end() && tIt != dataSeriesTimestamps.end()) {
-        result.reserve(yIt->second.size());
-
-        for (size_t i = 0; i < yIt->second.size(); ++i) {
-            result.emplace_back(yIt->second[i], tIt->second[i]);
-        }
+    WaterfallSeriesView view = getDataSeriesView(seriesLabel);
+    result.reserve(view.size());
+    for (size_t i = 0; i < view.size(); ++i) {
+        result.emplace_back(view.yData[i], QDateTime::fromMSecsSinceEpoch(view.timestampsMs[i]));
     }
 
     return result;
@@ -329,14 +938,10 @@ std::vector<std::pair<qreal, QDateTime>> WaterfallData::getDataSeriesWithinYExte
 {
     std::vector<std::pair<qreal, QDateTime>> result;
 
-    auto yIt = dataSeriesYData.find(seriesLabel);
-    auto tIt = dataSeriesTimestamps.find(seriesLabel);
-
-    if (yIt != dataSeriesYData.end() && tIt != dataSeriesTimestamps.end()) {
-        for (size_t i = 0; i < yIt->second.size(); ++i) {
-            if (yIt->second[i] >= yMin && yIt->second[i] <= yMax) {
-                result.emplace_back(yIt->second[i], tIt->second[i]);
-            }
+    WaterfallSeriesView view = getDataSeriesView(seriesLabel);
+    for (size_t i = 0; i < view.size(); ++i) {
+        if (view.yData[i] >= yMin && view.yData[i] <= yMax) {
+            result.emplace_back(view.yData[i], QDateTime::fromMSecsSinceEpoch(view.timestampsMs[i]));
         }
     }
 
@@ -347,58 +952,195 @@ std::vector<std::pair<qreal, QDateTime>> WaterfallData::getDataSeriesWithinTimeR
 {
     std::vector<std::pair<qreal, QDateTime>> result;
 
-    auto yIt = dataSeriesYData.find(seriesLabel);
-    auto tIt = dataSeriesTimestamps.find(seriesLabel);
-
-    if (yIt != dataSeriesYData.end() && tIt != dataSeriesTimestamps.end()) {
-        for (size_t i = 0; i < tIt->second.size(); ++i) {
-            if (tIt->second[i] >= startTime && tIt->second[i] <= endTime) {
-                result.emplace_back(yIt->second[i], tIt->second[i]);
-            }
-        }
+    WaterfallSeriesView view = getDataSeriesView(seriesLabel, startTime, endTime);
+    result.reserve(view.size());
+    for (size_t i = 0; i < view.size(); ++i) {
+        result.emplace_back(view.yData[i], QDateTime::fromMSecsSinceEpoch(view.timestampsMs[i]));
     }
 
     return result;
 }
 
-const std::vector<qreal>& WaterfallData::getYDataSeries(const QString& seriesLabel) const
+std::vector<qreal> WaterfallData::getYDataSeries(const QString& seriesLabel) const
+{
+    WaterfallSeriesView view = getDataSeriesView(seriesLabel);
+    return std::vector<qreal>(view.yData, view.yData + view.count);
+}
+
+std::vector<qint64> WaterfallData::getTimestampsMsSeries(const QString& seriesLabel) const
+{
+    WaterfallSeriesView view = getDataSeriesView(seriesLabel);
+    return std::vector<qint64>(view.timestampsMs, view.timestampsMs + view.count);
+}
+
+std::vector<QDateTime> WaterfallData::getTimestampsSeries(const QString& seriesLabel) const
+{
+    WaterfallSeriesView view = getDataSeriesView(seriesLabel);
+    return fromEpochMs(view.timestampsMs, view.count);
+}
+
+WaterfallSeriesView WaterfallData::getDataSeriesView(const QString& seriesLabel) const
+{
+    return getDataSeriesView(SeriesRegistry::find(seriesLabel));
+}
+
+WaterfallSeriesView WaterfallData::getDataSeriesView(int seriesId) const
+{
+    const WaterfallSeriesColumns* columns = findSeries(seriesId);
+    return columns ? columns->view() : WaterfallSeriesView();
+}
+
+WaterfallSeriesView WaterfallData::getDataSeriesView(const QString& seriesLabel, qint64 startMs, qint64 endMs) const
+{
+    return getDataSeriesView(SeriesRegistry::find(seriesLabel), startMs, endMs);
+}
+
+WaterfallSeriesView WaterfallData::getDataSeriesView(int seriesId, qint64 startMs, qint64 endMs) const
+{
+    WaterfallSeriesView view = getDataSeriesView(seriesId);
+    if (view.empty() || endMs < startMs) {
+        return WaterfallSeriesView();
+    }
+
+    // Columns are time ordered, so the inclusive window [startMs, endMs] is a contiguous index range
+    const qint64* begin = view.timestampsMs;
+    const qint64* end = view.timestampsMs + view.count;
+    const qint64* first = std::lower_bound(begin, end, startMs);
+    const qint64* last = std::upper_bound(first, end, endMs);
+
+    size_t offset = static_cast<size_t>(first - begin);
+    view.firstIndex = offset;
+    view.count = static_cast<size_t>(last - first);
+    view.timestampsMs += offset;
+    view.yData += offset;
+    return view;
+}
+
+WaterfallSeriesView WaterfallData::getDataSeriesView(const QString& seriesLabel, const QDateTime& startTime, const QDateTime& endTime) const
+{
+    return getDataSeriesView(seriesLabel, startTime.toMSecsSinceEpoch(), endTime.toMSecsSinceEpoch());
+}
+
+/**
+ * @brief Bucket sizes of the level-of-detail pyramid kept for each series, finest first.
+ */
+const std::vector<qint64>& WaterfallData::getLodBucketSizesMs()
 {
-    static const std::vector<qreal> emptyVector;
-    auto it = dataSeriesYData.find(seriesLabel);
-    return (it != dataSeriesYData.end()) ? it->second : emptyVector;
+    static const std::vector<qint64> bucketSizes = { 1000, 10000, 60000, 600000 };
+    return bucketSizes;
 }
 
-const std::vector<QDateTime>& WaterfallData::getTimestampsSeries(const QString& seriesLabel) const
+/**
+ * @brief Get pre-aggregated vertices of a series within a time window.
+ *
+ * Picks the coarsest pyramid level whose bucket is no larger than maxBucketMs and emits
+ * the first, min, max and last samples of every bucket overlapping the window, in time
+ * order. The cost depends on the number of buckets in the window, not on the sample count.
+ *
+ * @param seriesLabel Series label
+ * @param startMs Window start in ms since epoch (inclusive)
+ * @param endMs Window end in ms since epoch (inclusive)
+ * @param maxBucketMs Largest acceptable bucket size
+ * @param timestampsMs Receives the vertex timestamps
+ * @param yData Receives the vertex values
+ * @return qint64 Bucket size of the level used, or 0 if no level fits (use the raw samples)
+ */
+qint64 WaterfallData::getLodSeries(const QString& seriesLabel, qint64 startMs, qint64 endMs, qint64 maxBucketMs,
+                                   std::vector<qint64>& timestampsMs, std::vector<qreal>& yData) const
 {
-    static const std::vector<QDateTime> emptyVector;
-    auto it = dataSeriesTimestamps.find(seriesLabel);
-    return (it != dataSeriesTimestamps.end()) ? it->second : emptyVector;
+    return getLodSeries(SeriesRegistry::find(seriesLabel), startMs, endMs, maxBucketMs, timestampsMs, yData);
+}
+
+qint64 WaterfallData::getLodSeries(int seriesId, qint64 startMs, qint64 endMs, qint64 maxBucketMs,
+                                   std::vector<qint64>& timestampsMs, std::vector<qreal>& yData) const
+{
+    timestampsMs.clear();
+    yData.clear();
+
+    const WaterfallSeriesColumns* found = findSeries(seriesId);
+    if (!found || found->empty() || endMs < startMs) {
+        return 0;
+    }
+
+    const WaterfallSeriesColumns& columns = *found;
+    columns.refreshLod();
+
+    const WaterfallLodLevel* level = nullptr;
+    for (const WaterfallLodLevel& candidate : columns.lodLevels) {
+        if (candidate.bucketMs <= maxBucketMs) {
+            level = &candidate;
+        }
+    }
+    if (!level) {
+        return 0;
+    }
+
+    auto byStart = [](const WaterfallLodBucket& bucket, qint64 timeMs) { return bucket.startMs < timeMs; };
+    auto liveBegin = level->buckets.begin() + level->head;
+    auto first = std::lower_bound(liveBegin, level->buckets.end(), alignToBucket(startMs, level->bucketMs), byStart);
+    auto last = std::lower_bound(first, level->buckets.end(), endMs + 1, byStart);
+
+    timestampsMs.reserve(static_cast<size_t>(last - first) * 4);
+    yData.reserve(static_cast<size_t>(last - first) * 4);
+
+    auto addVertex = [&](qint64 timeMs, qreal value) {
+        if (!timestampsMs.empty() && timestampsMs.back() == timeMs && yData.back() == value) {
+            return;
+        }
+        timestampsMs.push_back(timeMs);
+        yData.push_back(value);
+    };
+
+    for (auto bucket = first; bucket != last; ++bucket) {
+        addVertex(bucket->firstMs, bucket->first);
+        if (bucket->minMs <= bucket->maxMs) {
+            addVertex(bucket->minMs, bucket->min);
+            addVertex(bucket->maxMs, bucket->max);
+        }
+        else {
+            addVertex(bucket->maxMs, bucket->max);
+            addVertex(bucket->minMs, bucket->min);
+        }
+        addVertex(bucket->lastMs, bucket->last);
+    }
+
+    return level->bucketMs;
 }
 
 size_t WaterfallData::getDataSeriesSize(const QString& seriesLabel) const
 {
-    auto it = dataSeriesYData.find(seriesLabel);
-    return (it != dataSeriesYData.end()) ? it->second.size() : 0;
+    return getDataSeriesSize(SeriesRegistry::find(seriesLabel));
+}
+
+size_t WaterfallData::getDataSeriesSize(int seriesId) const
+{
+    const WaterfallSeriesColumns* columns = findSeries(seriesId);
+    return columns ? columns->size() : 0;
 }
 
 bool WaterfallData::isDataSeriesEmpty(const QString& seriesLabel) const
 {
-    auto it = dataSeriesYData.find(seriesLabel);
-    return (it == dataSeriesYData.end()) || it->second.empty();
+    const WaterfallSeriesColumns* columns = findSeries(seriesLabel);
+    return !columns || columns->empty();
 }
 
 bool WaterfallData::hasDataSeries(const QString& seriesLabel) const
 {
-    return dataSeriesYData.find(seriesLabel) != dataSeriesYData.end();
+    return findSeries(seriesLabel) != nullptr;
+}
+
+bool WaterfallData::hasDataSeries(int seriesId) const
+{
+    return findSeries(seriesId) != nullptr;
 }
 
 std::vector<QString> WaterfallData::getDataSeriesLabels() const
 {
     std::vector<QString> labels;
-    labels.reserve(dataSeriesYData.size());
+    labels.reserve(seriesIds.size());
 
-    for (const auto& pair : dataSeriesYData) {
-        labels.push_back(pair.first);
+    for (int seriesId : seriesIds) {
+        labels.push_back(SeriesRegistry::label(seriesId));
     }
 
     return labels;
@@ -406,67 +1148,144 @@ std::vector<QString> WaterfallData::getDataSeriesLabels() const
 
 std::pair<qreal, qreal> WaterfallData::getYRangeSeries(const QString& seriesLabel) const
 {
-    auto it = dataSeriesYData.find(seriesLabel);
-    if (it == dataSeriesYData.end() || it->second.empty()) {
+    const WaterfallSeriesColumns* columns = findSeries(seriesLabel);
+    if (!columns) {
         return std::make_pair(0.0, 0.0);
     }
+    return columns->yExtents();
+}
+
+/**
+ * @brief Get the Y range of the samples of a series within a time window.
+ *
+ * Binary searches the window bounds and answers min/max from the series range tree,
+ * so the cost is O(log n) regardless of how many samples fall inside the window.
+ *
+ * @param seriesLabel Series label
+ * @param startMs Window start in ms since epoch (inclusive)
+ * @param endMs Window end in ms since epoch (inclusive)
+ * @param range Receives the min and max Y values
+ * @return true if the window contains at least one sample
+ */
+bool WaterfallData::getYRangeSeriesInTimeRange(const QString& seriesLabel, qint64 startMs, qint64 endMs, std::pair<qreal, qreal>& range) const
+{
+    int seriesId = SeriesRegistry::find(seriesLabel);
+    const WaterfallSeriesColumns* columns = findSeries(seriesId);
+    if (!columns) {
+        return false;
+    }
 
-    auto minMax = std::minmax_element(it->second.begin(), it->second.end());
-    return std::make_pair(*minMax.first, *minMax.second);
+    WaterfallSeriesView window = getDataSeriesView(seriesId, startMs, endMs);
+    if (window.empty()) {
+        return false;
+    }
+
+    range = columns->yExtents(window.firstIndex, window.firstIndex + window.count);
+    return true;
 }
 
 std::pair<QDateTime, QDateTime> WaterfallData::getTimeRangeSeries(const QString& seriesLabel) const
 {
-    auto it = dataSeriesTimestamps.find(seriesLabel);
-    if (it == dataSeriesTimestamps.end() || it->second.empty()) {
+    const WaterfallSeriesColumns* columns = findSeries(seriesLabel);
+    if (!columns || columns->empty()) {
         return std::make_pair(QDateTime(), QDateTime());
     }
 
-    auto minMax = std::minmax_element(it->second.begin(), it->second.end());
-    return std::make_pair(*minMax.first, *minMax.second);
+    std::pair<qint64, qint64> extents = columns->timeExtentsMs();
+    return std::make_pair(QDateTime::fromMSecsSinceEpoch(extents.first),
+                          QDateTime::fromMSecsSinceEpoch(extents.second));
 }
 
 std::pair<qreal, qreal> WaterfallData::getCombinedYRange() const
 {
-    qreal globalMin = std::numeric_limits<qreal>::max();
-    qreal globalMax = std::numeric_limits<qreal>::lowest();
-    bool hasData = false;
+    return getYRange();
+}
 
-    // Check all data series
-    for (const auto& pair : dataSeriesYData) {
-        if (!pair.second.empty()) {
-            auto minMax = std::minmax_element(pair.second.begin(), pair.second.end());
-            globalMin = std::min(globalMin, *minMax.first);
-            globalMax = std::max(globalMax, *minMax.second);
+/**
+ * @brief Get the Y range over all series within a time window.
+ *
+ * @param startMs Window start in ms since epoch (inclusive)
+ * @param endMs Window end in ms since epoch (inclusive)
+ * @param range Receives the min and max Y values
+ * @return true if any series has a sample inside the window
+ */
+bool WaterfallData::getCombinedYRangeInTimeRange(qint64 startMs, qint64 endMs, std::pair<qreal, qreal>& range) const
+{
+    bool hasData = false;
+    for (int seriesId : seriesIds) {
+        const WaterfallSeriesColumns& columns = seriesById[seriesId];
+        WaterfallSeriesView window = getDataSeriesView(seriesId, startMs, endMs);
+        if (window.empty()) {
+            continue;
+        }
+        std::pair<qreal, qreal> seriesRange = columns.yExtents(window.firstIndex, window.firstIndex + window.count);
+        if (!hasData) {
+            range = seriesRange;
             hasData = true;
         }
+        else {
+            range.first = std::min(range.first, seriesRange.first);
+            range.second = std::max(range.second, seriesRange.second);
+        }
     }
-
-    if (!hasData) {
-        return std::make_pair(0.0, 0.0);
+    for (int seriesId : intensityIds) {
+        const WaterfallIntensitySeries& series = intensityById[seriesId];
+        size_t firstRow = series.upperBound(startMs - 1);
+        if (firstRow >= series.size() || series.rowTimeMs(firstRow) > endMs) {
+            continue;
+        }
+        std::pair<qreal, qreal> seriesRange(std::min(series.binStart, series.binEnd), std::max(series.binStart, series.binEnd));
+        if (!hasData) {
+            range = seriesRange;
+            hasData = true;
+        }
+        else {
+            range.first = std::min(range.first, seriesRange.first);
+            range.second = std::max(range.second, seriesRange.second);
+        }
     }
-
-    return std::make_pair(globalMin, globalMax);
+    return hasData;
 }
 
 std::pair<QDateTime, QDateTime> WaterfallData::getCombinedTimeRange() const
 {
-    QDateTime globalMin = QDateTime();
-    QDateTime globalMax = QDateTime();
+    qint64 globalMin = 0;
+    qint64 globalMax = 0;
     bool hasData = false;
 
-    // Check all data series
-    for (const auto& pair : dataSeriesTimestamps) {
-        if (!pair.second.empty()) {
-            auto minMax = std::minmax_element(pair.second.begin(), pair.second.end());
+    // Check all data series (O(1) each: series are time ordered)
+    for (int seriesId : seriesIds) {
+        const WaterfallSeriesColumns& columns = seriesById[seriesId];
+        if (!columns.empty()) {
+            std::pair<qint64, qint64> extents = columns.timeExtentsMs();
+            qint64 seriesMin = extents.first;
+            qint64 seriesMax = extents.second;
+            if (!hasData) {
+                globalMin = seriesMin;
+                globalMax = seriesMax;
+                hasData = true;
+            }
+            else {
+                globalMin = std::min(globalMin, seriesMin);
+                globalMax = std::max(globalMax, seriesMax);
+            }
+        }
+    }
+
+    // Intensity rows share the time axis
+    for (int seriesId : intensityIds) {
+        const WaterfallIntensitySeries& series = intensityById[seriesId];
+        if (!series.empty()) {
+            qint64 seriesMin = series.rowTimeMs(0);
+            qint64 seriesMax = series.rowTimeMs(series.size() - 1);
             if (!hasData) {
-                globalMin = *minMax.first;
-                globalMax = *minMax.second;
+                globalMin = seriesMin;
+                globalMax = seriesMax;
                 hasData = true;
             }
             else {
-                globalMin = std::min(globalMin, *minMax.first);
-                globalMax = std::max(globalMax, *minMax.second);
+                globalMin = std::min(globalMin, seriesMin);
+                globalMax = std::max(globalMax, seriesMax);
             }
         }
     }
@@ -475,7 +1294,7 @@ std::pair<QDateTime, QDateTime> WaterfallData::getCombinedTimeRange() const
         return std::make_pair(QDateTime(), QDateTime());
     }
 
-    return std::make_pair(globalMin, globalMax);
+    return std::make_pair(QDateTime::fromMSecsSinceEpoch(globalMin), QDateTime::fromMSecsSinceEpoch(globalMax));
 }
 
 // Selection time span methods implementation
@@ -502,8 +1321,7 @@ qint64 WaterfallData::getSelectionTimeSpanMs() const
 
 bool WaterfallData::isValidSelectionTime(const QDateTime& time) const
 {
-    auto it = dataSeriesTimestamps.find(dataTitle);
-    if (it == dataSeriesTimestamps.end() || it->second.empty()) {
+    if (isDataSeriesEmpty(dataTitle)) {
         return false;
     }
 
@@ -526,93 +1344,60 @@ void WaterfallData::setDataSeries(const QString& seriesLabel, const std::vector<
     }
 
     // Store the data series
-    dataSeriesYData[seriesLabel] = yData;
-    dataSeriesTimestamps[seriesLabel] = timestamps;
-
+    WaterfallSeriesColumns& columns = getOrCreateSeries(seriesLabel);
+    columns.clear();
+    columns.yData.insert(columns.yData.end(), yData.begin(), yData.end());
+    columns.timestampsMs = toEpochMs(timestamps);
+    columns.noteAppended(yData.data(), yData.size());
+    restoreTimeOrder(columns, 0);
+
+    applyRetention(columns);
     validateDataSeriesConsistency(seriesLabel);
 }
 
 std::vector<std::pair<qreal, QDateTime>> WaterfallData::getAllDataSeries(const QString& seriesLabel) const
 {
-    std::vector<std::pair<qreal, QDateTime>> result;
-    
-    auto yIt = dataSeriesYData.find(seriesLabel);
-    auto tIt = dataSeriesTimestamps.find(seriesLabel);
-    
-    if (yIt != dataSeriesYData.end() && tIt != dataSeriesTimestamps.end()) {
-        result.reserve(yIt->second.size());
-        
-        for (size_t i = 0; i < yIt->second.size(); ++i) {
-            result.emplace_back(yIt->second[i], tIt->second[i]);
-        }
-    }
-    
-    return result;
+    return getDataSeries(seriesLabel);
 }
 
 qreal WaterfallData::getMinYSeries(const QString& seriesLabel) const
 {
-    auto it = dataSeriesYData.find(seriesLabel);
-    if (it == dataSeriesYData.end() || it->second.empty()) {
-        return 0.0;
-    }
-
-    return *std::min_element(it->second.begin(), it->second.end());
+    return getYRangeSeries(seriesLabel).first;
 }
 
 qreal WaterfallData::getMaxYSeries(const QString& seriesLabel) const
 {
-    auto it = dataSeriesYData.find(seriesLabel);
-    if (it == dataSeriesYData.end() || it->second.empty()) {
-        return 0.0;
-    }
-
-    return *std::max_element(it->second.begin(), it->second.end());
+    return getYRangeSeries(seriesLabel).second;
 }
 
 qint64 WaterfallData::getTimeSpanMsSeries(const QString& seriesLabel) const
 {
-    auto it = dataSeriesTimestamps.find(seriesLabel);
-    if (it == dataSeriesTimestamps.end() || it->second.size() < 2) {
+    WaterfallSeriesView view = getDataSeriesView(seriesLabel);
+    if (view.size() < 2) {
         return 0;
     }
 
-    auto timeRange = getTimeRangeSeries(seriesLabel);
-    return timeRange.first.msecsTo(timeRange.second);
+    return view.timestampsMs[view.count - 1] - view.timestampsMs[0];
 }
 
 QDateTime WaterfallData::getEarliestTimeSeries(const QString& seriesLabel) const
 {
-    auto it = dataSeriesTimestamps.find(seriesLabel);
-    if (it == dataSeriesTimestamps.end() || it->second.empty()) {
-        return QDateTime();
-    }
-
-    return *std::min_element(it->second.begin(), it->second.end());
+    return getTimeRangeSeries(seriesLabel).first;
 }
 
 QDateTime WaterfallData::getLatestTimeSeries(const QString& seriesLabel) const
 {
-    auto it = dataSeriesTimestamps.find(seriesLabel);
-    if (it == dataSeriesTimestamps.end() || it->second.empty()) {
-        return QDateTime();
-    }
-
-    return *std::max_element(it->second.begin(), it->second.end());
+    return getTimeRangeSeries(seriesLabel).second;
 }
 
 bool WaterfallData::isValidIndexSeries(const QString& seriesLabel, size_t index) const
 {
-    auto yIt = dataSeriesYData.find(seriesLabel);
-    auto tIt = dataSeriesTimestamps.find(seriesLabel);
-    return (yIt != dataSeriesYData.end() && index < yIt->second.size()) && 
-           (tIt != dataSeriesTimestamps.end() && index < tIt->second.size());
+    return index < getDataSeriesSize(seriesLabel);
 }
 
 bool WaterfallData::isValidSelectionTimeSeries(const QString& seriesLabel, const QDateTime& time) const
 {
-    auto it = dataSeriesTimestamps.find(seriesLabel);
-    if (it == dataSeriesTimestamps.end() || it->second.empty()) {
+    if (isDataSeriesEmpty(seriesLabel)) {
         return false;
     }
 
@@ -627,116 +1412,134 @@ bool WaterfallData::isValidSelectionTimeSeries(const QString& seriesLabel, const
 
 std::vector<std::pair<qreal, QDateTime>> WaterfallData::getBinnedDataSeries(const QString& seriesLabel, const QTime& binDuration) const
 {
-    std::vector<std::pair<qreal, QDateTime>> result;
-    
-    auto yIt = dataSeriesYData.find(seriesLabel);
-    auto tIt = dataSeriesTimestamps.find(seriesLabel);
-    
-    if (yIt == dataSeriesYData.end() || tIt == dataSeriesTimestamps.end() || yIt->second.empty()) {
-        return result; // Return empty vector if series doesn't exist or is empty
-    }
-    
-    const auto& yData = yIt->second;
-    const auto& timestamps = tIt->second;
-    
-    if (timestamps.empty()) {
-        return result;
+    WaterfallSeriesView view = getDataSeriesView(seriesLabel);
+
+    if (view.empty()) {
+        return std::vector<std::pair<qreal, QDateTime>>(); // Return empty vector if series doesn't exist or is empty
     }
-    
-    // Convert QTime duration to milliseconds
+
     qint64 binSizeMs = QTime(0, 0, 0).msecsTo(binDuration);
-    
     if (binSizeMs <= 0) {
         qDebug() << "Warning: Invalid bin duration provided for series" << seriesLabel;
-        return result;
+        return std::vector<std::pair<qreal, QDateTime>>();
     }
-    
-    // Find the earliest timestamp to use as reference for binning
-    QDateTime earliestTime = *std::min_element(timestamps.begin(), timestamps.end());
-    
-    // Create a map to store the first value in each bin
-    std::map<qint64, std::pair<qreal, QDateTime>> bins;
-    
-    for (size_t i = 0; i < timestamps.size(); ++i) {
-        // Calculate which bin this timestamp belongs to
-        qint64 timeDiffMs = earliestTime.msecsTo(timestamps[i]);
-        qint64 binIndex = timeDiffMs / binSizeMs;
-        
-        // If this is the first value in this bin, store it
-        if (bins.find(binIndex) == bins.end()) {
-            bins[binIndex] = std::make_pair(yData[i], timestamps[i]);
-        }
-    }
-    
-    // Convert the map to a vector, maintaining chronological order
-    result.reserve(bins.size());
-    for (const auto& bin : bins) {
-        result.push_back(bin.second);
+
+    std::vector<std::pair<qreal, qint64>> binned = binDataByTimeMs(view, binSizeMs, view.timestampsMs[0]);
+
+    std::vector<std::pair<qreal, QDateTime>> result;
+    result.reserve(binned.size());
+    for (const auto& bin : binned) {
+        result.emplace_back(bin.first, QDateTime::fromMSecsSinceEpoch(bin.second));
     }
-    
-    // Sort by timestamp to ensure chronological order
-    std::sort(result.begin(), result.end(), 
-              [](const std::pair<qreal, QDateTime>& a, const std::pair<qreal, QDateTime>& b) {
-                  return a.second < b.second;
-              });
-    
     return result;
 }
 
 // Static binning method implementation
 
 std::vector<std::pair<qreal, QDateTime>> WaterfallData::binDataByTime(
-    const std::vector<qreal>& yData, 
-    const std::vector<QDateTime>& timestamps, 
+    const std::vector<qreal>& yData,
+    const std::vector<QDateTime>& timestamps,
     const QTime& binDuration)
 {
     std::vector<std::pair<qreal, QDateTime>> result;
-    
+
     // Validate input data
     if (yData.empty() || timestamps.empty() || yData.size() != timestamps.size()) {
         qDebug() << "WaterfallData::binDataByTime: Invalid input data - sizes don't match or data is empty";
         return result;
     }
-    
+
     // Convert QTime duration to milliseconds
     qint64 binSizeMs = QTime(0, 0, 0).msecsTo(binDuration);
-    
+
     if (binSizeMs <= 0) {
         qDebug() << "WaterfallData::binDataByTime: Invalid bin duration provided";
         return result;
     }
-    
+
+    std::vector<std::pair<qreal, qint64>> binned = binDataByTimeMs(yData, toEpochMs(timestamps), binSizeMs);
+
+    result.reserve(binned.size());
+    for (const auto& bin : binned) {
+        result.emplace_back(bin.first, QDateTime::fromMSecsSinceEpoch(bin.second));
+    }
+
+    return result;
+}
+
+std::vector<std::pair<qreal, qint64>> WaterfallData::binDataByTimeMs(
+    const std::vector<qreal>& yData,
+    const std::vector<qint64>& timestampsMs,
+    qint64 binSizeMs)
+{
+    std::vector<std::pair<qreal, qint64>> result;
+
+    // Validate input data
+    if (yData.empty() || timestampsMs.empty() || yData.size() != timestampsMs.size()) {
+        qDebug() << "WaterfallData::binDataByTimeMs: Invalid input data - sizes don't match or data is empty";
+        return result;
+    }
+
+    if (binSizeMs <= 0) {
+        qDebug() << "WaterfallData::binDataByTimeMs: Invalid bin duration provided";
+        return result;
+    }
+
     // Find the earliest timestamp to use as reference for binning
-    QDateTime earliestTime = *std::min_element(timestamps.begin(), timestamps.end());
-    
+    qint64 earliestMs = *std::min_element(timestampsMs.begin(), timestampsMs.end());
+
     // Create a map to store the first value in each bin
-    std::map<qint64, std::pair<qreal, QDateTime>> bins;
-    
-    for (size_t i = 0; i < timestamps.size(); ++i) {
+    std::map<qint64, std::pair<qreal, qint64>> bins;
+
+    for (size_t i = 0; i < timestampsMs.size(); ++i) {
         // Calculate which bin this timestamp belongs to
-        qint64 timeDiffMs = earliestTime.msecsTo(timestamps[i]);
-        qint64 binIndex = timeDiffMs / binSizeMs;
-        
+        qint64 binIndex = (timestampsMs[i] - earliestMs) / binSizeMs;
+
         // If this is the first value in this bin, store it
         if (bins.find(binIndex) == bins.end()) {
-            bins[binIndex] = std::make_pair(yData[i], timestamps[i]);
+            bins[binIndex] = std::make_pair(yData[i], timestampsMs[i]);
         }
     }
-    
+
     // Convert the map to a vector, maintaining chronological order
     result.reserve(bins.size());
     for (const auto& bin : bins) {
         result.push_back(bin.second);
     }
-    
+
     // Sort by timestamp to ensure chronological order
-    std::sort(result.begin(), result.end(), 
-              [](const std::pair<qreal, QDateTime>& a, const std::pair<qreal, QDateTime>& b) {
+    std::sort(result.begin(), result.end(),
+              [](const std::pair<qreal, qint64>& a, const std::pair<qreal, qint64>& b) {
                   return a.second < b.second;
               });
-    
-    qDebug() << "WaterfallData::binDataByTime: Binned" << yData.size() << "points into" << result.size() << "bins with duration" << binSizeMs << "ms";
-    
+
+    qDebug() << "WaterfallData::binDataByTimeMs: Binned" << yData.size() << "points into" << result.size() << "bins with duration" << binSizeMs << "ms";
+
+    return result;
+}
+
+std::vector<std::pair<qreal, qint64>> WaterfallData::binDataByTimeMs(
+    const WaterfallSeriesView& view,
+    qint64 binSizeMs,
+    qint64 anchorMs)
+{
+    std::vector<std::pair<qreal, qint64>> result;
+
+    if (view.empty() || binSizeMs <= 0) {
+        return result;
+    }
+
+    // The view is time ordered, so the first sample seen in each bin is the earliest one
+    qint64 currentBin = std::numeric_limits<qint64>::min();
+    for (size_t i = 0; i < view.size(); ++i) {
+        qint64 offsetMs = view.timestampsMs[i] - anchorMs;
+        qint64 binIndex = offsetMs >= 0 ? offsetMs / binSizeMs : -((-offsetMs + binSizeMs - 1) / binSizeMs);
+        if (binIndex != currentBin) {
+            currentBin = binIndex;
+            result.emplace_back(view.yData[i], view.timestampsMs[i]);
+        }
+    }
+
     return result;
 }
 
@@ -750,6 +1553,7 @@ void WaterfallData::addRTWSymbol(const QString& symbolName, const QDateTime& tim
     symbolData.range = range;
     
     rtwSymbols.push_back(symbolData);
+    ++annotationRevision;
     
     qDebug() << "WaterfallData: Added RTW symbol" << symbolName << "at timestamp" << timestamp.toString() << "with range" << range;
 }
@@ -757,6 +1561,7 @@ void WaterfallData::addRTWSymbol(const QString& symbolName, const QDateTime& tim
 void WaterfallData::clearRTWSymbols()
 {
     rtwSymbols.clear();
+    ++annotationRevision;
     qDebug() << "WaterfallData: Cleared all RTW symbols";
 }
 
@@ -777,6 +1582,7 @@ bool WaterfallData::removeRTWSymbol(const QString& symbolName, const QDateTime&
         if (timeDiff <= toleranceMs && rangeDiff <= rangeTolerance)
         {
             rtwSymbols.erase(it);
+            ++annotationRevision;
             qDebug() << "WaterfallData: Removed RTW symbol" << symbolName << "at timestamp" << timestamp.toString() << "with range" << range;
             return true;
         }
@@ -804,6 +1610,7 @@ void WaterfallData::addBTWSymbol(const QString& symbolName, const QDateTime& tim
     symbolData.range = range;
     
     btwSymbols.push_back(symbolData);
+    ++annotationRevision;
     
     qDebug() << "WaterfallData: Added BTW symbol" << symbolName << "at timestamp" << timestamp.toString() << "with range" << range;
 }
@@ -811,6 +1618,7 @@ void WaterfallData::addBTWSymbol(const QString& symbolName, const QDateTime& tim
 void WaterfallData::clearBTWSymbols()
 {
     btwSymbols.clear();
+    ++annotationRevision;
     qDebug() << "WaterfallData: Cleared all BTW symbols";
 }
 
@@ -834,6 +1642,7 @@ void WaterfallData::addBTWMarker(const QDateTime& timestamp, qreal range, qreal
     markerData.delta = delta;
     
     btwMarkers.push_back(markerData);
+    ++annotationRevision;
     
     qDebug() << "WaterfallData: Added BTW marker at timestamp" << timestamp.toString() << "with range" << range << "and delta" << delta;
 }
@@ -841,6 +1650,7 @@ void WaterfallData::addBTWMarker(const QDateTime& timestamp, qreal range, qreal
 void WaterfallData::clearBTWMarkers()
 {
     btwMarkers.clear();
+    ++annotationRevision;
     qDebug() << "WaterfallData: Cleared all BTW markers";
 }
 
@@ -855,6 +1665,7 @@ bool WaterfallData::removeBTWMarker(const QDateTime& timestamp, qreal range, qre
         if (timeDiff <= toleranceMs && rangeDiff <= rangeTolerance)
         {
             btwMarkers.erase(it);
+            ++annotationRevision;
             qDebug() << "WaterfallData: Removed BTW marker at timestamp" << timestamp.toString() << "with range" << range;
             return true;
         }
@@ -882,6 +1693,7 @@ void WaterfallData::addRTWRMarker(const QDateTime& timestamp, qreal range)
     markerData.range = range;
     
     rtwRMarkers.push_back(markerData);
+    ++annotationRevision;
     
     qDebug() << "WaterfallData: Added RTW R marker at timestamp" << timestamp.toString() << "with range" << range;
 }
@@ -889,6 +1701,7 @@ void WaterfallData::addRTWRMarker(const QDateTime& timestamp, qreal range)
 void WaterfallData::clearRTWRMarkers()
 {
     rtwRMarkers.clear();
+    ++annotationRevision;
     qDebug() << "WaterfallData: Cleared all RTW R markers";
 }
 
@@ -903,6 +1716,7 @@ bool WaterfallData::removeRTWRMarker(const QDateTime& timestamp, qreal range, qr
         if (timeDiff <= toleranceMs && rangeDiff <= rangeTolerance)
         {
             rtwRMarkers.erase(it);
+            ++annotationRevision;
             qDebug() << "WaterfallData: Removed RTW R marker at timestamp" << timestamp.toString() << "with range" << range;
             return true;
         }
@@ -920,3 +1734,13 @@ size_t WaterfallData::getRTWRMarkersCount() const
 {
     return rtwRMarkers.size();
 }
+
+/**
+ * @brief Get the revision of the symbols and markers, bumped by every change to any of them.
+ *
+ * @return quint64 Revision, 0 until the first change
+ */
+quint64 WaterfallData::getAnnotationRevision() const
+{
+    return annotationRevision;
+}
@@ -8,6 +8,8 @@
 #include <QTime>
 #include <QDebug>
 #include <QString>
+#include "rangeminmaxtree.h"
+#include "seriesregistry.h"
 
 // Forward declaration for RTW symbols
 struct RTWSymbolData
@@ -40,6 +42,138 @@ struct RTWRMarkerData
     qreal range; // Y-axis position (range value)
 };
 
+// Read-only, non-owning view over a contiguous, time-ordered slice of a series
+// Valid until the series is next modified
+struct WaterfallSeriesView
+{
+    const qint64 *timestampsMs = nullptr;
+    const qreal *yData = nullptr;
+    size_t count = 0;
+    size_t firstIndex = 0; // Index of the first sample of the view within the series
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+};
+
+// One series worth of samples for WaterfallData::addDataBatch, as non-owning epoch-ms and
+// value columns of equal length; the pointed-to data only needs to outlive the call
+struct WaterfallSeriesBatch
+{
+    QString seriesLabel;
+    const qint64 *timestampsMs = nullptr;
+    const qreal *yData = nullptr;
+    size_t count = 0;
+};
+
+// Retention policy for a data series; a zero limit means unlimited
+struct WaterfallRetentionPolicy
+{
+    qint64 maxAgeMs = 0;   // Samples older than (newest sample - maxAgeMs) are evicted
+    size_t maxSamples = 0; // Oldest samples beyond this count are evicted
+
+    bool isUnlimited() const { return maxAgeMs <= 0 && maxSamples == 0; }
+};
+
+// Pre-aggregated bucket of one level-of-detail level
+struct WaterfallLodBucket
+{
+    qint64 startMs = 0; // Bucket start, aligned to a multiple of the level bucket size
+    qint64 firstMs = 0;
+    qint64 minMs = 0;
+    qint64 maxMs = 0;
+    qint64 lastMs = 0;
+    qreal first = 0.0;
+    qreal min = 0.0;
+    qreal max = 0.0;
+    qreal last = 0.0;
+    size_t count = 0;
+
+    void add(qint64 timestampMs, qreal value);
+};
+
+// One level of a series level-of-detail pyramid (time-ordered buckets of a fixed size)
+struct WaterfallLodLevel
+{
+    qint64 bucketMs = 0;
+    std::vector<WaterfallLodBucket> buckets;
+    size_t head = 0;         // Index of the oldest live bucket
+    bool frontStale = false; // Oldest live bucket still aggregates evicted samples
+};
+
+// Columnar storage for a single data series
+// Timestamps are kept as milliseconds since epoch; QDateTime is only built at the API edge
+// Samples are kept in ascending time order so time windows can be found by binary search
+// Evicted samples are dropped from the front by advancing head; the dead prefix is compacted
+// once it is as large as the live window, so the live samples always stay contiguous
+struct WaterfallSeriesColumns
+{
+    std::vector<qint64> timestampsMs;
+    std::vector<qreal> yData;
+    size_t head = 0; // Index of the oldest live sample
+    WaterfallRetentionPolicy retention;
+    bool present = false; // Slot holds a series of its WaterfallData (see WaterfallData::seriesById)
+
+    // Running Y extents, updated in O(1) on append and recomputed lazily
+    // only after an evicted sample touched one of them
+    mutable qreal yMinCached = 0.0;
+    mutable qreal yMaxCached = 0.0;
+    mutable bool yExtentsValid = false;
+
+    // Min/max segment tree over the physical yData buffer for windowed Y range queries
+    // Extended in O(log n) on in-order appends; rebuilt lazily after inserts, sorts or compaction
+    mutable RangeMinMaxTree yTree;
+    mutable bool yTreeValid = false;
+
+    // Level-of-detail pyramid, built on first use and then folded forward on in-order appends
+    // Rebuilt lazily after inserts or sorts; evictions drop whole buckets and flag the front one
+    mutable std::vector<WaterfallLodLevel> lodLevels;
+    mutable size_t lodFoldedEnd = 0; // Physical index of the first sample not folded into the pyramid
+    mutable bool lodValid = false;
+
+    size_t size() const { return timestampsMs.size() - head; }
+    bool empty() const { return size() == 0; }
+    WaterfallSeriesView view() const;
+    void dropFront(size_t count);
+    void compact();
+    void clear();
+
+    void noteAppended(const qreal* values, size_t count);
+    std::pair<qreal, qreal> yExtents() const;
+    std::pair<qreal, qreal> yExtents(size_t first, size_t last) const; // Live indices, half-open
+    std::pair<qint64, qint64> timeExtentsMs() const; // Time ordered: first and last live samples
+
+    void refreshLod() const;
+    void foldLod(size_t first, size_t last) const;
+};
+
+// Dense time x bin matrix of an intensity (spectrogram) series
+// Rows of binCount intensities are kept in a ring of rowCapacity rows: once it is full each new
+// row overwrites the oldest, so ingest never allocates. Rows are indexed logically, oldest first,
+// and must arrive in time order. The bins are spread evenly over [binStart, binEnd] of the value
+// axis, so intensity series share the value and time mapping of the line and scatter series.
+struct WaterfallIntensitySeries
+{
+    int binCount = 0;
+    size_t rowCapacity = 0;
+    qreal binStart = 0.0; // Value-axis position of the leading edge of bin 0
+    qreal binEnd = 0.0;   // Value-axis position of the trailing edge of the last bin
+    std::vector<float> values;        // rowCapacity * binCount intensities, one physical row after another
+    std::vector<qint64> timestampsMs; // rowCapacity row times
+    size_t head = 0;  // Physical index of the oldest row
+    size_t count = 0; // Number of live rows
+    bool present = false; // Slot holds a series of its WaterfallData (see WaterfallData::intensityById)
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    size_t physicalRow(size_t row) const { return (head + row) % rowCapacity; }
+    const float *row(size_t row) const { return values.data() + physicalRow(row) * binCount; }
+    qint64 rowTimeMs(size_t row) const { return timestampsMs[physicalRow(row)]; }
+    size_t upperBound(qint64 timestampMs) const; // First row later than timestampMs
+
+    void appendRow(qint64 timestampMs, const float* bins);
+    void clear();
+};
+
 class WaterfallData
 {
 public:
@@ -79,10 +213,22 @@ public:
     void setDataTitle(const QString& title) { dataTitle = title; }
     QString getDataTitle() const { return dataTitle; }
 
+    // Retention policy methods (default applies to every series, per-series overrides it)
+    void setRetentionPolicy(const WaterfallRetentionPolicy& policy);
+    WaterfallRetentionPolicy getRetentionPolicy() const;
+    void setSeriesRetentionPolicy(const QString& seriesLabel, const WaterfallRetentionPolicy& policy);
+    WaterfallRetentionPolicy getSeriesRetentionPolicy(const QString& seriesLabel) const;
+
     // Multiple data series methods
     void addDataSeries(const QString& seriesLabel, const std::vector<qreal>& yData, const std::vector<QDateTime>& timestamps);
     void addDataPointToSeries(const QString& seriesLabel, qreal yValue, const QDateTime& timestamp);
+    void addDataPointToSeries(const QString& seriesLabel, qreal yValue, qint64 timestampMs);
     void addDataPointsToSeries(const QString& seriesLabel, const std::vector<qreal>& yValues, const std::vector<QDateTime>& timestamps);
+
+    // Bulk ingest straight from epoch-ms columns, without building a QDateTime per sample
+    void addDataPointsToSeries(const QString& seriesLabel, const qreal* yValues, const qint64* timestampsMs, size_t count);
+    void addDataPointsToSeries(const QString& seriesLabel, std::vector<qreal>&& yValues, std::vector<qint64>&& timestampsMs);
+    void addDataBatch(const std::vector<WaterfallSeriesBatch>& batch);
     void clearDataSeries(const QString& seriesLabel);
     void clearAllDataSeries();
 
@@ -91,9 +237,23 @@ public:
     std::vector<std::pair<qreal, QDateTime>> getDataSeriesWithinYExtents(const QString& seriesLabel, qreal yMin, qreal yMax) const;
     std::vector<std::pair<qreal, QDateTime>> getDataSeriesWithinTimeRange(const QString& seriesLabel, const QDateTime& startTime, const QDateTime& endTime) const;
 
-    // Direct access to data series vectors
-    const std::vector<qreal>& getYDataSeries(const QString& seriesLabel) const;
-    const std::vector<QDateTime>& getTimestampsSeries(const QString& seriesLabel) const;
+    // Copies of the live data series columns (prefer getDataSeriesView on hot paths)
+    std::vector<qreal> getYDataSeries(const QString& seriesLabel) const;
+    std::vector<qint64> getTimestampsMsSeries(const QString& seriesLabel) const;
+
+    // Timestamps converted to QDateTime (allocates, prefer getDataSeriesView on hot paths)
+    std::vector<QDateTime> getTimestampsSeries(const QString& seriesLabel) const;
+
+    // Zero-copy time-window views (binary search over the time-ordered columns)
+    WaterfallSeriesView getDataSeriesView(const QString& seriesLabel) const;
+    WaterfallSeriesView getDataSeriesView(const QString& seriesLabel, qint64 startMs, qint64 endMs) const;
+    WaterfallSeriesView getDataSeriesView(const QString& seriesLabel, const QDateTime& startTime, const QDateTime& endTime) const;
+
+    // Level-of-detail access: fills time-ordered first/min/max/last vertices of the coarsest
+    // pyramid level whose bucket is at most maxBucketMs; returns that bucket size, or 0 if none fits
+    static const std::vector<qint64>& getLodBucketSizesMs();
+    qint64 getLodSeries(const QString& seriesLabel, qint64 startMs, qint64 endMs, qint64 maxBucketMs,
+                        std::vector<qint64>& timestampsMs, std::vector<qreal>& yData) const;
 
     // Data series utility methods
     size_t getDataSeriesSize(const QString& seriesLabel) const;
@@ -101,8 +261,29 @@ public:
     bool hasDataSeries(const QString& seriesLabel) const;
     std::vector<QString> getDataSeriesLabels() const;
 
+    // Interned-ID access for hot paths (IDs come from SeriesRegistry or getDataSeriesIds)
+    const std::vector<int>& getDataSeriesIds() const { return seriesIds; } // Ordered by label
+    bool hasDataSeries(int seriesId) const;
+    size_t getDataSeriesSize(int seriesId) const;
+    WaterfallSeriesView getDataSeriesView(int seriesId) const;
+    WaterfallSeriesView getDataSeriesView(int seriesId, qint64 startMs, qint64 endMs) const;
+    qint64 getLodSeries(int seriesId, qint64 startMs, qint64 endMs, qint64 maxBucketMs,
+                        std::vector<qint64>& timestampsMs, std::vector<qreal>& yData) const;
+    void addDataPointToSeries(int seriesId, qreal yValue, qint64 timestampMs);
+    void addDataPointsToSeries(int seriesId, const qreal* yValues, const qint64* timestampsMs, size_t count);
+
+    // Intensity (spectrogram) series: (re)configuring a series drops its rows
+    void setIntensitySeries(const QString& seriesLabel, int binCount, size_t rowCapacity, qreal binStart, qreal binEnd);
+    bool addIntensityRow(int seriesId, qint64 timestampMs, const float* bins, size_t binCount); // false if rejected
+    void clearIntensitySeries(const QString& seriesLabel);
+    const std::vector<int>& getIntensitySeriesIds() const { return intensityIds; } // Ordered by label
+    bool hasIntensitySeries(int seriesId) const;
+    const WaterfallIntensitySeries* getIntensitySeries(int seriesId) const;
+    const WaterfallIntensitySeries* getIntensitySeries(const QString& seriesLabel) const;
+
     // Data series range methods
     std::pair<qreal, qreal> getYRangeSeries(const QString& seriesLabel) const;
+    bool getYRangeSeriesInTimeRange(const QString& seriesLabel, qint64 startMs, qint64 endMs, std::pair<qreal, qreal>& range) const;
     std::pair<QDateTime, QDateTime> getTimeRangeSeries(const QString& seriesLabel) const;
 
     // Series-specific versions of legacy methods
@@ -118,6 +299,7 @@ public:
 
     // Combined range methods for all series
     std::pair<qreal, qreal> getCombinedYRange() const;
+    bool getCombinedYRangeInTimeRange(qint64 startMs, qint64 endMs, std::pair<qreal, qreal>& range) const;
     std::pair<QDateTime, QDateTime> getCombinedTimeRange() const;
 
     // Data binning methods for sampling
@@ -129,6 +311,16 @@ public:
         const std::vector<QDateTime>& timestamps, 
         const QTime& binDuration
     );
+    static std::vector<std::pair<qreal, qint64>> binDataByTimeMs(
+        const std::vector<qreal>& yData,
+        const std::vector<qint64>& timestampsMs,
+        qint64 binSizeMs
+    );
+    static std::vector<std::pair<qreal, qint64>> binDataByTimeMs(
+        const WaterfallSeriesView& view,
+        qint64 binSizeMs,
+        qint64 anchorMs
+    );
 
     // RTW Symbol management methods (stored with track data)
     void addRTWSymbol(const QString& symbolName, const QDateTime& timestamp, qreal range);
@@ -157,11 +349,19 @@ public:
     std::vector<RTWRMarkerData> getRTWRMarkers() const;
     size_t getRTWRMarkersCount() const;
 
+    // Bumped by every add, remove or clear of a symbol or marker
+    quint64 getAnnotationRevision() const;
+
 private:
 
-    // Multiple data series storage
-    std::map<QString, std::vector<qreal>> dataSeriesYData;
-    std::map<QString, std::vector<QDateTime>> dataSeriesTimestamps;
+    // Multiple data series storage, indexed by interned series ID (see SeriesRegistry)
+    // Slots of series this data source does not hold stay empty with present == false
+    std::vector<WaterfallSeriesColumns> seriesById;
+    std::vector<int> seriesIds; // IDs of the present series, ordered by label
+
+    // Intensity series storage, indexed by interned series ID like seriesById
+    std::vector<WaterfallIntensitySeries> intensityById;
+    std::vector<int> intensityIds; // IDs of the present intensity series, ordered by label
 
     // RTW Symbol storage (persists with track data)
     std::vector<RTWSymbolData> rtwSymbols;
@@ -175,13 +375,26 @@ private:
     // RTW R Marker storage (manually placed markers)
     std::vector<RTWRMarkerData> rtwRMarkers;
 
+    // Revision of the four annotation stores above
+    quint64 annotationRevision = 0;
+
     // Data title
     QString dataTitle;
 
+    // Retention policy given to newly created series
+    WaterfallRetentionPolicy defaultRetentionPolicy;
+
     // Helper methods
     bool isValidIndex(size_t index) const;
     void validateDataConsistency() const;
     void validateDataSeriesConsistency(const QString& seriesLabel) const;
+    void validateDataSeriesConsistency(int seriesId) const;
+    const WaterfallSeriesColumns* findSeries(int seriesId) const;
+    const WaterfallSeriesColumns* findSeries(const QString& seriesLabel) const;
+    WaterfallSeriesColumns& getOrCreateSeries(int seriesId);
+    WaterfallSeriesColumns& getOrCreateSeries(const QString& seriesLabel);
+    static void restoreTimeOrder(WaterfallSeriesColumns& columns, size_t firstNewIndex);
+    static size_t applyRetention(WaterfallSeriesColumns& columns);
 };
 
 #endif // WATERFALLDATA_H
@@ -1,7 +1,16 @@
 #include "waterfallgraph.h"
+#include "cursorframescheduler.h"
+#include "uilogging.h"
+#include "perfcounters.h"
 #include "waterfalldata.h"  // For BTWSymbolData
 #include <QApplication>
 #include <QPointF>
+#include <QtConcurrent>
+#include <QtMath>
+#include <QPainter>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 
 /**
  * @brief Construct a new WaterfallGraph::WaterfallGraph object
@@ -19,13 +28,14 @@ WaterfallGraph::WaterfallGraph(QWidget *parent, bool enableGrid, int gridDivisio
     overlayScene(nullptr),
     cursorView(nullptr),
     cursorScene(nullptr),
-    cursorUpdateTimer(nullptr),
     cursorCrosshairHorizontal(nullptr),
     cursorCrosshairVertical(nullptr),
     cursorTimeAxisLine(nullptr),
     m_cursorSyncState(nullptr),
     m_lastMousePos(QPointF()),
     m_cursorLayerEnabled(true), 
+    m_cursorLayerDirty(true),
+    m_drawnCursorRevision(0),
     gridEnabled(enableGrid), 
     gridDivisions(gridDivisions), 
     yMin(0.0), 
@@ -36,13 +46,15 @@ WaterfallGraph::WaterfallGraph(QWidget *parent, bool enableGrid, int gridDivisio
     rangeLimitingEnabled(true), 
     customYMin(0.0), 
     customYMax(0.0), 
+    m_autoYRangeHeld(false),
+    m_heldYMin(0.0),
+    m_heldYMax(0.0),
     customTimeRangeEnabled(false), 
     customTimeMin(QDateTime()), 
     customTimeMax(QDateTime()), 
     timeInterval(timeInterval), 
     dataSource(nullptr), 
     isDragging(false), 
-    isDrawing(false),
     crosshairHorizontal(nullptr), 
     crosshairVertical(nullptr), 
     crosshairEnabled(true), 
@@ -55,6 +67,18 @@ WaterfallGraph::WaterfallGraph(QWidget *parent, bool enableGrid, int gridDivisio
     lastNotifiedCrosshairXPosition(-1.0),
     m_renderState(RenderState::FULL_REDRAW),
     m_rangeUpdateNeeded(false),
+    m_sceneRenderKeyValid(false),
+    m_sceneTimeMaxMs(0),
+    m_screenTransformValid(false),
+    m_rasterRenderingEnabled(false),
+    m_rasterPassOpen(false),
+    m_rasterJobPending(false),
+    m_rasterWatcher(nullptr),
+    m_rasterItem(nullptr),
+    m_scrollingBitmapEnabled(false),
+    m_bitmapValid(false),
+    m_bitmapTopMs(0.0),
+    m_bitmapTopRow(0),
     m_zeroAxisValue(0.0)
 {
     // Remove all margins and padding for snug fit
@@ -213,10 +237,8 @@ WaterfallGraph::WaterfallGraph(QWidget *parent, bool enableGrid, int gridDivisio
     cursorTimeAxisLine->setVisible(false);
     cursorScene->addItem(cursorTimeAxisLine);
 
-    // Create cursor update timer (60fps = ~16ms)
-    cursorUpdateTimer = new QTimer(this);
-    cursorUpdateTimer->setInterval(16); // 60fps
-    connect(cursorUpdateTimer, &QTimer::timeout, this, &WaterfallGraph::updateCursorLayer);
+    // Cursor layer repaints are requested by events and coalesced across graphs per frame
+    CursorFrameScheduler::instance()->registerGraph(this);
 
     // Debug: Print initial state
     qDebug() << "WaterfallGraph constructor - mouseSelectionEnabled:" << mouseSelectionEnabled;
@@ -250,11 +272,7 @@ WaterfallGraph::~WaterfallGraph()
     }
 
     // Clean up cursor layer
-    if (cursorUpdateTimer) {
-        cursorUpdateTimer->stop();
-        delete cursorUpdateTimer;
-        cursorUpdateTimer = nullptr;
-    }
+    CursorFrameScheduler::instance()->unregisterGraph(this);
     if (cursorCrosshairHorizontal) {
         delete cursorCrosshairHorizontal;
         cursorCrosshairHorizontal = nullptr;
@@ -287,6 +305,7 @@ WaterfallGraph::~WaterfallGraph()
 void WaterfallGraph::setDataSource(WaterfallData &dataSource)
 {
     this->dataSource = &dataSource;
+    m_autoYRangeHeld = false;
     // New data source requires full redraw (automatically marks all series dirty)
     setRenderState(RenderState::FULL_REDRAW);
     draw(); // Trigger redraw with new data source
@@ -383,16 +402,17 @@ void WaterfallGraph::addDataPoint(const QString &seriesLabel, qreal yValue, cons
 {
     if (!dataSource)
     {
-        qDebug() << "Error: No data source set";
+        UI_WARNING(lcWaterfallData) << "Error: No data source set";
         return;
     }
 
-    dataSource->addDataPointToSeries(seriesLabel, yValue, timestamp);
+    const int seriesId = SeriesRegistry::intern(seriesLabel);
+    dataSource->addDataPointToSeries(seriesId, yValue, timestamp.toMSecsSinceEpoch());
 
-    qDebug() << "Data point added. New size:" << dataSource->getDataSeriesSize(seriesLabel);
+    UI_DEBUG(lcWaterfallData) << "Data point added. New size:" << dataSource->getDataSeriesSize(seriesId);
 
     // Mark series as dirty and range update needed
-    markSeriesDirty(seriesLabel);
+    markSeriesDirty(seriesId);
     markRangeUpdateNeeded();
     dataRangesValid = false;
 
@@ -410,16 +430,16 @@ void WaterfallGraph::addDataPoints(const QString &seriesLabel, const std::vector
 {
     if (!dataSource)
     {
-        qDebug() << "Error: No data source set";
+        UI_WARNING(lcWaterfallData) << "Error: No data source set";
         return;
     }
 
     dataSource->addDataPointsToSeries(seriesLabel, yValues, timestamps);
 
-    qDebug() << "Data points added. New size:" << dataSource->getDataSeriesSize(seriesLabel);
+    UI_DEBUG(lcWaterfallData) << "Data points added. New size:" << dataSource->getDataSeriesSize(seriesLabel);
 
     // Mark series as dirty and range update needed
-    markSeriesDirty(seriesLabel);
+    markSeriesDirty(SeriesRegistry::find(seriesLabel));
     markRangeUpdateNeeded();
     dataRangesValid = false;
 
@@ -427,6 +447,98 @@ void WaterfallGraph::addDataPoints(const QString &seriesLabel, const std::vector
     drawIncremental();
 }
 
+/**
+ * @brief Create an intensity series, or reconfigure it and drop its rows.
+ *
+ * @param seriesLabel The label of the series
+ * @param binCount Intensities per row
+ * @param rowCapacity Rows kept before the oldest are overwritten
+ * @param binStart Value-axis position of the leading edge of the first bin
+ * @param binEnd Value-axis position of the trailing edge of the last bin
+ */
+void WaterfallGraph::setIntensitySeries(const QString &seriesLabel, int binCount, size_t rowCapacity, qreal binStart, qreal binEnd)
+{
+    if (!dataSource)
+    {
+        UI_WARNING(lcWaterfallData) << "Error: No data source set";
+        return;
+    }
+
+    dataSource->setIntensitySeries(seriesLabel, binCount, rowCapacity, binStart, binEnd);
+
+    markSeriesDirty(SeriesRegistry::intern(seriesLabel));
+    markRangeUpdateNeeded();
+    dataRangesValid = false;
+    drawIncremental();
+}
+
+/**
+ * @brief Add one row of intensities to an intensity series.
+ *
+ * @param seriesLabel The label of a series created by setIntensitySeries
+ * @param timestamp Row time
+ * @param bins One intensity per bin
+ */
+void WaterfallGraph::addIntensityRow(const QString &seriesLabel, const QDateTime &timestamp, const std::vector<float> &bins)
+{
+    addIntensityRow(seriesLabel, timestamp.toMSecsSinceEpoch(), bins.data(), bins.size());
+}
+
+void WaterfallGraph::addIntensityRow(const QString &seriesLabel, qint64 timestampMs, const float *bins, size_t binCount)
+{
+    if (!dataSource)
+    {
+        UI_WARNING(lcWaterfallData) << "Error: No data source set";
+        return;
+    }
+
+    const int seriesId = SeriesRegistry::intern(seriesLabel);
+    if (!dataSource->addIntensityRow(seriesId, timestampMs, bins, binCount))
+    {
+        return;
+    }
+
+    // Mark series as dirty and range update needed
+    markSeriesDirty(seriesId);
+    markRangeUpdateNeeded();
+    dataRangesValid = false;
+
+    drawIncremental();
+}
+
+/**
+ * @brief Set the intensities mapped to the ends of the colour map for an intensity series.
+ *
+ * @param seriesLabel The label of the series
+ * @param levelMin Intensity drawn with the first colour (and below)
+ * @param levelMax Intensity drawn with the last colour (and above)
+ */
+void WaterfallGraph::setIntensityLevels(const QString &seriesLabel, float levelMin, float levelMax)
+{
+    const int seriesId = SeriesRegistry::intern(seriesLabel);
+    SeriesSlot &slot = seriesSlot(seriesId);
+    slot.intensityLevelMin = levelMin;
+    slot.intensityLevelMax = levelMax;
+    drawIntensitySeries(seriesId);
+}
+
+/**
+ * @brief Set the colour map of the intensity series.
+ *
+ * @param colorMap Colour lookup table, e.g. IntensityColorMap::sonar()
+ */
+void WaterfallGraph::setIntensityColorMap(const IntensityColorMap &colorMap)
+{
+    m_intensityColorMap = colorMap;
+    if (dataSource)
+    {
+        for (int seriesId : dataSource->getIntensitySeriesIds())
+        {
+            drawIntensitySeries(seriesId);
+        }
+    }
+}
+
 /**
  * @brief Get data within specified y extents.
  *
@@ -460,31 +572,43 @@ std::vector<std::pair<qreal, QDateTime>> WaterfallGraph::getDataWithinTimeRange(
 }
 
 /**
- * @brief Get direct access to y data vector.
+ * @brief Get a copy of the live y data of a series.
  *
- * @return const std::vector<qreal>&
+ * @return std::vector<qreal>
  */
-const std::vector<qreal> &WaterfallGraph::getYData(const QString &seriesLabel) const
+std::vector<qreal> WaterfallGraph::getYData(const QString &seriesLabel) const
 {
-    static const std::vector<qreal> emptyVector;
     if (!dataSource)
     {
-        return emptyVector;
+        return std::vector<qreal>();
     }
     return dataSource->getYDataSeries(seriesLabel);
 }
 
 /**
- * @brief Get direct access to timestamps vector.
+ * @brief Get a copy of the live timestamps of a series (ms since epoch).
+ *
+ * @return std::vector<qint64>
+ */
+std::vector<qint64> WaterfallGraph::getTimestampsMs(const QString &seriesLabel) const
+{
+    if (!dataSource)
+    {
+        return std::vector<qint64>();
+    }
+    return dataSource->getTimestampsMsSeries(seriesLabel);
+}
+
+/**
+ * @brief Get the timestamps of a series converted to QDateTime.
  *
- * @return const std::vector<QDateTime>&
+ * @return std::vector<QDateTime>
  */
-const std::vector<QDateTime> &WaterfallGraph::getTimestamps(const QString &seriesLabel) const
+std::vector<QDateTime> WaterfallGraph::getTimestamps(const QString &seriesLabel) const
 {
-    static const std::vector<QDateTime> emptyVector;
     if (!dataSource)
     {
-        return emptyVector;
+        return std::vector<QDateTime>();
     }
     return dataSource->getTimestampsSeries(seriesLabel);
 }
@@ -644,6 +768,7 @@ void WaterfallGraph::onMouseDrag(const QPointF &scenePos)
  */
 void WaterfallGraph::draw()
 {
+    PERF_SCOPE("WaterfallGraph::draw");
     if (!graphicsScene)
         return;
 
@@ -654,15 +779,46 @@ void WaterfallGraph::draw()
     drawIncremental();
 }
 
+/**
+ * @brief Redraw after series changed in the data source, appending to what is drawn.
+ *
+ * Only the given series are extended (or rebuilt when they cannot be); the scene is
+ * cleared only if the screen mapping changed.
+ *
+ * @param seriesIds Interned IDs of the series that changed
+ */
+void WaterfallGraph::drawChangedSeries(const std::set<int> &seriesIds)
+{
+    PERF_SCOPE("WaterfallGraph::drawChangedSeries");
+    if (!graphicsScene)
+        return;
+
+    for (int seriesId : seriesIds)
+    {
+        markSeriesDirty(seriesId);
+    }
+    markRangeUpdateNeeded();
+    dataRangesValid = false;
+
+    drawIncremental();
+}
+
 /**
  * @brief Incremental draw method that only redraws dirty series.
  *
  */
 void WaterfallGraph::drawIncremental()
 {
+    PERF_SCOPE("WaterfallGraph::drawIncremental");
     if (!graphicsScene)
         return;
 
+    // Any pass other than CLEAN may move timeMax or the mapping under the time axis line
+    if (m_renderState != RenderState::CLEAN && m_cursorSyncState && m_cursorSyncState->hasCursorTime)
+    {
+        requestCursorFrame();
+    }
+
     switch (m_renderState)
     {
         case RenderState::CLEAN:
@@ -689,31 +845,84 @@ void WaterfallGraph::drawIncremental()
                 m_rangeUpdateNeeded = false;
             }
 
-            // Redraw only dirty series
+            // A range or geometry change moves every sample on screen, so all series must be redrawn.
+            // Raster passes always cover every series, as they produce a single image.
+            if (m_rasterRenderingEnabled || !m_sceneRenderKeyValid || !(currentRenderKey() == m_sceneRenderKey))
+            {
+                UI_DEBUG(lcWaterfallDraw) << "drawIncremental: Screen mapping changed, falling back to full redraw";
+                setRenderState(RenderState::FULL_REDRAW);
+                drawIncremental();
+                return;
+            }
+
+            // Intensity series are rendered whole when rows arrived or the window moved
+            if (dataSource && !dataSource->getIntensitySeriesIds().empty())
+            {
+                const bool windowMoved = timeMax.isValid() && timeMax.toMSecsSinceEpoch() != m_sceneTimeMaxMs;
+                for (int seriesId : dataSource->getIntensitySeriesIds())
+                {
+                    if (windowMoved || seriesSlot(seriesId).dirty)
+                    {
+                        drawIntensitySeries(seriesId);
+                    }
+                }
+            }
+
+            // Scrolling bitmap: shift by the elapsed rows and paint only the samples that arrived
+            if (m_scrollingBitmapEnabled)
+            {
+                if (!scrollScrollingBitmap())
+                {
+                    UI_DEBUG(lcWaterfallDraw) << "drawIncremental: Scrolling bitmap cannot be scrolled, re-rasterizing";
+                    setRenderState(RenderState::FULL_REDRAW);
+                    drawIncremental();
+                    return;
+                }
+                for (int seriesId : m_dirtySeries)
+                {
+                    m_seriesSlots[seriesId].dirty = false;
+                }
+                m_dirtySeries.clear();
+                m_sceneTimeMaxMs = timeMax.toMSecsSinceEpoch();
+                m_renderState = RenderState::CLEAN;
+                rebuildDecorations();
+                break;
+            }
+
+            // Follow mode: when the window slid, every series is scrolled and trimmed, not only the dirty ones
+            if (timeMax.isValid() && timeMax.toMSecsSinceEpoch() != m_sceneTimeMaxMs && dataSource)
+            {
+                for (int seriesId : dataSource->getDataSeriesIds())
+                {
+                    addDirtySeries(seriesId);
+                }
+                m_sceneTimeMaxMs = timeMax.toMSecsSinceEpoch();
+            }
+
+            // Append only the newly arrived samples of dirty series, rebuilding a series only when that is not possible
             if (dataSource && !dataSource->isEmpty() && dataRangesValid)
             {
-                for (const QString &seriesLabel : m_dirtySeries)
+                for (int seriesId : m_dirtySeries)
                 {
-                    if (isSeriesVisible(seriesLabel))
+                    if (isSeriesVisible(seriesId) && dataSource->hasDataSeries(seriesId) && !appendDataSeries(seriesId))
                     {
-                        drawDataSeries(seriesLabel);
+                        drawDataSeries(seriesId);
                     }
                 }
             }
 
+            for (int seriesId : m_dirtySeries)
+            {
+                m_seriesSlots[seriesId].dirty = false;
+            }
             m_dirtySeries.clear();
             m_renderState = RenderState::CLEAN;
+            rebuildDecorations();
             break;
 
         case RenderState::FULL_REDRAW:
             // Clear scene and graphics item maps
-            graphicsScene->clear();
-            m_seriesPathItems.clear();
-            for (auto &pair : m_seriesPointItems)
-            {
-                pair.second.clear();
-            }
-            m_seriesPointItems.clear();
+            clearGraphicsScene();
 
             // Update drawing area and grid
             setupDrawingArea();
@@ -730,24 +939,176 @@ void WaterfallGraph::drawIncremental()
             m_rangeUpdateNeeded = false;
 
             // Redraw all series
-            if (dataSource && !dataSource->isEmpty() && dataRangesValid)
+            if (m_scrollingBitmapEnabled)
+            {
+                rebuildScrollingBitmap();
+            }
+            else if (dataSource && !dataSource->isEmpty() && dataRangesValid)
             {
-                std::vector<QString> allSeries = dataSource->getDataSeriesLabels();
-                for (const QString &seriesLabel : allSeries)
+                for (int seriesId : dataSource->getDataSeriesIds())
                 {
-                    if (isSeriesVisible(seriesLabel))
+                    if (isSeriesVisible(seriesId))
                     {
-                        drawDataSeries(seriesLabel);
+                        drawDataSeries(seriesId);
                     }
                 }
             }
+            if (dataSource)
+            {
+                for (int seriesId : dataSource->getIntensitySeriesIds())
+                {
+                    drawIntensitySeries(seriesId);
+                }
+            }
 
+            // Later appends can extend the series geometry as long as this mapping holds
+            m_sceneRenderKey = currentRenderKey();
+            m_sceneRenderKeyValid = dataRangesValid && timeMax.isValid();
+            m_sceneTimeMaxMs = timeMax.isValid() ? timeMax.toMSecsSinceEpoch() : 0;
+
+            for (int seriesId : m_dirtySeries)
+            {
+                m_seriesSlots[seriesId].dirty = false;
+            }
             m_dirtySeries.clear();
             m_renderState = RenderState::CLEAN;
+            rebuildDecorations();
             break;
     }
 }
 
+/**
+ * @brief Clear the main scene along with every reference to the items it held.
+ *
+ * Subclasses must use this instead of graphicsScene->clear() so that the stored
+ * series items and incremental rendering state never point at deleted items.
+ */
+void WaterfallGraph::clearGraphicsScene()
+{
+    if (!graphicsScene)
+        return;
+
+    graphicsScene->clear();
+    if (m_cursorSyncState && m_cursorSyncState->hasCursorTime)
+    {
+        requestCursorFrame(); // Subclass redraws recompute the mapping of the time axis line
+    }
+    for (SeriesSlot &slot : m_seriesSlots)
+    {
+        slot.pathItem = nullptr;
+        slot.pointItem = nullptr;
+        slot.intensityItem = nullptr;
+        slot.hasRenderCache = false;
+    }
+    m_decorationItems.clear();
+    m_sceneRenderKeyValid = false;
+
+    // A cleared scene starts a new draw pass; the last image stays up until its replacement is ready
+    m_rasterItem = nullptr;
+    m_bitmapValid = false;
+    if (m_rasterRenderingEnabled)
+    {
+        beginRasterPass();
+        showRasterImage();
+    }
+}
+
+/**
+ * @brief Remove the decorations of the previous pass and let the graph draw them again.
+ *
+ * Decorations are time-mapped like the series, but there are few of them, so they are
+ * rebuilt rather than scrolled.
+ */
+void WaterfallGraph::rebuildDecorations()
+{
+    for (QGraphicsItem *item : m_decorationItems)
+    {
+        delete item; // Removes it from the scene
+    }
+    m_decorationItems.clear();
+
+    if (graphicsScene)
+    {
+        drawDecorations();
+    }
+}
+
+/**
+ * @brief Draw the decorations of the graph over its series. The base graph has none.
+ *
+ */
+void WaterfallGraph::drawDecorations()
+{
+}
+
+/**
+ * @brief Add an item to the main scene as a decoration, removed by the next rebuildDecorations.
+ *
+ * @param item Item to add (ownership passes to the scene)
+ */
+void WaterfallGraph::addDecorationItem(QGraphicsItem *item)
+{
+    graphicsScene->addItem(item);
+    m_decorationItems.push_back(item);
+}
+
+/**
+ * @brief Get the style of a line/scatter series: a 2 px line with small hollow markers.
+ *
+ * @param seriesId The interned ID of the series
+ * @return SeriesStyle Style used by every draw path
+ */
+WaterfallGraph::SeriesStyle WaterfallGraph::seriesStyle(int seriesId) const
+{
+    const QColor seriesColor = getSeriesColor(seriesId);
+    SeriesStyle style;
+    style.linePen = QPen(seriesColor, 2);
+    style.markerPen = QPen(seriesColor, 0); // No stroke (width 0)
+    return style;
+}
+
+/**
+ * @brief Get the style shared by the graph types: the ADOPTED series is a line without
+ * points, every other series is a scatterplot of filled markers outlined in black.
+ *
+ * @param seriesId The interned ID of the series
+ * @return SeriesStyle Style used by every draw path
+ */
+WaterfallGraph::SeriesStyle WaterfallGraph::adoptedLineSeriesStyle(int seriesId) const
+{
+    const QColor seriesColor = getSeriesColor(seriesId);
+    SeriesStyle style;
+    if (seriesId == adoptedSeriesId())
+    {
+        style.linePen = QPen(seriesColor, 2);
+        style.drawMarkers = false;
+    }
+    else
+    {
+        style.drawLine = false;
+        style.markerPen = QPen(Qt::black, 0);
+        style.markerBrush = QBrush(seriesColor);
+        style.markerSize = 3.0;
+        style.markerZValue = 120; // Draw above data lines but below markers
+    }
+    return style;
+}
+
+/**
+ * @brief Get the screen mapping currently used by mapDataToScreen.
+ *
+ * @return RenderKey Y range, interval and drawing area
+ */
+WaterfallGraph::RenderKey WaterfallGraph::currentRenderKey() const
+{
+    RenderKey key;
+    key.yMin = yMin;
+    key.yMax = yMax;
+    key.intervalMs = getTimeIntervalMs();
+    key.drawingArea = drawingArea;
+    return key;
+}
+
 /**
  * @brief Transition to the appropriate state based on current conditions.
  *
@@ -766,11 +1127,16 @@ void WaterfallGraph::transitionToAppropriateState()
         m_renderState = RenderState::INCREMENTAL_UPDATE;
         return;
     }
-    
-    // Draw BTW symbols (magenta circles) if any exist in data source
-    drawBTWSymbols();
-    
-    isDrawing = false;
+
+    // If only ranges need update
+    if (m_rangeUpdateNeeded || !dataRangesValid)
+    {
+        m_renderState = RenderState::RANGE_UPDATE_ONLY;
+        return;
+    }
+
+    // Otherwise clean
+    m_renderState = RenderState::CLEAN;
 }
 
 /**
@@ -782,14 +1148,14 @@ void WaterfallGraph::drawBTWSymbols()
     // Follow the same pattern as RTW symbols - read symbols from dataSource
     if (!graphicsScene || !dataSource)
     {
-        qDebug() << "WaterfallGraph: drawBTWSymbols - no graphicsScene or dataSource";
+        UI_DEBUG(lcWaterfallDraw) << "WaterfallGraph: drawBTWSymbols - no graphicsScene or dataSource";
         return;
     }
     
     // Get symbols from dataSource
     std::vector<BTWSymbolData> btwSymbols = dataSource->getBTWSymbols();
     
-    qDebug() << "WaterfallGraph: drawBTWSymbols - found" << btwSymbols.size() << "BTW symbols in data source";
+    UI_DEBUG(lcWaterfallDraw) << "WaterfallGraph: drawBTWSymbols - found" << btwSymbols.size() << "BTW symbols in data source";
     
     if (btwSymbols.empty())
     {
@@ -800,7 +1166,7 @@ void WaterfallGraph::drawBTWSymbols()
     std::vector<BTWSymbolData> visibleSymbols;
     bool timeRangeValid = timeMin.isValid() && timeMax.isValid() && timeMin <= timeMax;
     
-    qDebug() << "WaterfallGraph: drawBTWSymbols - timeRangeValid:" << timeRangeValid 
+    UI_DEBUG(lcWaterfallDraw) << "WaterfallGraph: drawBTWSymbols - timeRangeValid:" << timeRangeValid 
              << "timeMin:" << (timeMin.isValid() ? timeMin.toString() : "invalid")
              << "timeMax:" << (timeMax.isValid() ? timeMax.toString() : "invalid");
     
@@ -814,7 +1180,7 @@ void WaterfallGraph::drawBTWSymbols()
             }
             else
             {
-                qDebug() << "WaterfallGraph: Symbol filtered out - timestamp" << symbolData.timestamp.toString() 
+                UI_DEBUG(lcWaterfallDraw) << "WaterfallGraph: Symbol filtered out - timestamp" << symbolData.timestamp.toString() 
                          << "not in range [" << timeMin.toString() << "," << timeMax.toString() << "]";
             }
         }
@@ -823,10 +1189,10 @@ void WaterfallGraph::drawBTWSymbols()
     {
         // If time range is not valid, show all symbols (they might be needed for initialization)
         visibleSymbols = btwSymbols;
-        qDebug() << "WaterfallGraph: Time range not valid, showing all" << visibleSymbols.size() << "symbols";
+        UI_DEBUG(lcWaterfallDraw) << "WaterfallGraph: Time range not valid, showing all" << visibleSymbols.size() << "symbols";
     }
     
-    qDebug() << "WaterfallGraph: drawBTWSymbols - drawing" << visibleSymbols.size() << "visible symbols";
+    UI_DEBUG(lcWaterfallDraw) << "WaterfallGraph: drawBTWSymbols - drawing" << visibleSymbols.size() << "visible symbols";
     
     int symbolsDrawn = 0;
     // Draw symbols using a simple magenta circle (we'll create it inline since BTWSymbolDrawing is BTW-specific)
@@ -835,13 +1201,13 @@ void WaterfallGraph::drawBTWSymbols()
         // Map symbol position to screen coordinates
         QPointF screenPos = mapDataToScreen(symbolData.range, symbolData.timestamp);
         
-        qDebug() << "WaterfallGraph: Symbol at timestamp" << symbolData.timestamp.toString() 
+        UI_DEBUG(lcWaterfallDraw) << "WaterfallGraph: Symbol at timestamp" << symbolData.timestamp.toString() 
                  << "range" << symbolData.range << "mapped to screen position" << screenPos;
         
         // Check if point is within visible area
         if (!drawingArea.contains(screenPos))
         {
-            qDebug() << "WaterfallGraph: Symbol filtered out - screen position" << screenPos 
+            UI_DEBUG(lcWaterfallDraw) << "WaterfallGraph: Symbol filtered out - screen position" << screenPos 
                      << "not in drawing area" << drawingArea;
             continue;
         }
@@ -854,22 +1220,12 @@ void WaterfallGraph::drawBTWSymbols()
         magentaCircle->setBrush(QBrush(QColor(255, 0, 255))); // Filled magenta
         magentaCircle->setZValue(1003); // Above markers but below interactive items
         
-        graphicsScene->addItem(magentaCircle);
+        addDecorationItem(magentaCircle);
         symbolsDrawn++;
-        qDebug() << "WaterfallGraph: Drew magenta circle at" << screenPos;
+        UI_DEBUG(lcWaterfallDraw) << "WaterfallGraph: Drew magenta circle at" << screenPos;
     }
     
-    qDebug() << "WaterfallGraph: drawBTWSymbols - drew" << symbolsDrawn << "magenta circles";
-
-    // If only ranges need update
-    if (m_rangeUpdateNeeded || !dataRangesValid)
-    {
-        m_renderState = RenderState::RANGE_UPDATE_ONLY;
-        return;
-    }
-
-    // Otherwise clean
-    m_renderState = RenderState::CLEAN;
+    UI_DEBUG(lcWaterfallDraw) << "WaterfallGraph: drawBTWSymbols - drew" << symbolsDrawn << "magenta circles";
 }
 
 /**
@@ -899,12 +1255,31 @@ void WaterfallGraph::setRenderState(RenderState newState)
  * @brief Mark a specific series as dirty.
  *
  */
-void WaterfallGraph::markSeriesDirty(const QString &seriesLabel)
+void WaterfallGraph::markSeriesDirty(int seriesId)
 {
-    m_dirtySeries.insert(seriesLabel);
+    addDirtySeries(seriesId);
     transitionToAppropriateState();
 }
 
+/**
+ * @brief Add a series to the dirty list unless it is already listed.
+ *
+ */
+void WaterfallGraph::addDirtySeries(int seriesId)
+{
+    if (seriesId < 0)
+    {
+        return;
+    }
+
+    SeriesSlot &slot = seriesSlot(seriesId);
+    if (!slot.dirty)
+    {
+        slot.dirty = true;
+        m_dirtySeries.push_back(seriesId);
+    }
+}
+
 /**
  * @brief Mark all series as dirty and set state to FULL_REDRAW.
  *
@@ -913,10 +1288,9 @@ void WaterfallGraph::markAllSeriesDirty()
 {
     if (dataSource && !dataSource->isEmpty())
     {
-        std::vector<QString> allSeries = dataSource->getDataSeriesLabels();
-        for (const QString &seriesLabel : allSeries)
+        for (int seriesId : dataSource->getDataSeriesIds())
         {
-            m_dirtySeries.insert(seriesLabel);
+            addDirtySeries(seriesId);
         }
     }
     m_renderState = RenderState::FULL_REDRAW;
@@ -1125,8 +1499,9 @@ void WaterfallGraph::mouseMoveEvent(QMouseEvent *event)
         }
     }
 
-    // Store mouse position for cursor layer (timer will handle rendering)
+    // Store mouse position for cursor layer (rendered with the next cursor frame)
     m_lastMousePos = event->pos();
+    requestCursorFrame();
 
     // Update crosshair if enabled (legacy overlay mode)
     if (crosshairEnabled && !m_cursorLayerEnabled && overlayScene && overlayView)
@@ -1188,11 +1563,7 @@ void WaterfallGraph::enterEvent(QEnterEvent *event)
         }
     }
     
-    // Ensure cursor layer timer is running
-    if (m_cursorLayerEnabled && !cursorUpdateTimer->isActive())
-    {
-        cursorUpdateTimer->start();
-    }
+    requestCursorFrame();
     
     qDebug() << "Mouse entered WaterfallGraph widget";
 }
@@ -1228,6 +1599,7 @@ void WaterfallGraph::leaveEvent(QEvent *event)
     
     // Clear mouse position
     m_lastMousePos = QPointF();
+    requestCursorFrame();
     
     // Notify cursor time cleared
     notifyCursorTimeChanged(QDateTime());
@@ -1303,6 +1675,7 @@ void WaterfallGraph::resizeEvent(QResizeEvent *event)
     {
         cursorScene->setSceneRect(0, 0, event->size().width(), event->size().height());
     }
+    requestCursorFrame();
 
     // Update graphics dimensions when the widget is resized
     updateGraphicsDimensions();
@@ -1356,11 +1729,8 @@ void WaterfallGraph::showEvent(QShowEvent *event)
         cursorScene->setSceneRect(0, 0, this->size().width(), this->size().height());
     }
 
-    // Start cursor update timer if cursor layer is enabled
-    if (m_cursorLayerEnabled && !cursorUpdateTimer->isActive())
-    {
-        cursorUpdateTimer->start();
-    }
+    // The cursor layer has not been drawn for the current size yet
+    requestCursorFrame();
 
     // Update graphics dimensions now that we're visible
     updateGraphicsDimensions();
@@ -1372,13 +1742,28 @@ void WaterfallGraph::showEvent(QShowEvent *event)
  */
 void WaterfallGraph::updateDataRanges()
 {
+    PERF_SCOPE("WaterfallGraph::updateDataRanges");
     if (!dataSource || dataSource->isEmpty())
     {
         dataRangesValid = false;
         return;
     }
 
-    auto yRange = dataSource->getCombinedYRange();
+    // Set time range based on data or custom range
+    // (resolved first so the Y range can be fitted to the visible window)
+    if (customTimeRangeEnabled)
+    {
+        // Use custom time range
+        timeMin = customTimeMin;
+        timeMax = customTimeMax;
+    }
+    else
+    {
+        // Set time range based on data timestamps
+        setTimeRangeFromData();
+    }
+
+    auto yRange = getVisibleYRange();
     qreal dataYMin = yRange.first;
     qreal dataYMax = yRange.second;
 
@@ -1398,9 +1783,9 @@ void WaterfallGraph::updateDataRanges()
                 // If custom range is invalid or doesn't overlap with data, use data range
                 yMin = dataYMin;
                 yMax = dataYMax;
-                qDebug() << "Warning: Custom range doesn't overlap with data range, using data range";
-                qDebug() << "Custom range:" << customYMin << "to" << customYMax;
-                qDebug() << "Data range:" << dataYMin << "to" << dataYMax;
+                UI_WARNING(lcWaterfallDraw) << "Warning: Custom range doesn't overlap with data range, using data range";
+                UI_DEBUG(lcWaterfallDraw) << "Custom range:" << customYMin << "to" << customYMax;
+                UI_DEBUG(lcWaterfallDraw) << "Data range:" << dataYMin << "to" << dataYMax;
             }
         }
         else
@@ -1409,39 +1794,29 @@ void WaterfallGraph::updateDataRanges()
             yMin = dataYMin;
             yMax = dataYMax;
         }
+
+        holdAutoYRange();
     }
     else
     {
         // Manual mode: range is always locked to the custom min and max
+        m_autoYRangeHeld = false;
         yMin = customYMin;
         yMax = customYMax;
 
         // Ensure min < max
         if (yMin >= yMax)
         {
-            qDebug() << "Warning: Custom range is invalid (min >= max), using data range";
-            qDebug() << "Custom range:" << customYMin << "to" << customYMax;
+            UI_WARNING(lcWaterfallDraw) << "Warning: Custom range is invalid (min >= max), using data range";
+            UI_DEBUG(lcWaterfallDraw) << "Custom range:" << customYMin << "to" << customYMax;
             yMin = dataYMin;
             yMax = dataYMax;
         }
     }
 
-    // Set time range based on data or custom range
-    if (customTimeRangeEnabled)
-    {
-        // Use custom time range
-        timeMin = customTimeMin;
-        timeMax = customTimeMax;
-    }
-    else
-    {
-        // Set time range based on data timestamps
-        setTimeRangeFromData();
-    }
-
     dataRangesValid = true;
 
-    qDebug() << "Data ranges updated - Y:" << yMin << "to" << yMax
+    UI_DEBUG(lcWaterfallDraw) << "Data ranges updated - Y:" << yMin << "to" << yMax
              << "Time:" << timeMin.toString() << "to" << timeMax.toString()
              << "Interval:" << timeIntervalToString(timeInterval)
              << "Auto-update:" << (autoUpdateYRange ? "enabled" : "disabled")
@@ -1456,21 +1831,245 @@ void WaterfallGraph::updateDataRanges()
  * @return QPointF
  */
 QPointF WaterfallGraph::mapDataToScreen(qreal yValue, const QDateTime &timestamp) const
+{
+    return mapDataToScreen(yValue, timestamp.toMSecsSinceEpoch());
+}
+
+/**
+ * @brief Map a data point with an epoch-millisecond timestamp to screen coordinates.
+ *
+ * @param yValue Data value (horizontal axis)
+ * @param timestampMs Timestamp in milliseconds since epoch (vertical axis)
+ * @return QPointF Screen position
+ */
+QPointF WaterfallGraph::mapDataToScreen(qreal yValue, qint64 timestampMs) const
 {
     if (!dataRangesValid || drawingArea.isEmpty())
     {
         return QPointF(0, 0);
     }
 
-    // Map y-value to x-coordinate (horizontal position)
-    qreal x = drawingArea.left() + ((yValue - yMin) / (yMax - yMin)) * drawingArea.width();
+    // Value runs left to right, time from timeMax (top) down over the fixed time interval
+    return screenTransform().map(yValue, timestampMs);
+}
+
+/**
+ * @brief Map columns of data points to screen coordinates in one pass.
+ *
+ * @param yValues Pointer to count data values
+ * @param timestampsMs Pointer to count timestamps in milliseconds since epoch
+ * @param count Number of points
+ * @param out Receives count screen positions (all (0, 0) while no mapping is available)
+ */
+void WaterfallGraph::mapDataToScreen(const qreal *yValues, const qint64 *timestampsMs, size_t count, QPointF *out) const
+{
+    if (!dataRangesValid || drawingArea.isEmpty())
+    {
+        std::fill(out, out + count, QPointF(0, 0));
+        return;
+    }
+    screenTransform().mapPoints(yValues, timestampsMs, count, out);
+}
+
+/**
+ * @brief Get the data-to-screen mapping for the current ranges, area and interval.
+ *
+ * @return const ScreenTransform& Mapping, recomputed only if one of its inputs changed
+ */
+const ScreenTransform &WaterfallGraph::screenTransform() const
+{
+    RenderKey key = currentRenderKey();
+    if (!m_screenTransformValid || !(key == m_screenTransformKey) || timeMax != m_screenTransformTimeMax)
+    {
+        m_screenTransform.set(yMin, yMax, timeMax.toMSecsSinceEpoch(), key.intervalMs, drawingArea);
+        m_screenTransformKey = key;
+        m_screenTransformTimeMax = timeMax;
+        m_screenTransformValid = true;
+    }
+    return m_screenTransform;
+}
+
+/**
+ * @brief Get a zero-copy view of the samples of a series inside [timeMin, timeMax].
+ *
+ * @param seriesLabel The label of the series
+ * @return WaterfallSeriesView Empty view if there is no data source or no visible data
+ */
+WaterfallSeriesView WaterfallGraph::getVisibleSeriesView(const QString &seriesLabel) const
+{
+    return getVisibleSeriesView(SeriesRegistry::find(seriesLabel));
+}
+
+WaterfallSeriesView WaterfallGraph::getVisibleSeriesView(int seriesId) const
+{
+    if (!dataSource || !timeMin.isValid() || !timeMax.isValid())
+    {
+        return WaterfallSeriesView();
+    }
+    return dataSource->getDataSeriesView(seriesId, timeMin.toMSecsSinceEpoch(), timeMax.toMSecsSinceEpoch());
+}
+
+/**
+ * @brief Build the line path for a time-ordered slice of a series, decimated per pixel row.
+ *
+ * @param seriesId The interned ID of the series
+ * @param visibleData Time-ordered samples to connect
+ * @return QPainterPath Path in scene coordinates (empty if there is nothing to draw)
+ */
+QPainterPath WaterfallGraph::buildSeriesPath(int seriesId, const WaterfallSeriesView &visibleData) const
+{
+    SeriesPathDecimator decimator;
+    decimateSeries(seriesId, visibleData, decimator);
+    return decimator.path();
+}
+
+/**
+ * @brief Feed a time-ordered slice of a series into a row decimator.
+ *
+ * Time runs vertically, so every screen row of the drawing area is one time bucket.
+ * Each bucket contributes at most its first, min, max and last samples (in time order),
+ * which keeps the rendered line identical while the path size depends on the widget
+ * height instead of the number of samples.
+ *
+ * Windows holding many more samples than rows are read from the data source
+ * level-of-detail pyramid instead, using the coarsest level whose buckets still fit
+ * in a pixel row, so long time intervals cost about the same as short ones.
+ *
+ * @param seriesId The interned ID of the series
+ * @param visibleData Time-ordered samples to connect
+ * @param decimator Decimator to reset and fill
+ */
+void WaterfallGraph::decimateSeries(int seriesId, const WaterfallSeriesView &visibleData, SeriesPathDecimator &decimator) const
+{
+    const qint64 timeMaxMs = timeMax.toMSecsSinceEpoch();
+    const qreal rowsPerMs = drawingArea.height() / (qreal)getTimeIntervalMs();
+    decimator.reset(timeMaxMs, rowsPerMs);
+
+    if (visibleData.empty() || !dataRangesValid || drawingArea.isEmpty())
+    {
+        return;
+    }
+
+    std::vector<qint64> lodTimestampsMs;
+    std::vector<qreal> lodYData;
+    WaterfallSeriesView view = lodSeriesView(seriesId, visibleData, lodTimestampsMs, lodYData);
+
+    std::vector<QPointF> points(view.size());
+    mapDataToScreen(view.yData, view.timestampsMs, view.size(), points.data());
+    for (size_t i = 0; i < view.size(); ++i)
+    {
+        decimator.addSample(view.timestampsMs[i], points[i]);
+    }
+}
+
+/**
+ * @brief Get the samples a line should be built from: the visible slice itself, or the
+ * level-of-detail buckets of the data source when the slice holds many more samples than rows.
+ *
+ * @param seriesId The interned ID of the series
+ * @param visibleData Time-ordered visible samples
+ * @param lodTimestampsMs Receives the bucket timestamps if the level of detail is used
+ * @param lodYData Receives the bucket values if the level of detail is used
+ * @return WaterfallSeriesView visibleData, or a view of the two output vectors
+ */
+WaterfallSeriesView WaterfallGraph::lodSeriesView(int seriesId, const WaterfallSeriesView &visibleData,
+                                                  std::vector<qint64> &lodTimestampsMs, std::vector<qreal> &lodYData) const
+{
+    WaterfallSeriesView view = visibleData;
+    if (dataSource && !drawingArea.isEmpty() && visibleData.size() > 4 * (size_t)drawingArea.height())
+    {
+        const qreal rowsPerMs = drawingArea.height() / (qreal)getTimeIntervalMs();
+        qint64 msPerRow = (qint64)(1.0 / rowsPerMs);
+        qint64 bucketMs = dataSource->getLodSeries(seriesId, timeMin.toMSecsSinceEpoch(), timeMax.toMSecsSinceEpoch(), msPerRow,
+                                                   lodTimestampsMs, lodYData);
+        if (bucketMs > 0 && !lodTimestampsMs.empty())
+        {
+            view.timestampsMs = lodTimestampsMs.data();
+            view.yData = lodYData.data();
+            view.count = lodTimestampsMs.size();
+            view.firstIndex = 0;
+        }
+    }
+    return view;
+}
 
-    // Map timestamp to y-coordinate (vertical position, top to bottom)
-    // Use fixed time interval instead of data range
-    qint64 timeOffset = timestamp.msecsTo(timeMax); // Time from current time (top) to data point
-    qreal y = drawingArea.top() + (timeOffset / (qreal)getTimeIntervalMs()) * drawingArea.height();
+/**
+ * @brief Add the decimated line of a series, as a scene item or as a raster layer.
+ *
+ * @param seriesId The interned ID of the series
+ * @param visibleData Time-ordered samples to connect
+ * @param pen Line pen
+ * @return QGraphicsPathItem* Item added to the main scene, or nullptr in raster mode
+ */
+QGraphicsPathItem *WaterfallGraph::addSeriesLine(int seriesId, const WaterfallSeriesView &visibleData, const QPen &pen)
+{
+    if (!m_rasterRenderingEnabled)
+    {
+        return graphicsScene->addPath(buildSeriesPath(seriesId, visibleData), pen);
+    }
+
+    queueRasterLayer(snapshotSeriesLine(seriesId, visibleData, pen));
+    return nullptr;
+}
+
+/**
+ * @brief Add one marker per sample, as a batched scene item or as a raster layer.
+ *
+ * @param visibleData Samples to mark
+ * @param pen Marker outline pen
+ * @param brush Marker fill brush
+ * @param pointSize Marker diameter
+ * @param zValue Stacking order of the markers
+ * @return ScatterPlotItem* Item added to the main scene, or nullptr in raster mode
+ */
+ScatterPlotItem *WaterfallGraph::addSeriesMarkers(const WaterfallSeriesView &visibleData, const QPen &pen, const QBrush &brush, qreal pointSize, qreal zValue)
+{
+    if (!m_rasterRenderingEnabled)
+    {
+        ScatterPlotItem *scatterItem = createScatterItem(visibleData, pen, brush, pointSize);
+        scatterItem->setZValue(zValue);
+        return scatterItem;
+    }
+
+    queueRasterLayer(snapshotSeriesMarkers(visibleData, pen, brush, pointSize, zValue));
+    return nullptr;
+}
+
+/**
+ * @brief Copy the samples of a series line into a raster layer.
+ *
+ * Long windows are copied from the level-of-detail buckets, which are already a copy.
+ *
+ * @param seriesId The interned ID of the series
+ * @param visibleData Time-ordered samples to connect
+ * @param pen Line pen
+ * @return SeriesRasterLayer Line layer owning its samples
+ */
+SeriesRasterLayer WaterfallGraph::snapshotSeriesLine(int seriesId, const WaterfallSeriesView &visibleData, const QPen &pen) const
+{
+    SeriesRasterLayer layer;
+    layer.kind = SeriesRasterLayer::Kind::Line;
+    layer.pen = pen;
+    WaterfallSeriesView view = lodSeriesView(seriesId, visibleData, layer.timestampsMs, layer.yData);
+    if (view.timestampsMs != layer.timestampsMs.data())
+    {
+        layer.timestampsMs.assign(view.timestampsMs, view.timestampsMs + view.size());
+        layer.yData.assign(view.yData, view.yData + view.size());
+    }
+    return layer;
+}
 
-    return QPointF(x, y);
+SeriesRasterLayer WaterfallGraph::snapshotSeriesMarkers(const WaterfallSeriesView &visibleData, const QPen &pen, const QBrush &brush, qreal pointSize, qreal zValue) const
+{
+    SeriesRasterLayer layer;
+    layer.kind = SeriesRasterLayer::Kind::Markers;
+    layer.timestampsMs.assign(visibleData.timestampsMs, visibleData.timestampsMs + visibleData.size());
+    layer.yData.assign(visibleData.yData, visibleData.yData + visibleData.size());
+    layer.pen = pen;
+    layer.brush = brush;
+    layer.pointSize = pointSize;
+    layer.zValue = zValue;
+    return layer;
 }
 
 /**
@@ -1498,73 +2097,49 @@ qreal WaterfallGraph::mapScreenXToRange(qreal xPos) const
 /**
  * @brief Draw the data line from top to bottom.
  *
+ * @param seriesId The interned ID of the series
+ * @param plotPoints Whether to mark every sample as well
  */
-void WaterfallGraph::drawDataLine(const QString &seriesLabel, bool plotPoints)
+void WaterfallGraph::drawDataLine(int seriesId, bool plotPoints)
 {
     if (!graphicsScene || !dataSource || dataSource->isEmpty() || !dataRangesValid)
     {
         return;
     }
 
-    const auto &yData = dataSource->getYDataSeries(seriesLabel);
-    const auto &timestamps = dataSource->getTimestampsSeries(seriesLabel);
-
-    // Filter data points to only include those within the current time range
-    std::vector<std::pair<qreal, QDateTime>> visibleData;
-    for (size_t i = 0; i < yData.size(); ++i)
-    {
-        if (timestamps[i] >= timeMin && timestamps[i] <= timeMax)
-        {
-            visibleData.push_back({yData[i], timestamps[i]});
-        }
-    }
+    // Binary-search the slice of the series within the current time range (no copy)
+    WaterfallSeriesView visibleData = getVisibleSeriesView(seriesId);
 
     if (visibleData.empty())
     {
-        qDebug() << "No data points within current time range";
+        UI_DEBUG(lcWaterfallDraw) << "No data points within current time range";
         return;
     }
 
     if (visibleData.size() < 2)
     {
         // Draw a single point if we only have one data point
-        QPointF screenPoint = mapDataToScreen(visibleData[0].first, visibleData[0].second);
+        QPointF screenPoint = mapDataToScreen(visibleData.yData[0], visibleData.timestampsMs[0]);
         QPen pointPen(Qt::green, 0); // No stroke (width 0)
         graphicsScene->addEllipse(screenPoint.x() - 2, screenPoint.y() - 2, 4, 4, pointPen);
-        qDebug() << "Data line drawn with 1 visible point";
+        UI_DEBUG(lcWaterfallDraw) << "Data line drawn with 1 visible point";
         return;
     }
 
-    // Create a path for the line
-    QPainterPath path;
-    QPointF firstPoint = mapDataToScreen(visibleData[0].first, visibleData[0].second);
-    path.moveTo(firstPoint);
-
-    // Add lines connecting all visible data points
-    for (size_t i = 1; i < visibleData.size(); ++i)
-    {
-        QPointF point = mapDataToScreen(visibleData[i].first, visibleData[i].second);
-        path.lineTo(point);
-    }
-
-    // Draw the line
-    QColor seriesColor = getSeriesColor(seriesLabel);
+    // Draw the line, decimated to a few vertices per pixel row
+    QColor seriesColor = getSeriesColor(seriesId);
     QPen linePen(seriesColor, 2);
-    graphicsScene->addPath(path, linePen);
+    addSeriesLine(seriesId, visibleData, linePen);
 
     // Draw data points if enabled
     if (plotPoints)
     {
         // Draw data points
         QPen pointPen(seriesColor, 0); // No stroke (width 0)
-        for (size_t i = 0; i < visibleData.size(); ++i)
-        {
-            QPointF point = mapDataToScreen(visibleData[i].first, visibleData[i].second);
-            graphicsScene->addEllipse(point.x() - 1, point.y() - 1, 2, 2, pointPen);
-        }
+        addSeriesMarkers(visibleData, pointPen, Qt::NoBrush, 2.0);
     }
 
-    qDebug() << "Data line drawn for series" << seriesLabel << "with" << visibleData.size() << "visible points out of" << yData.size() << "total points";
+    UI_DEBUG(lcWaterfallDraw) << "Data line drawn for series" << SeriesRegistry::label(seriesId) << "with" << visibleData.size() << "visible points out of" << dataSource->getDataSeriesSize(seriesId) << "total points";
 }
 
 // Mouse selection functionality implementation
@@ -1705,12 +2280,10 @@ QDateTime WaterfallGraph::mapScreenToTime(qreal yPos) const
     }
 
     // Map y-coordinate to time
-    // yPos is from top (current time) to bottom (past time)
-    qreal normalizedY = (yPos - drawingArea.top()) / drawingArea.height();
-    normalizedY = qMax(0.0, qMin(1.0, normalizedY)); // Clamp to [0,1]
-
-    // Calculate time offset from current time (top of graph)
-    qint64 timeOffsetMs = static_cast<qint64>(normalizedY * getTimeIntervalMs());
+    // yPos is from top (current time) to bottom (past time), clamped to the drawing area
+    qreal clampedY = qMax(drawingArea.top(), qMin(drawingArea.bottom(), yPos));
+    const ScreenTransform &transform = screenTransform();
+    qint64 timeOffsetMs = transform.timeMaxMs() - transform.timeAt(clampedY);
 
     // Convert to QTime using the data source's time range
     QDateTime selectionTime = timeMax.addMSecs(-timeOffsetMs);
@@ -1749,6 +2322,7 @@ void WaterfallGraph::setRangeLimitingEnabled(bool enabled)
     if (rangeLimitingEnabled != enabled)
     {
         rangeLimitingEnabled = enabled;
+        m_autoYRangeHeld = false;
 
         // Update data ranges and redraw if we have data
         if (dataSource && !dataSource->isEmpty())
@@ -1792,6 +2366,7 @@ void WaterfallGraph::setCustomYRange(const qreal yMin, const qreal yMax)
 
     customYMin = yMin;
     customYMax = yMax;
+    m_autoYRangeHeld = false;
 
     // Always update Y range immediately when custom range is set
     updateYRange();
@@ -1860,6 +2435,7 @@ void WaterfallGraph::unsetCustomYRange()
 {
     customYMin = 0.0;
     customYMax = 0.0;
+    m_autoYRangeHeld = false;
 
     // Update data ranges and redraw if range limiting is enabled and we have data
     if (rangeLimitingEnabled && dataSource && !dataSource->isEmpty())
@@ -1988,323 +2564,1046 @@ void WaterfallGraph::drawTriangleMarker(const QPointF &position, const QColor &f
  */
 void WaterfallGraph::drawScatterplot(const QString &seriesLabel, const QColor &pointColor, qreal pointSize, const QColor &outlineColor)
 {
+    drawScatterplot(SeriesRegistry::find(seriesLabel), pointColor, pointSize, outlineColor);
+}
+
+void WaterfallGraph::drawScatterplot(int seriesId, const QColor &pointColor, qreal pointSize, const QColor &outlineColor)
+{
+    PERF_SCOPE("WaterfallGraph::drawScatterplot");
     if (!graphicsScene || !dataSource)
         return;
 
-    // Get the default data series
-    const std::vector<qreal> &yData = dataSource->getYDataSeries(seriesLabel);
-    const std::vector<QDateTime> &timestamps = dataSource->getTimestampsSeries(seriesLabel);
+    if (dataSource->getDataSeriesSize(seriesId) == 0)
+    {
+        UI_DEBUG(lcWaterfallDraw) << "No data available for default scatterplot";
+        return;
+    }
+
+    // Binary-search the slice of the series within the current time range (no copy)
+    WaterfallSeriesView visibleData = getVisibleSeriesView(seriesId);
 
-    if (yData.empty() || timestamps.empty())
+    if (visibleData.empty())
     {
-        qDebug() << "No data available for default scatterplot";
+        UI_DEBUG(lcWaterfallDraw) << "No data points within current time range for default scatterplot";
         return;
     }
 
-    if (yData.size() != timestamps.size())
+    // Draw all scatterplot points as a single batched item
+    addSeriesMarkers(visibleData, QPen(outlineColor, 0), QBrush(pointColor), pointSize, 120); // Draw above data lines but below markers
+
+    UI_DEBUG(lcWaterfallDraw) << "Default scatterplot drawn with" << visibleData.size() << "points";
+}
+
+/**
+ * @brief Add a batched scatter item holding one marker per sample of a view.
+ *
+ * @param view Samples to mark
+ * @param pen Marker outline pen
+ * @param brush Marker fill brush
+ * @param pointSize Marker diameter
+ * @return ScatterPlotItem* Item added to the main scene (owned by the scene)
+ */
+ScatterPlotItem *WaterfallGraph::createScatterItem(const WaterfallSeriesView &view, const QPen &pen, const QBrush &brush, qreal pointSize)
+{
+    QVector<QPointF> points((int)view.size());
+    mapDataToScreen(view.yData, view.timestampsMs, view.size(), points.data());
+
+    ScatterPlotItem *scatterItem = new ScatterPlotItem();
+    scatterItem->setPointSize(pointSize);
+    scatterItem->setPen(pen);
+    scatterItem->setBrush(brush);
+    scatterItem->setPoints(points);
+    graphicsScene->addItem(scatterItem);
+    return scatterItem;
+}
+
+/**
+ * @brief Draw all data series in the waterfall graph.
+ *
+ */
+void WaterfallGraph::drawAllDataSeries()
+{
+    if (!graphicsScene || !dataSource || !dataRangesValid)
     {
-        qDebug() << "Data size mismatch for default scatterplot";
+        UI_DEBUG(lcWaterfallDraw) << "drawAllDataSeries: Early return - graphicsScene:" << (graphicsScene != nullptr)
+                 << "dataSource:" << (dataSource != nullptr)
+                 << "dataRangesValid:" << dataRangesValid;
         return;
     }
 
-    // Filter data points to only include those within the current time range
-    std::vector<std::pair<qreal, QDateTime>> visibleData;
-    for (size_t i = 0; i < yData.size(); ++i)
+    // Get all available data series
+    const std::vector<int> &seriesIds = dataSource->getDataSeriesIds();
+    UI_DEBUG(lcWaterfallDraw) << "drawAllDataSeries: Found" << seriesIds.size() << "series";
+
+    // If no multi-series data, fall back to legacy single series
+    if (seriesIds.empty())
+    {
+        UI_DEBUG(lcWaterfallDraw) << "drawAllDataSeries: No series found, falling back to legacy single series";
+        // Throw an exception
+        // Gather more debug info about the WaterfallGraph state
+        QString debugInfo;
+        debugInfo += "No series found in data source.\n";
+        debugInfo += QString("WaterfallGraph info:\n");
+        debugInfo += QString("  graphicsScene: %1\n").arg(graphicsScene ? "set" : "nullptr");
+        debugInfo += QString("  dataSource: %1\n").arg(dataSource ? "set" : "nullptr");
+        debugInfo += QString("  dataRangesValid: %1\n").arg(dataRangesValid ? "true" : "false");
+        debugInfo += QString("  drawingArea: (%1, %2, %3, %4)\n")
+                         .arg(drawingArea.left())
+                         .arg(drawingArea.top())
+                         .arg(drawingArea.width())
+                         .arg(drawingArea.height());
+        debugInfo += QString("  yMin: %1, yMax: %2\n").arg(yMin).arg(yMax);
+        debugInfo += QString("  timeMin: %1, timeMax: %2\n")
+                         .arg(timeMin.toString())
+                         .arg(timeMax.toString());
+        debugInfo += QString("  autoUpdateYRange: %1\n").arg(autoUpdateYRange ? "true" : "false");
+        debugInfo += QString("  rangeLimitingEnabled: %1\n").arg(rangeLimitingEnabled ? "true" : "false");
+        UI_DEBUG(lcWaterfallDraw) << debugInfo;
+        throw std::runtime_error(debugInfo.toStdString());
+    }
+
+    // Draw each visible series
+    for (int seriesId : seriesIds)
     {
-        if (timestamps[i] >= timeMin && timestamps[i] <= timeMax)
+        UI_DEBUG(lcWaterfallDraw) << "drawAllDataSeries: Processing series:" << SeriesRegistry::label(seriesId)
+                 << "visible:" << isSeriesVisible(seriesId);
+        if (isSeriesVisible(seriesId))
         {
-            visibleData.push_back({yData[i], timestamps[i]});
+            drawDataSeries(seriesId);
         }
     }
+}
+
+/**
+ * @brief Draw a specific data series.
+ *
+ * @param seriesLabel The label of the series to draw
+ */
+void WaterfallGraph::drawDataSeries(const QString &seriesLabel)
+{
+    drawDataSeries(SeriesRegistry::find(seriesLabel));
+}
+
+/**
+ * @brief Draw a specific data series identified by its interned ID.
+ *
+ * @param seriesId The interned ID of the series to draw
+ */
+void WaterfallGraph::drawDataSeries(int seriesId)
+{
+    if (!graphicsScene || !dataSource || !dataRangesValid || seriesId < 0)
+    {
+        UI_DEBUG(lcWaterfallDraw) << "drawDataSeries: Early return for series:" << SeriesRegistry::label(seriesId);
+        return;
+    }
+
+    // Remove existing graphics items for this series if they exist (for incremental updates)
+    SeriesSlot &slot = seriesSlot(seriesId);
+    releaseSeriesItems(slot);
+
+    // Derived graphs may draw a series only through their decorations
+    const SeriesStyle style = seriesStyle(seriesId);
+    if (!style.drawLine && !style.drawMarkers)
+    {
+        return;
+    }
+
+    const size_t totalPoints = dataSource->getDataSeriesSize(seriesId);
+
+    UI_DEBUG(lcWaterfallDraw) << "drawDataSeries: Series" << SeriesRegistry::label(seriesId) << "has" << totalPoints << "data points";
+
+    if (totalPoints == 0)
+    {
+        UI_DEBUG(lcWaterfallDraw) << "No data available for series:" << SeriesRegistry::label(seriesId);
+        return;
+    }
+
+    // Binary-search the slice of the series within the current time range (no copy)
+    WaterfallSeriesView visibleData = getVisibleSeriesView(seriesId);
+
+    UI_DEBUG(lcWaterfallDraw) << "drawDataSeries: Series" << SeriesRegistry::label(seriesId) << "has" << visibleData.size() << "visible data points within time range"
+             << timeMin.toString() << "to" << timeMax.toString();
 
     if (visibleData.empty())
     {
-        qDebug() << "No data points within current time range for default scatterplot";
+        UI_DEBUG(lcWaterfallDraw) << "No data points within current time range for series:" << SeriesRegistry::label(seriesId);
+        return;
+    }
+
+    // Raster passes redraw every series, so nothing is kept for appending
+    if (m_rasterRenderingEnabled)
+    {
+        if (style.drawLine && visibleData.size() >= 2)
+        {
+            addSeriesLine(seriesId, visibleData, style.linePen);
+        }
+        if (style.marksSamples(visibleData.size()))
+        {
+            addSeriesMarkers(visibleData, style.samplePen(), style.sampleBrush(), style.sampleSize(visibleData.size()), style.markerZValue);
+        }
+        return;
+    }
+
+    if (visibleData.size() < 2)
+    {
+        // Draw a single point if we only have one data point
+        slot.pointItem = createScatterItem(visibleData, style.samplePen(), style.sampleBrush(), style.sampleSize(1));
+        slot.pointItem->setZValue(style.markerZValue);
+        UI_DEBUG(lcWaterfallDraw) << "Data series" << SeriesRegistry::label(seriesId) << "drawn with 1 visible point";
+        return;
+    }
+
+    // Create a path for the line, decimated to a few vertices per pixel row.
+    // The decimator is kept so that newly arrived samples can be appended later.
+    SeriesRenderCache &renderCache = slot.renderCache;
+    slot.hasRenderCache = true;
+    if (style.drawLine)
+    {
+        decimateSeries(seriesId, visibleData, renderCache.decimator);
+        slot.pathItem = graphicsScene->addPath(renderCache.decimator.path(), style.linePen);
+    }
+
+    // Draw data points as one batched item and store its reference
+    if (style.drawMarkers)
+    {
+        slot.pointItem = createScatterItem(visibleData, style.markerPen, style.markerBrush, style.markerSize);
+        slot.pointItem->setZValue(style.markerZValue);
+    }
+
+    renderCache.pointTimestampsMs.assign(visibleData.timestampsMs, visibleData.timestampsMs + visibleData.size());
+    renderCache.lastDrawnMs = visibleData.timestampsMs[visibleData.size() - 1];
+    renderCache.topTimeMs = timeMax.toMSecsSinceEpoch();
+
+    UI_DEBUG(lcWaterfallDraw) << "Data series" << SeriesRegistry::label(seriesId) << "drawn with" << visibleData.size() << "visible points out of" << totalPoints << "total points"
+             << "(" << (slot.pathItem ? renderCache.decimator.vertexCount() : 0) << "path vertices)";
+}
+
+/**
+ * @brief Extend an already drawn series with the samples that arrived since it was drawn.
+ *
+ * Only valid while the screen mapping is unchanged. The series geometry stays in the
+ * coordinates of the timeMax it was built with; a later timeMax (follow mode) is applied
+ * as a vertical translation of its items, so existing samples are never re-mapped.
+ * Markers and line vertices of samples that left the time window are trimmed, new
+ * samples are mapped and appended, and the line path is rebuilt from the retained
+ * decimated vertices (bounded by the widget height).
+ *
+ * @param seriesId The interned ID of the series
+ * @return bool false if the series has to be redrawn with drawDataSeries instead
+ */
+bool WaterfallGraph::appendDataSeries(int seriesId)
+{
+    if (seriesId < 0 || static_cast<size_t>(seriesId) >= m_seriesSlots.size())
+    {
+        return false;
+    }
+    SeriesSlot &slot = m_seriesSlots[seriesId];
+    if (!slot.hasRenderCache || (!slot.pathItem && !slot.pointItem))
+    {
+        return false;
+    }
+
+    SeriesRenderCache &renderCache = slot.renderCache;
+    WaterfallSeriesView visibleData = getVisibleSeriesView(seriesId);
+    if (visibleData.empty())
+    {
+        return false;
+    }
+
+    // Time advanced since the series was built: scroll it down instead of re-mapping it.
+    // Once it has scrolled a full height nothing of the original geometry is left to reuse.
+    const qreal rowsPerMs = drawingArea.height() / (qreal)getTimeIntervalMs();
+    const qreal scrollOffset = (timeMax.toMSecsSinceEpoch() - renderCache.topTimeMs) * rowsPerMs;
+    if (scrollOffset < 0 || scrollOffset > drawingArea.height())
+    {
+        return false;
+    }
+    if (slot.pathItem)
+    {
+        slot.pathItem->setPos(0, scrollOffset);
+    }
+    if (slot.pointItem)
+    {
+        slot.pointItem->setPos(0, scrollOffset);
+    }
+
+    // Samples drawn before the first visible one scrolled off the window or were evicted
+    const qint64 windowStartMs = visibleData.timestampsMs[0];
+    int trimCount = 0;
+    while (!renderCache.pointTimestampsMs.empty() && renderCache.pointTimestampsMs.front() < windowStartMs)
+    {
+        renderCache.pointTimestampsMs.pop_front();
+        ++trimCount;
+    }
+
+    // Everything up to the last drawn sample must be exactly what is on screen,
+    // otherwise samples were inserted out of order or the series was replaced
+    const qint64 *timestampsEnd = visibleData.timestampsMs + visibleData.size();
+    const qint64 *newBegin = std::upper_bound(visibleData.timestampsMs, timestampsEnd, renderCache.lastDrawnMs);
+    size_t drawnCount = static_cast<size_t>(newBegin - visibleData.timestampsMs);
+    if (drawnCount != renderCache.pointTimestampsMs.size())
+    {
+        UI_DEBUG(lcWaterfallDraw) << "appendDataSeries: Series" << SeriesRegistry::label(seriesId) << "changed before its last drawn sample, rebuilding";
+        return false;
+    }
+
+    if (trimCount > 0)
+    {
+        if (slot.pathItem)
+        {
+            renderCache.decimator.trimBefore(windowStartMs);
+        }
+        if (slot.pointItem)
+        {
+            slot.pointItem->removeFirstPoints(trimCount);
+        }
+    }
+
+    size_t newCount = visibleData.size() - drawnCount;
+    std::vector<QPointF> newPoints(newCount);
+    mapDataToScreen(visibleData.yData + drawnCount, visibleData.timestampsMs + drawnCount, newCount, newPoints.data());
+    for (size_t i = 0; i < newCount; ++i)
+    {
+        newPoints[i] -= QPointF(0, scrollOffset);
+        if (slot.pathItem)
+        {
+            renderCache.decimator.addSample(visibleData.timestampsMs[drawnCount + i], newPoints[i]);
+        }
+        renderCache.pointTimestampsMs.push_back(visibleData.timestampsMs[drawnCount + i]);
+    }
+    if (slot.pointItem)
+    {
+        slot.pointItem->addPoints(newPoints.data(), static_cast<int>(newCount));
+    }
+    if (newCount > 0)
+    {
+        renderCache.lastDrawnMs = visibleData.timestampsMs[visibleData.size() - 1];
+    }
+
+    if (slot.pathItem && (newCount > 0 || trimCount > 0))
+    {
+        slot.pathItem->setPath(renderCache.decimator.path());
+    }
+
+    UI_DEBUG(lcWaterfallDraw) << "Data series" << SeriesRegistry::label(seriesId) << "appended" << newCount << "points, trimmed" << trimCount
+             << "scrolled by" << scrollOffset << "(" << renderCache.decimator.vertexCount() << "path vertices)";
+    return true;
+}
+
+// Multi-series support methods implementation
+
+/**
+ * @brief Get the slot of a series, creating it (and any slots below it) on first use.
+ *
+ * Creating a slot may grow the table, so references to other slots obtained before
+ * the call must not be used after it.
+ *
+ * @param seriesId Interned series ID (see SeriesRegistry), must not be negative
+ * @return SeriesSlot& Style, visibility and scene state of the series
+ */
+WaterfallGraph::SeriesSlot &WaterfallGraph::seriesSlot(int seriesId)
+{
+    size_t oldSize = m_seriesSlots.size();
+    if (static_cast<size_t>(seriesId) >= oldSize)
+    {
+        m_seriesSlots.resize(static_cast<size_t>(seriesId) + 1);
+        for (size_t id = oldSize; id < m_seriesSlots.size(); ++id)
+        {
+            m_seriesSlots[id].color = defaultSeriesColor(SeriesRegistry::label(static_cast<int>(id)));
+        }
+    }
+    return m_seriesSlots[seriesId];
+}
+
+/**
+ * @brief Render an intensity series into an image of the drawing area.
+ *
+ * Each device row shows the newest intensity row at or before its time, held until the
+ * next row; runs of device rows showing the same intensity row copy the scanline above.
+ * Each device column shows the bin under its centre, so the bins line up with the value
+ * axis of the line and scatter series. Scanlines go through the colour map lookup table,
+ * so a render is O(device pixels) whatever the bin count.
+ *
+ * @param seriesId The interned ID of the intensity series
+ */
+void WaterfallGraph::drawIntensitySeries(int seriesId)
+{
+    PERF_SCOPE("WaterfallGraph::drawIntensitySeries");
+    if (!graphicsScene || !dataSource || seriesId < 0)
+    {
+        return;
+    }
+
+    SeriesSlot &slot = seriesSlot(seriesId);
+    const WaterfallIntensitySeries *series = dataSource->getIntensitySeries(seriesId);
+    if (!series || series->empty() || !slot.visible || !dataRangesValid || !timeMin.isValid() || !timeMax.isValid() ||
+        drawingArea.isEmpty() || yMax == yMin)
+    {
+        if (slot.intensityItem)
+        {
+            graphicsScene->removeItem(slot.intensityItem);
+            delete slot.intensityItem;
+            slot.intensityItem = nullptr;
+        }
         return;
     }
-
-    // Draw scatterplot points
-    for (const auto &dataPoint : visibleData)
+
+    const qreal dpr = graphicsView ? graphicsView->devicePixelRatioF() : 1.0;
+    const int width = qCeil(drawingArea.width() * dpr);
+    const int height = qCeil(drawingArea.height() * dpr);
+    QImage image(width, height, QImage::Format_RGB32);
+    image.setDevicePixelRatio(dpr);
+    const QRgb background = graphicsScene->backgroundBrush().color().rgb();
+
+    // Bin under the centre of each device column; the bin axis covers one run of columns
+    std::vector<int> columnBins(width, 0);
+    int firstColumn = width;
+    int lastColumn = 0;
+    const qreal binsPerValue = series->binCount / (series->binEnd - series->binStart);
+    for (int x = 0; x < width; ++x)
+    {
+        qreal value = yMin + (x + 0.5) / width * (yMax - yMin);
+        qreal bin = std::floor((value - series->binStart) * binsPerValue);
+        if (bin >= 0 && bin < series->binCount)
+        {
+            columnBins[x] = static_cast<int>(bin);
+            firstColumn = std::min(firstColumn, x);
+            lastColumn = x + 1;
+        }
+    }
+    std::vector<float> columnValues(std::max(lastColumn - firstColumn, 0));
+
+    // Walk up the rows from timeMax; device rows only ever move back in time
+    const qreal msPerDeviceRow = getTimeIntervalMs() / (drawingArea.height() * dpr);
+    const qint64 timeMaxMs = timeMax.toMSecsSinceEpoch();
+    const qint64 timeMinMs = timeMin.toMSecsSinceEpoch();
+    const size_t noRow = series->size();
+    size_t nextRow = series->upperBound(timeMaxMs);
+    size_t shownRow = noRow;
+    for (int y = 0; y < height; ++y)
+    {
+        QRgb *scanline = reinterpret_cast<QRgb *>(image.scanLine(y));
+        const qint64 rowTimeMs = timeMaxMs - static_cast<qint64>((y + 0.5) * msPerDeviceRow);
+        while (nextRow > 0 && series->rowTimeMs(nextRow - 1) > rowTimeMs)
+        {
+            --nextRow;
+        }
+
+        if (nextRow == 0 || rowTimeMs < timeMinMs)
+        {
+            std::fill(scanline, scanline + width, background);
+            shownRow = noRow;
+            continue;
+        }
+        if (nextRow - 1 == shownRow)
+        {
+            std::memcpy(scanline, image.constScanLine(y - 1), width * sizeof(QRgb));
+            continue;
+        }
+
+        shownRow = nextRow - 1;
+        const float *bins = series->row(shownRow);
+        for (int x = firstColumn; x < lastColumn; ++x)
+        {
+            columnValues[x - firstColumn] = bins[columnBins[x]];
+        }
+        std::fill(scanline, scanline + std::min(firstColumn, width), background);
+        std::fill(scanline + std::max(lastColumn, 0), scanline + width, background);
+        m_intensityColorMap.mapScanline(columnValues.data(), columnValues.size(), slot.intensityLevelMin,
+                                        slot.intensityLevelMax, scanline + firstColumn);
+    }
+
+    if (!slot.intensityItem)
+    {
+        slot.intensityItem = new SeriesRasterItem();
+        slot.intensityItem->setZValue(-1); // Below the grid and the line and scatter series
+        graphicsScene->addItem(slot.intensityItem);
+    }
+    slot.intensityItem->setImage(image, drawingArea);
+
+    UI_DEBUG(lcWaterfallDraw) << "drawIntensitySeries: Series" << SeriesRegistry::label(seriesId) << "rendered"
+                              << width << "x" << height << "from" << series->size() << "rows";
+}
+
+/**
+ * @brief Remove the scene items of a series and drop its incremental rendering state.
+ *
+ * @param slot Slot of the series
+ */
+void WaterfallGraph::releaseSeriesItems(SeriesSlot &slot)
+{
+    if (slot.pathItem)
+    {
+        graphicsScene->removeItem(slot.pathItem);
+        delete slot.pathItem;
+        slot.pathItem = nullptr;
+    }
+
+    if (slot.pointItem)
+    {
+        graphicsScene->removeItem(slot.pointItem);
+        delete slot.pointItem;
+        slot.pointItem = nullptr;
+    }
+    slot.hasRenderCache = false;
+}
+
+/**
+ * @brief Get the color used for a series that has no color set.
+ *
+ * @param seriesLabel The label of the series
+ * @return QColor A color derived from the label, stable across runs
+ */
+QColor WaterfallGraph::defaultSeriesColor(const QString &seriesLabel)
+{
+    // Return a default color based on series index
+    static const QColor defaultColors[] = {
+        Qt::green, Qt::red, Qt::blue, Qt::yellow, Qt::cyan, Qt::magenta, Qt::white};
+
+    // Generate a consistent color based on the series label hash
+    uint hash = qHash(seriesLabel);
+    return defaultColors[hash % (sizeof(defaultColors) / sizeof(defaultColors[0]))];
+}
+
+/**
+ * @brief Get the interned ID of the ADOPTED series, which the graph types draw as a line.
+ *
+ * Interned on first use only, so draw loops compare IDs without touching the registry lock.
+ *
+ * @return int The interned ID of "ADOPTED"
+ */
+int WaterfallGraph::adoptedSeriesId()
+{
+    static const int seriesId = SeriesRegistry::intern(QStringLiteral("ADOPTED"));
+    return seriesId;
+}
+
+/**
+ * @brief Set the color for a specific data series.
+ *
+ * @param seriesLabel The label of the series
+ * @param color The color to use for the series
+ */
+void WaterfallGraph::setSeriesColor(const QString &seriesLabel, const QColor &color)
+{
+    seriesSlot(SeriesRegistry::intern(seriesLabel)).color = color;
+    qDebug() << "Series color set for" << seriesLabel << "to" << color.name();
+}
+
+/**
+ * @brief Get the color for a specific data series.
+ *
+ * @param seriesLabel The label of the series
+ * @return QColor The color of the series, or a default color if not set
+ */
+QColor WaterfallGraph::getSeriesColor(const QString &seriesLabel) const
+{
+    int seriesId = SeriesRegistry::find(seriesLabel);
+    return (seriesId >= 0) ? getSeriesColor(seriesId) : defaultSeriesColor(seriesLabel);
+}
+
+QColor WaterfallGraph::getSeriesColor(int seriesId) const
+{
+    if (seriesId >= 0 && static_cast<size_t>(seriesId) < m_seriesSlots.size())
+    {
+        return m_seriesSlots[seriesId].color;
+    }
+    return defaultSeriesColor(SeriesRegistry::label(seriesId));
+}
+
+/**
+ * @brief Set the visibility for a specific data series.
+ *
+ * @param seriesLabel The label of the series
+ * @param visible True to make the series visible, false to hide it
+ */
+void WaterfallGraph::setSeriesVisible(const QString &seriesLabel, bool visible)
+{
+    seriesSlot(SeriesRegistry::intern(seriesLabel)).visible = visible;
+    qDebug() << "Series visibility set for" << seriesLabel << "to" << (visible ? "visible" : "hidden");
+}
+
+/**
+ * @brief Check if a specific data series is visible.
+ *
+ * @param seriesLabel The label of the series
+ * @return bool True if the series is visible, false otherwise
+ */
+bool WaterfallGraph::isSeriesVisible(const QString &seriesLabel) const
+{
+    return isSeriesVisible(SeriesRegistry::find(seriesLabel));
+}
+
+bool WaterfallGraph::isSeriesVisible(int seriesId) const
+{
+    if (seriesId >= 0 && static_cast<size_t>(seriesId) < m_seriesSlots.size())
+    {
+        return m_seriesSlots[seriesId].visible;
+    }
+
+    // Default to visible if not explicitly set
+    return true;
+}
+
+/**
+ * @brief Get all visible series labels.
+ *
+ * @return std::vector<QString> Vector of visible series labels
+ */
+std::vector<QString> WaterfallGraph::getVisibleSeries() const
+{
+    std::vector<QString> visibleSeries;
+
+    if (!dataSource)
+    {
+        return visibleSeries;
+    }
+
+    for (int seriesId : dataSource->getDataSeriesIds())
+    {
+        if (isSeriesVisible(seriesId))
+        {
+            visibleSeries.push_back(SeriesRegistry::label(seriesId));
+        }
+    }
+
+    return visibleSeries;
+}
+
+/**
+ * @brief Enable or disable raster rendering of the series.
+ *
+ * In raster mode every draw pass snapshots the visible series into layers which a worker
+ * of the global thread pool rasterizes into an image; the GUI thread only blits finished
+ * images. The previous image stays visible until its replacement is ready, and passes
+ * that finish while a job runs are coalesced so that only the latest one is rendered.
+ * Symbols, markers and overlays of the derived graphs remain scene items.
+ *
+ * @param enabled True to rasterize series off the GUI thread
+ */
+void WaterfallGraph::setRasterRenderingEnabled(bool enabled)
+{
+    if (m_rasterRenderingEnabled == enabled)
+    {
+        return;
+    }
+
+    m_rasterRenderingEnabled = enabled;
+    if (enabled)
+    {
+        m_scrollingBitmapEnabled = false;
+    }
+    if (enabled && !m_rasterWatcher)
+    {
+        m_rasterWatcher = new QFutureWatcher<QImage>(this);
+        connect(m_rasterWatcher, &QFutureWatcher<QImage>::finished, this, [this]() { onRasterJobFinished(); });
+    }
+
+    if (!enabled)
+    {
+        removeRasterImage();
+        m_pendingRasterJob = SeriesRasterJob();
+        m_rasterJobPending = false;
+    }
+
+    draw();
+}
+
+bool WaterfallGraph::isRasterRenderingEnabled() const
+{
+    return m_rasterRenderingEnabled;
+}
+
+/**
+ * @brief Enable or disable the scrolling bitmap backend.
+ *
+ * The series are painted into a bitmap of the drawing area once. The bitmap is a ring
+ * of device rows: while the screen mapping holds, each incremental draw scrolls it down by
+ * moving its top row back by the rows timeMax advanced (rounded up to whole rows, with the
+ * excess applied as a negative item offset), clears only those rows and paints only the
+ * samples that arrived since. The item blits the ring in two parts, so a tick costs
+ * O(new samples + new rows x width) instead of O(visible samples) or O(image). A range, interval or size change, a full redraw, or
+ * data changed before the last painted sample re-rasterizes the whole bitmap. The
+ * per-type overlays of derived graphs stay scene items drawn above the bitmap.
+ *
+ * @param enabled True to use the scrolling bitmap backend
+ */
+void WaterfallGraph::setScrollingBitmapEnabled(bool enabled)
+{
+    if (m_scrollingBitmapEnabled == enabled)
+    {
+        return;
+    }
+
+    if (enabled && m_rasterRenderingEnabled)
+    {
+        setRasterRenderingEnabled(false);
+    }
+    m_scrollingBitmapEnabled = enabled;
+    if (!enabled)
     {
-        QPointF screenPoint = mapDataToScreen(dataPoint.first, dataPoint.second);
+        removeRasterImage();
+    }
 
-        // Create a circle for the scatterplot point
-        QGraphicsEllipseItem *point = new QGraphicsEllipseItem();
-        point->setRect(screenPoint.x() - pointSize / 2, screenPoint.y() - pointSize / 2, pointSize, pointSize);
-        point->setPen(QPen(outlineColor, 0)); // No stroke (width 0)
-        point->setBrush(QBrush(pointColor));
-        point->setZValue(120); // Draw above data lines but below markers
+    draw();
+}
 
-        graphicsScene->addItem(point);
-    }
+bool WaterfallGraph::isScrollingBitmapEnabled() const
+{
+    return m_scrollingBitmapEnabled;
+}
 
-    qDebug() << "Default scatterplot drawn with" << visibleData.size() << "points";
+/**
+ * @brief Get the mapping of the scrolling bitmap, whose top row is m_bitmapTopMs.
+ *
+ * @return SeriesRasterJob Mapping, area and device pixel ratio (without layers)
+ */
+SeriesRasterJob WaterfallGraph::bitmapMapping() const
+{
+    SeriesRasterJob job;
+    job.area = drawingArea;
+    job.rowsPerMs = drawingArea.height() / (qreal)getTimeIntervalMs();
+    job.devicePixelRatio = graphicsView ? graphicsView->devicePixelRatioF() : 1.0;
+
+    // The top time is fractional; its fraction moves the area down by part of a row
+    qint64 topMs = (qint64)std::floor(m_bitmapTopMs);
+    QRectF area = drawingArea.translated(0, (m_bitmapTopMs - topMs) * job.rowsPerMs);
+    job.transform.set(yMin, yMax, topMs, getTimeIntervalMs(), area);
+    return job;
 }
 
 /**
- * @brief Draw all data series in the waterfall graph.
+ * @brief Rasterize every visible series into a new bitmap topped at timeMax.
  *
  */
-void WaterfallGraph::drawAllDataSeries()
+void WaterfallGraph::rebuildScrollingBitmap()
 {
-    if (!graphicsScene || !dataSource || !dataRangesValid)
+    m_bitmapValid = false;
+    if (!dataSource || !dataRangesValid || !timeMax.isValid() || drawingArea.isEmpty())
     {
-        qDebug() << "drawAllDataSeries: Early return - graphicsScene:" << (graphicsScene != nullptr)
-                 << "dataSource:" << (dataSource != nullptr)
-                 << "dataRangesValid:" << dataRangesValid;
         return;
     }
 
-    // Get all available data series labels
-    std::vector<QString> seriesLabels = dataSource->getDataSeriesLabels();
-    qDebug() << "drawAllDataSeries: Found" << seriesLabels.size() << "series labels";
+    m_bitmapTopMs = (qreal)timeMax.toMSecsSinceEpoch();
+    m_bitmapTopRow = 0;
+    SeriesRasterJob job = bitmapMapping();
 
-    // If no multi-series data, fall back to legacy single series
-    if (seriesLabels.empty())
+    for (int seriesId : dataSource->getDataSeriesIds())
     {
-        qDebug() << "drawAllDataSeries: No series found, falling back to legacy single series";
-        // Throw an exception
-        // Gather more debug info about the WaterfallGraph state
-        QString debugInfo;
-        debugInfo += "No series found in data source.\n";
-        debugInfo += QString("WaterfallGraph info:\n");
-        debugInfo += QString("  graphicsScene: %1\n").arg(graphicsScene ? "set" : "nullptr");
-        debugInfo += QString("  dataSource: %1\n").arg(dataSource ? "set" : "nullptr");
-        debugInfo += QString("  dataRangesValid: %1\n").arg(dataRangesValid ? "true" : "false");
-        debugInfo += QString("  drawingArea: (%1, %2, %3, %4)\n")
-                         .arg(drawingArea.left())
-                         .arg(drawingArea.top())
-                         .arg(drawingArea.width())
-                         .arg(drawingArea.height());
-        debugInfo += QString("  yMin: %1, yMax: %2\n").arg(yMin).arg(yMax);
-        debugInfo += QString("  timeMin: %1, timeMax: %2\n")
-                         .arg(timeMin.toString())
-                         .arg(timeMax.toString());
-        debugInfo += QString("  autoUpdateYRange: %1\n").arg(autoUpdateYRange ? "true" : "false");
-        debugInfo += QString("  rangeLimitingEnabled: %1\n").arg(rangeLimitingEnabled ? "true" : "false");
-        qDebug() << debugInfo;
-        throw std::runtime_error(debugInfo.toStdString());
-    }
+        SeriesSlot &slot = seriesSlot(seriesId);
+        slot.bitmapDrawn = false;
+        if (!slot.visible)
+        {
+            continue;
+        }
 
-    // Draw each visible series
-    for (const QString &seriesLabel : seriesLabels)
-    {
-        qDebug() << "drawAllDataSeries: Processing series:" << seriesLabel
-                 << "visible:" << isSeriesVisible(seriesLabel);
-        if (isSeriesVisible(seriesLabel))
+        WaterfallSeriesView visibleData = getVisibleSeriesView(seriesId);
+        if (visibleData.empty())
+        {
+            continue;
+        }
+
+        const SeriesStyle style = seriesStyle(seriesId);
+        if (style.drawLine && visibleData.size() >= 2)
         {
-            drawDataSeries(seriesLabel);
+            job.layers.push_back(snapshotSeriesLine(seriesId, visibleData, style.linePen));
         }
+        if (style.marksSamples(visibleData.size()))
+        {
+            job.layers.push_back(snapshotSeriesMarkers(visibleData, style.samplePen(), style.sampleBrush(), style.sampleSize(visibleData.size()), style.markerZValue));
+        }
+
+        slot.bitmapDrawn = true;
+        slot.bitmapLastMs = visibleData.timestampsMs[visibleData.size() - 1];
+        slot.bitmapLastY = visibleData.yData[visibleData.size() - 1];
+    }
+
+    m_rasterImage = SeriesRasterizer::rasterize(job);
+    m_rasterArea = drawingArea;
+    showRasterImage();
+    if (m_rasterItem)
+    {
+        m_rasterItem->setPos(0, 0);
     }
+    m_bitmapValid = !m_rasterImage.isNull();
 }
 
 /**
- * @brief Draw a specific data series.
+ * @brief Scroll the bitmap to the current timeMax and paint the samples that arrived.
  *
- * @param seriesLabel The label of the series to draw
+ * @return bool false if the bitmap has to be re-rasterized instead
  */
-void WaterfallGraph::drawDataSeries(const QString &seriesLabel)
+bool WaterfallGraph::scrollScrollingBitmap()
 {
-    if (!graphicsScene || !dataSource || !dataRangesValid)
+    if (!m_bitmapValid || !m_rasterItem || !dataSource || !timeMax.isValid())
     {
-        qDebug() << "drawDataSeries: Early return for series:" << seriesLabel;
-        return;
+        return false;
     }
 
-    // Remove existing graphics items for this series if they exist (for incremental updates)
-    auto pathIt = m_seriesPathItems.find(seriesLabel);
-    if (pathIt != m_seriesPathItems.end() && pathIt->second)
+    const qreal rowsPerMs = drawingArea.height() / (qreal)getTimeIntervalMs();
+    const qreal deviceRowsPerMs = rowsPerMs * m_rasterImage.devicePixelRatio();
+    const qint64 timeMaxMs = timeMax.toMSecsSinceEpoch();
+    const qreal elapsedRows = (timeMaxMs - m_bitmapTopMs) * deviceRowsPerMs;
+
+    // Shift by whole rows rounded up, so that the top row is never older than timeMax
+    // and every sample up to timeMax lands inside the bitmap
+    const int shiftRows = (int)std::ceil(elapsedRows);
+    if (elapsedRows < 0 || shiftRows >= m_rasterImage.height())
     {
-        graphicsScene->removeItem(pathIt->second);
-        delete pathIt->second;
-        m_seriesPathItems.erase(pathIt);
+        return false;
     }
 
-    auto pointIt = m_seriesPointItems.find(seriesLabel);
-    if (pointIt != m_seriesPointItems.end())
+    // Check every series first, so that a rebuild never follows a partial update
+    struct SeriesUpdate
+    {
+        int seriesId;
+        WaterfallSeriesView newData;
+    };
+    std::vector<SeriesUpdate> updates;
+    for (int seriesId : dataSource->getDataSeriesIds())
     {
-        for (QGraphicsEllipseItem *item : pointIt->second)
+        SeriesSlot &slot = seriesSlot(seriesId);
+        if (!slot.visible)
         {
-            if (item)
+            if (slot.bitmapDrawn)
             {
-                graphicsScene->removeItem(item);
-                delete item;
+                return false; // Hidden since it was painted
             }
+            continue;
         }
-        pointIt->second.clear();
-    }
 
-    const auto &yData = dataSource->getYDataSeries(seriesLabel);
-    const auto &timestamps = dataSource->getTimestampsSeries(seriesLabel);
-
-    qDebug() << "drawDataSeries: Series" << seriesLabel << "has" << yData.size() << "yData points and" << timestamps.size() << "timestamps";
+        WaterfallSeriesView visibleData = getVisibleSeriesView(seriesId);
+        if (!slot.bitmapDrawn)
+        {
+            if (!visibleData.empty())
+            {
+                updates.push_back({seriesId, visibleData});
+            }
+            continue;
+        }
 
-    if (yData.empty() || timestamps.empty())
-    {
-        qDebug() << "No data available for series:" << seriesLabel;
-        return;
-    }
+        // The last painted sample must still be where it was, otherwise the series was
+        // replaced or samples were inserted before it
+        const qint64 *timestampsEnd = visibleData.timestampsMs + visibleData.size();
+        const qint64 *newBegin = std::upper_bound(visibleData.timestampsMs, timestampsEnd, slot.bitmapLastMs);
+        size_t drawnCount = static_cast<size_t>(newBegin - visibleData.timestampsMs);
+        if (drawnCount > 0 && (visibleData.timestampsMs[drawnCount - 1] != slot.bitmapLastMs ||
+                               visibleData.yData[drawnCount - 1] != slot.bitmapLastY))
+        {
+            return false;
+        }
 
-    // Filter data points to only include those within the current time range
-    std::vector<std::pair<qreal, QDateTime>> visibleData;
-    for (size_t i = 0; i < yData.size(); ++i)
-    {
-        if (timestamps[i] >= timeMin && timestamps[i] <= timeMax)
+        WaterfallSeriesView newData = visibleData;
+        newData.timestampsMs += drawnCount;
+        newData.yData += drawnCount;
+        newData.count -= drawnCount;
+        newData.firstIndex += drawnCount;
+        if (!newData.empty())
         {
-            visibleData.push_back({yData[i], timestamps[i]});
+            updates.push_back({seriesId, newData});
         }
     }
 
-    qDebug() << "drawDataSeries: Series" << seriesLabel << "has" << visibleData.size() << "visible data points within time range"
-             << timeMin.toString() << "to" << timeMax.toString();
-
-    if (visibleData.empty())
+    // Scroll the ring down by moving its top row back, then clear only the rows that became the top
+    m_rasterItem->releaseImage();
+    const int height = m_rasterImage.height();
+    if (shiftRows > 0)
     {
-        qDebug() << "No data points within current time range for series:" << seriesLabel;
-        return;
+        uchar *bits = m_rasterImage.bits();
+        const qsizetype bytesPerLine = m_rasterImage.bytesPerLine();
+        m_bitmapTopRow = (m_bitmapTopRow - shiftRows + height) % height;
+        const int rowsBeforeWrap = qMin(shiftRows, height - m_bitmapTopRow);
+        std::memset(bits + m_bitmapTopRow * bytesPerLine, 0, rowsBeforeWrap * bytesPerLine);
+        std::memset(bits, 0, (shiftRows - rowsBeforeWrap) * bytesPerLine);
+        m_bitmapTopMs += shiftRows / deviceRowsPerMs;
     }
 
-    // Get series color
-    QColor seriesColor = getSeriesColor(seriesLabel);
-
-    if (visibleData.size() < 2)
+    // Paint the new samples, each line continuing from the last painted sample
+    if (!updates.empty())
     {
-        // Draw a single point if we only have one data point
-        QPointF screenPoint = mapDataToScreen(visibleData[0].first, visibleData[0].second);
-        QPen pointPen(seriesColor, 0); // No stroke (width 0)
-        QGraphicsEllipseItem *pointItem = graphicsScene->addEllipse(screenPoint.x() - 2, screenPoint.y() - 2, 4, 4, pointPen);
-        m_seriesPointItems[seriesLabel].push_back(pointItem);
-        qDebug() << "Data series" << seriesLabel << "drawn with 1 visible point";
-        return;
-    }
+        SeriesRasterJob mapping = bitmapMapping();
+        std::vector<SeriesRasterLayer> layers;
+        for (const SeriesUpdate &update : updates)
+        {
+            SeriesSlot &slot = m_seriesSlots[update.seriesId];
+            const WaterfallSeriesView &newData = update.newData;
 
-    // Create a path for the line
-    QPainterPath path;
-    QPointF firstPoint = mapDataToScreen(visibleData[0].first, visibleData[0].second);
-    path.moveTo(firstPoint);
+            const SeriesStyle style = seriesStyle(update.seriesId);
 
-    // Add lines connecting all visible data points
-    for (size_t i = 1; i < visibleData.size(); ++i)
-    {
-        QPointF point = mapDataToScreen(visibleData[i].first, visibleData[i].second);
-        path.lineTo(point);
-    }
+            SeriesRasterLayer line;
+            line.kind = SeriesRasterLayer::Kind::Line;
+            line.pen = style.linePen;
+            if (slot.bitmapDrawn)
+            {
+                line.timestampsMs.push_back(slot.bitmapLastMs);
+                line.yData.push_back(slot.bitmapLastY);
+            }
+            line.timestampsMs.insert(line.timestampsMs.end(), newData.timestampsMs, newData.timestampsMs + newData.size());
+            line.yData.insert(line.yData.end(), newData.yData, newData.yData + newData.size());
+            const size_t lineCount = line.timestampsMs.size();
+            if (style.drawLine && lineCount >= 2)
+            {
+                layers.push_back(std::move(line));
+            }
+            if (style.marksSamples(lineCount))
+            {
+                layers.push_back(snapshotSeriesMarkers(newData, style.samplePen(), style.sampleBrush(), style.sampleSize(lineCount), style.markerZValue));
+            }
 
-    // Draw the line and store reference
-    QPen linePen(seriesColor, 2);
-    QGraphicsPathItem *pathItem = graphicsScene->addPath(path, linePen);
-    m_seriesPathItems[seriesLabel] = pathItem;
+            slot.bitmapDrawn = true;
+            slot.bitmapLastMs = newData.timestampsMs[newData.size() - 1];
+            slot.bitmapLastY = newData.yData[newData.size() - 1];
+        }
 
-    // Draw data points and store references
-    QPen pointPen(seriesColor, 0); // No stroke (width 0)
-    std::vector<QGraphicsEllipseItem*> &pointItems = m_seriesPointItems[seriesLabel];
-    pointItems.reserve(visibleData.size());
-    for (size_t i = 0; i < visibleData.size(); ++i)
-    {
-        QPointF point = mapDataToScreen(visibleData[i].first, visibleData[i].second);
-        QGraphicsEllipseItem *pointItem = graphicsScene->addEllipse(point.x() - 1, point.y() - 1, 2, 2, pointPen);
-        pointItems.push_back(pointItem);
+        // Logical device row r lives in image row (r + top row) mod height: paint once for the
+        // rows below the top row and once, shifted up by the image height, for the wrapped rows
+        const qreal dpr = m_rasterImage.devicePixelRatio();
+        const qreal width = m_rasterImage.width() / dpr;
+        QPainter painter(&m_rasterImage);
+        painter.setRenderHint(QPainter::Antialiasing, true);
+        for (int part = 0; part < (m_bitmapTopRow > 0 ? 2 : 1); ++part)
+        {
+            const int firstRow = part == 0 ? m_bitmapTopRow : 0;
+            const int rowCount = part == 0 ? height - m_bitmapTopRow : m_bitmapTopRow;
+            const int rowShift = part == 0 ? m_bitmapTopRow : m_bitmapTopRow - height;
+            painter.save();
+            painter.setClipRect(QRectF(0, firstRow / dpr, width, rowCount / dpr));
+            painter.translate(QPointF(0, rowShift / dpr) - drawingArea.topLeft());
+            for (const SeriesRasterLayer &layer : layers)
+            {
+                SeriesRasterizer::paintLayer(painter, mapping, layer);
+            }
+            painter.restore();
+        }
+        painter.end();
     }
 
-    qDebug() << "Data series" << seriesLabel << "drawn with" << visibleData.size() << "visible points out of" << yData.size() << "total points";
-}
+    // The fraction of a row shifted ahead of timeMax is a negative item offset
+    showRasterImage();
+    m_rasterItem->setPos(0, (timeMaxMs - m_bitmapTopMs) * rowsPerMs);
 
-// Multi-series support methods implementation
+    UI_DEBUG(lcWaterfallDraw) << "scrollScrollingBitmap: shifted" << shiftRows << "rows, painted" << updates.size() << "series";
+    return true;
+}
 
 /**
- * @brief Set the color for a specific data series.
+ * @brief Remove the image item and drop the last image.
  *
- * @param seriesLabel The label of the series
- * @param color The color to use for the series
  */
-void WaterfallGraph::setSeriesColor(const QString &seriesLabel, const QColor &color)
+void WaterfallGraph::removeRasterImage()
 {
-    seriesColors[seriesLabel] = color;
-    qDebug() << "Series color set for" << seriesLabel << "to" << color.name();
+    if (m_rasterItem && graphicsScene)
+    {
+        graphicsScene->removeItem(m_rasterItem);
+        delete m_rasterItem;
+    }
+    m_rasterItem = nullptr;
+    m_rasterImage = QImage();
+    m_bitmapValid = false;
+    m_bitmapTopRow = 0;
 }
 
 /**
- * @brief Get the color for a specific data series.
+ * @brief Start collecting the layers of a draw pass; the pass is submitted from the event loop.
  *
- * @param seriesLabel The label of the series
- * @return QColor The color of the series, or a default color if not set
  */
-QColor WaterfallGraph::getSeriesColor(const QString &seriesLabel) const
+void WaterfallGraph::beginRasterPass()
 {
-    auto it = seriesColors.find(seriesLabel);
-    if (it != seriesColors.end())
+    m_pendingRasterJob.layers.clear();
+    m_rasterJobPending = false;
+    if (!m_rasterPassOpen)
     {
-        return it->second;
+        m_rasterPassOpen = true;
+        QMetaObject::invokeMethod(this, [this]() { finishRasterPass(); }, Qt::QueuedConnection);
     }
+}
 
-    // Return a default color based on series index
-    static const QColor defaultColors[] = {
-        Qt::green, Qt::red, Qt::blue, Qt::yellow, Qt::cyan, Qt::magenta, Qt::white};
-
-    // Generate a consistent color based on the series label hash
-    uint hash = qHash(seriesLabel);
-    return defaultColors[hash % (sizeof(defaultColors) / sizeof(defaultColors[0]))];
+void WaterfallGraph::queueRasterLayer(SeriesRasterLayer &&layer)
+{
+    if (!m_rasterPassOpen)
+    {
+        beginRasterPass();
+    }
+    m_pendingRasterJob.layers.push_back(std::move(layer));
 }
 
 /**
- * @brief Set the visibility for a specific data series.
+ * @brief Complete the collected pass with the current mapping and hand it to a worker.
  *
- * @param seriesLabel The label of the series
- * @param visible True to make the series visible, false to hide it
  */
-void WaterfallGraph::setSeriesVisible(const QString &seriesLabel, bool visible)
+void WaterfallGraph::finishRasterPass()
 {
-    seriesVisibility[seriesLabel] = visible;
-    qDebug() << "Series visibility set for" << seriesLabel << "to" << (visible ? "visible" : "hidden");
+    m_rasterPassOpen = false;
+    if (!m_rasterRenderingEnabled)
+    {
+        return;
+    }
+
+    m_pendingRasterJob.area = drawingArea;
+    m_pendingRasterJob.transform = screenTransform();
+    m_pendingRasterJob.rowsPerMs = drawingArea.height() / (qreal)getTimeIntervalMs();
+    m_pendingRasterJob.devicePixelRatio = graphicsView ? graphicsView->devicePixelRatioF() : 1.0;
+    m_rasterJobPending = true;
+
+    if (!m_rasterWatcher->isRunning())
+    {
+        startRasterJob();
+    }
 }
 
-/**
- * @brief Check if a specific data series is visible.
- *
- * @param seriesLabel The label of the series
- * @return bool True if the series is visible, false otherwise
- */
-bool WaterfallGraph::isSeriesVisible(const QString &seriesLabel) const
+void WaterfallGraph::startRasterJob()
+{
+    // The job owns a copy of the samples, so it outlives neither data nor graph state
+    SeriesRasterJob job = std::move(m_pendingRasterJob);
+    m_pendingRasterJob = SeriesRasterJob();
+    m_rasterJobPending = false;
+
+    m_runningRasterArea = job.area;
+    m_rasterWatcher->setFuture(QtConcurrent::run(&SeriesRasterizer::rasterize, std::move(job)));
+}
+
+void WaterfallGraph::onRasterJobFinished()
 {
-    auto it = seriesVisibility.find(seriesLabel);
-    if (it != seriesVisibility.end())
+    if (!m_rasterRenderingEnabled)
     {
-        return it->second;
+        return;
     }
 
-    // Default to visible if not explicitly set
-    return true;
+    m_rasterImage = m_rasterWatcher->result();
+    m_rasterArea = m_runningRasterArea;
+    showRasterImage();
+
+    // Render the latest pass that finished while this job was running
+    if (m_rasterJobPending)
+    {
+        startRasterJob();
+    }
 }
 
 /**
- * @brief Get all visible series labels.
+ * @brief Blit the last finished image, adding its item if the scene was cleared since.
  *
- * @return std::vector<QString> Vector of visible series labels
  */
-std::vector<QString> WaterfallGraph::getVisibleSeries() const
+void WaterfallGraph::showRasterImage()
 {
-    std::vector<QString> visibleSeries;
-
-    if (!dataSource)
+    if (!graphicsScene || m_rasterImage.isNull())
     {
-        return visibleSeries;
+        return;
     }
 
-    std::vector<QString> allSeries = dataSource->getDataSeriesLabels();
-    for (const QString &seriesLabel : allSeries)
+    if (!m_rasterItem)
     {
-        if (isSeriesVisible(seriesLabel))
-        {
-            visibleSeries.push_back(seriesLabel);
-        }
+        m_rasterItem = new SeriesRasterItem();
+        m_rasterItem->setZValue(120); // Above the grid, below symbols and markers
+        graphicsScene->addItem(m_rasterItem);
     }
-
-    return visibleSeries;
+    m_rasterItem->setImage(m_rasterImage, m_rasterArea, m_scrollingBitmapEnabled ? m_bitmapTopRow : 0);
 }
 
 void WaterfallGraph::setAutoUpdateYRange(bool enabled)
 {
     autoUpdateYRange = enabled;
+    m_autoYRangeHeld = false;
 
     // Trigger range update when switching modes
     if (dataSource && !dataSource->isEmpty())
@@ -2335,6 +3634,7 @@ qreal WaterfallGraph::getZeroAxisValue() const
 void WaterfallGraph::forceRangeUpdate()
 {
     dataRangesValid = false;
+    m_autoYRangeHeld = false;
     updateDataRanges();
     draw();
     qDebug() << "Forced range update - Y:" << yMin << "to" << yMax;
@@ -2358,6 +3658,38 @@ void WaterfallGraph::updateYRange()
     }
 }
 
+/**
+ * @brief Get the Y range of the data inside the visible time window.
+ *
+ * The window is [timeMax - interval, timeMax] clipped to timeMin, matching what
+ * mapDataToScreen puts on screen. Each series answers in O(log n) from its range
+ * tree, so this is cheap enough to run on every scroll or zoom. Falls back to the
+ * range over all data when the window holds no samples.
+ *
+ * @return std::pair<qreal, qreal> Min and max Y values
+ */
+std::pair<qreal, qreal> WaterfallGraph::getVisibleYRange() const
+{
+    if (!dataSource)
+    {
+        return std::make_pair(0.0, 0.0);
+    }
+
+    if (timeMin.isValid() && timeMax.isValid())
+    {
+        qint64 endMs = timeMax.toMSecsSinceEpoch();
+        qint64 startMs = qMax(timeMin.toMSecsSinceEpoch(), endMs - getTimeIntervalMs());
+
+        std::pair<qreal, qreal> windowRange;
+        if (dataSource->getCombinedYRangeInTimeRange(startMs, endMs, windowRange))
+        {
+            return windowRange;
+        }
+    }
+
+    return dataSource->getCombinedYRange();
+}
+
 /**
  * @brief Update Y range from data source (auto mode)
  *
@@ -2370,7 +3702,7 @@ void WaterfallGraph::updateYRangeFromData()
         return;
     }
 
-    auto yRange = dataSource->getCombinedYRange();
+    auto yRange = getVisibleYRange();
     qreal dataYMin = yRange.first;
     qreal dataYMax = yRange.second;
 
@@ -2387,9 +3719,9 @@ void WaterfallGraph::updateYRangeFromData()
             // If custom range is invalid or doesn't overlap with data, use data range
             yMin = dataYMin;
             yMax = dataYMax;
-            qDebug() << "Warning: Custom range doesn't overlap with data range, using data range";
-            qDebug() << "Custom range:" << customYMin << "to" << customYMax;
-            qDebug() << "Data range:" << dataYMin << "to" << dataYMax;
+            UI_WARNING(lcWaterfallDraw) << "Warning: Custom range doesn't overlap with data range, using data range";
+            UI_DEBUG(lcWaterfallDraw) << "Custom range:" << customYMin << "to" << customYMax;
+            UI_DEBUG(lcWaterfallDraw) << "Data range:" << dataYMin << "to" << dataYMax;
         }
     }
     else
@@ -2399,11 +3731,58 @@ void WaterfallGraph::updateYRangeFromData()
         yMax = dataYMax;
     }
 
+    holdAutoYRange();
+
     dataRangesValid = true;
-    qDebug() << "Y range updated from data - Y:" << yMin << "to" << yMax
+    UI_DEBUG(lcWaterfallDraw) << "Y range updated from data - Y:" << yMin << "to" << yMax
              << "Range limiting:" << (rangeLimitingEnabled ? "enabled" : "disabled");
 }
 
+/**
+ * @brief Round the auto-fitted Y range outward and hold it while the visible data fits.
+ *
+ * Fitting yMin and yMax exactly to the visible window changes the screen mapping on
+ * every slide of the window, and a changed mapping forces a full redraw. The fitted
+ * range is widened to a 1/2/5 step of about a tenth of its span, and that range is
+ * kept as long as the data stays inside it and still covers at least half of it.
+ */
+void WaterfallGraph::holdAutoYRange()
+{
+    const qreal span = yMax - yMin;
+    if (!(span > 0.0))
+    {
+        m_autoYRangeHeld = false;
+        return;
+    }
+
+    if (m_autoYRangeHeld && yMin >= m_heldYMin && yMax <= m_heldYMax && span * 2.0 >= m_heldYMax - m_heldYMin)
+    {
+        yMin = m_heldYMin;
+        yMax = m_heldYMax;
+        return;
+    }
+
+    const qreal rawStep = span / 10.0;
+    const qreal magnitude = std::pow(10.0, std::floor(std::log10(rawStep)));
+    const qreal normalized = rawStep / magnitude;
+    const qreal step = magnitude * (normalized <= 1.0 ? 1.0 : normalized <= 2.0 ? 2.0 : normalized <= 5.0 ? 5.0 : 10.0);
+
+    // A fit inside the custom bounds must not be widened past them
+    const bool withinCustomRange = rangeLimitingEnabled && customYMin < customYMax && yMin >= customYMin && yMax <= customYMax;
+
+    yMin = std::floor(yMin / step) * step;
+    yMax = std::ceil(yMax / step) * step;
+    if (withinCustomRange)
+    {
+        yMin = qMax(yMin, customYMin);
+        yMax = qMin(yMax, customYMax);
+    }
+
+    m_heldYMin = yMin;
+    m_heldYMax = yMax;
+    m_autoYRangeHeld = true;
+}
+
 /**
  * @brief Update Y range from custom values (manual mode)
  *
@@ -2421,6 +3800,7 @@ void WaterfallGraph::updateYRangeFromCustom()
     }
 
     // Manual mode: range is locked to the custom min and max
+    m_autoYRangeHeld = false;
     yMin = customYMin;
     yMax = customYMax;
 
@@ -2462,6 +3842,17 @@ void WaterfallGraph::setTimeRange(const QDateTime &timeMin, const QDateTime &tim
     this->timeMin = timeMin;
     this->timeMax = timeMax;
 
+    // A window that only slid (follow mode) scrolls the drawn series; any change of the
+    // screen mapping is caught by drawIncremental, which falls back to a full redraw
+    if (m_sceneRenderKeyValid && m_renderState != RenderState::FULL_REDRAW)
+    {
+        m_rangeUpdateNeeded = true;
+        setRenderState(RenderState::INCREMENTAL_UPDATE);
+        drawIncremental();
+        qDebug() << "Custom time range scrolled to:" << timeMin.toString() << "to" << timeMax.toString();
+        return;
+    }
+
     // Time range change requires full redraw (automatically marks all series dirty)
     setRenderState(RenderState::FULL_REDRAW);
 
@@ -2771,13 +4162,14 @@ void WaterfallGraph::setupCrosshair()
  */
 void WaterfallGraph::updateCrosshair(const QPointF &mousePos)
 {
-    // If cursor layer is enabled, just update position (timer will handle rendering)
+    // If cursor layer is enabled, just update position (rendered with the next cursor frame)
     if (m_cursorLayerEnabled)
     {
         // Convert scene position to widget position for m_lastMousePos
         if (overlayView)
         {
             m_lastMousePos = overlayView->mapFromScene(mousePos);
+            requestCursorFrame();
         }
         return;
     }
@@ -2852,6 +4244,7 @@ void WaterfallGraph::setCrosshairEnabled(bool enabled)
     if (crosshairEnabled != enabled)
     {
         crosshairEnabled = enabled;
+        requestCursorFrame();
 
         // Make overlay view transparent to mouse events so WaterfallGraph receives them
         overlayView->setAttribute(Qt::WA_TransparentForMouseEvents, true);
@@ -2877,10 +4270,52 @@ bool WaterfallGraph::isCrosshairEnabled() const
 }
 
 /**
- * @brief Update the cursor layer - called by timer at fixed rate (60fps)
+ * @brief Mark the cursor layer as changed and ask for the next cursor frame
+ *
+ * Called from the events that move the crosshair or the time axis line (mouse moves,
+ * enter/leave, resizes and redraws that change the mapping), so an idle pointer
+ * causes no wakeups at all.
+ */
+void WaterfallGraph::requestCursorFrame()
+{
+    if (!m_cursorLayerEnabled)
+    {
+        return;
+    }
+    m_cursorLayerDirty = true;
+    CursorFrameScheduler::instance()->requestFrame();
+}
+
+/**
+ * @brief Bring the cursor layer up to date if anything it shows has changed
+ *
+ * Runs for every graph in each cursor frame, so it only compares flags and the
+ * shared cursor revision unless there is something to redraw.
+ */
+void WaterfallGraph::flushCursorLayer()
+{
+    if (!m_cursorLayerEnabled)
+    {
+        return;
+    }
+
+    quint64 revision = m_cursorSyncState ? m_cursorSyncState->cursorRevision : 0;
+    if (!m_cursorLayerDirty && revision == m_drawnCursorRevision)
+    {
+        return;
+    }
+
+    m_cursorLayerDirty = false;
+    m_drawnCursorRevision = revision;
+    updateCursorLayer();
+}
+
+/**
+ * @brief Update the cursor layer from the mouse position and the shared cursor time
  */
 void WaterfallGraph::updateCursorLayer()
 {
+    PERF_SCOPE("WaterfallGraph::updateCursorLayer");
     if (!cursorScene || !cursorView || !m_cursorLayerEnabled)
     {
         return;
@@ -2903,9 +4338,13 @@ void WaterfallGraph::updateCursorLayer()
         qreal yPos = mapTimeToY(m_cursorSyncState->cursorTime);
         if (yPos >= 0)
         {
-            cursorTimeAxisLine->setLine(sceneRect.left(), yPos, sceneRect.right(), yPos);
+            QLineF line(sceneRect.left(), yPos, sceneRect.right(), yPos);
+            if (cursorTimeAxisLine->line() != line)
+            {
+                cursorTimeAxisLine->setLine(line);
+                needsUpdate = true;
+            }
             timeAxisVisible = true;
-            needsUpdate = true;
         }
     }
     
@@ -2922,11 +4361,14 @@ void WaterfallGraph::updateCursorLayer()
     
     if (crosshairVisible)
     {
-        cursorCrosshairHorizontal->setLine(sceneRect.left(), m_lastMousePos.y(), 
-                                           sceneRect.right(), m_lastMousePos.y());
-        cursorCrosshairVertical->setLine(m_lastMousePos.x(), sceneRect.top(), 
-                                         m_lastMousePos.x(), sceneRect.bottom());
-        needsUpdate = true;
+        QLineF horizontal(sceneRect.left(), m_lastMousePos.y(), sceneRect.right(), m_lastMousePos.y());
+        QLineF vertical(m_lastMousePos.x(), sceneRect.top(), m_lastMousePos.x(), sceneRect.bottom());
+        if (cursorCrosshairHorizontal->line() != horizontal || cursorCrosshairVertical->line() != vertical)
+        {
+            cursorCrosshairHorizontal->setLine(horizontal);
+            cursorCrosshairVertical->setLine(vertical);
+            needsUpdate = true;
+        }
         
         // Notify crosshair X position change (only if position changed significantly)
         qreal currentX = m_lastMousePos.x();
@@ -2966,7 +4408,7 @@ void WaterfallGraph::updateCursorLayer()
 void WaterfallGraph::setCursorSyncState(GraphContainerSyncState *syncState)
 {
     m_cursorSyncState = syncState;
-    // Timer will automatically read from sync state when it fires
+    requestCursorFrame();
 }
 
 /**
@@ -2982,17 +4424,10 @@ void WaterfallGraph::setCursorLayerEnabled(bool enabled)
 
         if (enabled)
         {
-            if (!cursorUpdateTimer->isActive())
-            {
-                cursorUpdateTimer->start();
-            }
+            requestCursorFrame();
         }
         else
         {
-            if (cursorUpdateTimer->isActive())
-            {
-                cursorUpdateTimer->stop();
-            }
             // Hide all cursor items
             cursorCrosshairHorizontal->setVisible(false);
             cursorCrosshairVertical->setVisible(false);
@@ -3054,6 +4489,13 @@ qreal WaterfallGraph::mapTimeToY(const QDateTime &time) const
         return -1.0;
     }
 
+    // Clamp to the area, as the cursor never leaves it
+    if (area == drawingArea)
+    {
+        qreal y = screenTransform().mapTime(time.toMSecsSinceEpoch());
+        return qMax(area.top(), qMin(area.bottom(), y));
+    }
+
     qint64 timeOffsetMs = time.msecsTo(timeMax);
     qreal normalizedY = timeOffsetMs / static_cast<qreal>(intervalMs);
     normalizedY = qMax(0.0, qMin(1.0, normalizedY));
@@ -3068,18 +4510,10 @@ qreal WaterfallGraph::mapTimeToY(const QDateTime &time) const
  */
 void WaterfallGraph::setTimeAxisCursor(const QDateTime &time)
 {
-    // Update shared sync state if available (cursor layer will read from it)
+    // Update shared sync state if available (cursor layers will read from it)
     if (m_cursorSyncState)
     {
-        if (time.isValid())
-        {
-            m_cursorSyncState->cursorTime = time;
-            m_cursorSyncState->hasCursorTime = true;
-        }
-        else
-        {
-            m_cursorSyncState->hasCursorTime = false;
-        }
+        m_cursorSyncState->setCursorTime(time);
     }
 
     // Legacy overlay mode: update timeAxisCursor directly if cursor layer is disabled
@@ -3129,7 +4563,8 @@ void WaterfallGraph::setTimeAxisCursor(const QDateTime &time)
     }
     else
     {
-        // Cursor layer mode: timer will handle rendering from sync state
+        // Cursor layer mode: every graph sharing the sync state picks up the new revision
+        requestCursorFrame();
         qDebug() << "Time axis cursor set at time:" << time.toString() << "(cursor layer will render)";
     }
 }
@@ -3142,7 +4577,7 @@ void WaterfallGraph::clearTimeAxisCursor()
     // Update shared sync state if available
     if (m_cursorSyncState)
     {
-        m_cursorSyncState->hasCursorTime = false;
+        m_cursorSyncState->clearCursorTime();
     }
 
     // Legacy overlay mode: hide timeAxisCursor directly if cursor layer is disabled
@@ -3157,7 +4592,8 @@ void WaterfallGraph::clearTimeAxisCursor()
     }
     else
     {
-        // Cursor layer mode: timer will handle hiding from sync state
+        // Cursor layer mode: hidden with the next cursor frame
+        requestCursorFrame();
         qDebug() << "Time axis cursor cleared (cursor layer will handle)";
     }
 }
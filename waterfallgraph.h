@@ -2,6 +2,11 @@
 #define WATERFALLGRAPH_H
 
 #include "drawutils.h"
+#include "intensitycolormap.h"
+#include "scatterplotitem.h"
+#include "screentransform.h"
+#include "seriesrasterizer.h"
+#include "seriespathdecimator.h"
 #include "timelineutils.h"
 #include "waterfalldata.h"
 #include <QColor>
@@ -21,6 +26,8 @@
 #include <QPalette>
 #include <QPolygonF>
 #include <QEvent>
+#include <QFutureWatcher>
+#include <QImage>
 #include <QResizeEvent>
 #include <QShowEvent>
 #include <QTime>
@@ -28,6 +35,7 @@
 #include <QVBoxLayout>
 #include <QWidget>
 #include <QCursor>
+#include <deque>
 #include <map>
 #include <set>
 #include <vector>
@@ -66,14 +74,22 @@ public:
     void addDataPoint(const QString &seriesLabel, qreal yValue, const QDateTime &timestamp);
     void addDataPoints(const QString &seriesLabel, const std::vector<qreal> &yValues, const std::vector<QDateTime> &timestamps);
 
+    // Intensity (spectrogram) series: time x bin matrices drawn through a colour map
+    void setIntensitySeries(const QString &seriesLabel, int binCount, size_t rowCapacity, qreal binStart, qreal binEnd);
+    void addIntensityRow(const QString &seriesLabel, const QDateTime &timestamp, const std::vector<float> &bins);
+    void addIntensityRow(const QString &seriesLabel, qint64 timestampMs, const float *bins, size_t binCount);
+    void setIntensityLevels(const QString &seriesLabel, float levelMin, float levelMax);
+    void setIntensityColorMap(const IntensityColorMap &colorMap);
+
     // Data access methods (delegates to data source)
     WaterfallData getData(const QString &seriesLabel) const;
     std::vector<std::pair<qreal, QDateTime>> getDataWithinYExtents(const QString &seriesLabel, qreal yMin, qreal yMax) const;
     std::vector<std::pair<qreal, QDateTime>> getDataWithinTimeRange(const QString &seriesLabel, const QDateTime &startTime, const QDateTime &endTime) const;
 
     // Direct access to data vectors (delegates to data source)
-    const std::vector<qreal> &getYData(const QString &seriesLabel) const;
-    const std::vector<QDateTime> &getTimestamps(const QString &seriesLabel) const;
+    std::vector<qreal> getYData(const QString &seriesLabel) const;
+    std::vector<qint64> getTimestampsMs(const QString &seriesLabel) const;
+    std::vector<QDateTime> getTimestamps(const QString &seriesLabel) const;
 
     // Mouse event handlers (virtual so they can be overridden in derived classes)
     virtual void onMouseClick(const QPointF &scenePos);
@@ -117,13 +133,14 @@ protected:
     // Cursor layer for dedicated cursor rendering
     QGraphicsView *cursorView;
     QGraphicsScene *cursorScene;
-    QTimer *cursorUpdateTimer;
     QGraphicsLineItem *cursorCrosshairHorizontal;
     QGraphicsLineItem *cursorCrosshairVertical;
     QGraphicsLineItem *cursorTimeAxisLine;
     GraphContainerSyncState *m_cursorSyncState;
     QPointF m_lastMousePos;
     bool m_cursorLayerEnabled;
+    bool m_cursorLayerDirty;        // Crosshair or mapping changed since the last cursor frame
+    quint64 m_drawnCursorRevision;  // Sync state cursorRevision the time axis line was drawn for
 
     // Drawing area and grid
     QRectF drawingArea;
@@ -134,12 +151,56 @@ protected:
     void updateGraphicsDimensions();
 
     // Data plotting methods
-    virtual void drawDataLine(const QString &seriesLabel, bool plotPoints = true);
+    virtual void drawDataLine(int seriesId, bool plotPoints = true);
     virtual void drawAllDataSeries();
-    virtual void drawDataSeries(const QString &seriesLabel);
+    virtual void drawDataSeries(int seriesId);
+    void drawDataSeries(const QString &seriesLabel);
     void drawIncremental();
     void drawBTWSymbols();
     QPointF mapDataToScreen(qreal yValue, const QDateTime &timestamp) const;
+    QPointF mapDataToScreen(qreal yValue, qint64 timestampMs) const;
+    void mapDataToScreen(const qreal *yValues, const qint64 *timestampsMs, size_t count, QPointF *out) const;
+    WaterfallSeriesView getVisibleSeriesView(const QString &seriesLabel) const;
+    WaterfallSeriesView getVisibleSeriesView(int seriesId) const;
+    QPainterPath buildSeriesPath(int seriesId, const WaterfallSeriesView &visibleData) const;
+    void decimateSeries(int seriesId, const WaterfallSeriesView &visibleData, SeriesPathDecimator &decimator) const;
+    WaterfallSeriesView lodSeriesView(int seriesId, const WaterfallSeriesView &visibleData,
+                                      std::vector<qint64> &lodTimestampsMs, std::vector<qreal> &lodYData) const;
+    QGraphicsPathItem *addSeriesLine(int seriesId, const WaterfallSeriesView &visibleData, const QPen &pen);
+    ScatterPlotItem *addSeriesMarkers(const WaterfallSeriesView &visibleData, const QPen &pen, const QBrush &brush, qreal pointSize, qreal zValue = 0.0);
+    SeriesRasterLayer snapshotSeriesLine(int seriesId, const WaterfallSeriesView &visibleData, const QPen &pen) const;
+    SeriesRasterLayer snapshotSeriesMarkers(const WaterfallSeriesView &visibleData, const QPen &pen, const QBrush &brush, qreal pointSize, qreal zValue = 0.0) const;
+    bool appendDataSeries(int seriesId);
+    void drawIntensitySeries(int seriesId);
+    void clearGraphicsScene();
+    ScatterPlotItem *createScatterItem(const WaterfallSeriesView &view, const QPen &pen, const QBrush &brush, qreal pointSize);
+
+    // Look of a line/scatter series, shared by the scene, raster and scrolling bitmap paths
+    struct SeriesStyle
+    {
+        bool drawLine = true;
+        QPen linePen;
+        bool drawMarkers = true;
+        QPen markerPen;
+        QBrush markerBrush = Qt::NoBrush;
+        qreal markerSize = 2.0;
+        qreal markerZValue = 0.0;
+
+        // A single sample cannot make a line, so a line-only series marks it instead
+        bool marksSamples(size_t count) const { return drawMarkers || (drawLine && count < 2); }
+        QPen samplePen() const { return drawMarkers ? markerPen : QPen(linePen.color(), 0); }
+        QBrush sampleBrush() const { return drawMarkers ? markerBrush : QBrush(Qt::NoBrush); }
+        qreal sampleSize(size_t count) const { return drawLine && count < 2 ? 4.0 : markerSize; }
+    };
+    virtual SeriesStyle seriesStyle(int seriesId) const;
+    SeriesStyle adoptedLineSeriesStyle(int seriesId) const; // ADOPTED as a line, other series as filled markers
+
+    // Decorations (symbols, manual markers, axes) drawn by derived graphs over the series.
+    // They are rebuilt after every draw pass without clearing the series items.
+    virtual void drawDecorations();
+    void addDecorationItem(QGraphicsItem *item);
+    void rebuildDecorations();
+    std::vector<QGraphicsItem *> m_decorationItems; // Owned by the scene
 
     // State machine for rendering
     enum class RenderState {
@@ -149,7 +210,7 @@ protected:
         FULL_REDRAW
     };
     void setRenderState(RenderState newState);
-    void markSeriesDirty(const QString &seriesLabel);
+    void markSeriesDirty(int seriesId);
     void markAllSeriesDirty();
     void markRangeUpdateNeeded();
     void transitionToAppropriateState();
@@ -157,6 +218,8 @@ protected:
     void updateYRange();
     void updateYRangeFromData();
     void updateYRangeFromCustom();
+    std::pair<qreal, qreal> getVisibleYRange() const;
+    void holdAutoYRange();
     void forceRangeUpdate();
 
     // Data range tracking
@@ -171,6 +234,10 @@ protected:
     bool rangeLimitingEnabled;
     qreal customYMin, customYMax;
 
+    // Rounded auto Y range kept while the visible data fits, so sliding the window keeps the mapping
+    bool m_autoYRangeHeld;
+    qreal m_heldYMin, m_heldYMax;
+
     // Time range management
     bool customTimeRangeEnabled;
     QDateTime customTimeMin, customTimeMax;
@@ -181,23 +248,106 @@ protected:
     // Data source reference
     WaterfallData *dataSource;
 
-    // Multi-series support
-    std::map<QString, QColor> seriesColors;
-    std::map<QString, bool> seriesVisibility;
-
     // Incremental rendering support
     RenderState m_renderState;
     bool m_rangeUpdateNeeded;
-    std::set<QString> m_dirtySeries;
-    std::map<QString, QGraphicsPathItem*> m_seriesPathItems;
-    std::map<QString, std::vector<QGraphicsEllipseItem*>> m_seriesPointItems;
+
+    // Append-only rendering state of the series drawn by drawDataSeries
+    struct SeriesRenderCache
+    {
+        SeriesPathDecimator decimator;
+        std::deque<qint64> pointTimestampsMs; // One entry per marker in the series scatter item
+        qint64 lastDrawnMs = 0;
+        qint64 topTimeMs = 0; // timeMax the series geometry was mapped with; later time is a translation
+    };
+
+    // Multi-series style, visibility and scene state, indexed by interned series ID (see SeriesRegistry)
+    struct SeriesSlot
+    {
+        QColor color;         // Set explicitly or defaulted from the label when the slot is created
+        bool visible = true;
+        bool dirty = false;   // Listed in m_dirtySeries
+        QGraphicsPathItem *pathItem = nullptr;
+        ScatterPlotItem *pointItem = nullptr;
+        bool hasRenderCache = false;
+        SeriesRenderCache renderCache;
+        bool bitmapDrawn = false; // Scrolling bitmap holds the series up to its last sample below
+        qint64 bitmapLastMs = 0;
+        qreal bitmapLastY = 0.0;
+        SeriesRasterItem *intensityItem = nullptr; // Image of an intensity series
+        float intensityLevelMin = 0.0f;            // Intensities mapped to the ends of the colour map
+        float intensityLevelMax = 1.0f;
+    };
+    std::vector<SeriesSlot> m_seriesSlots;
+    std::vector<int> m_dirtySeries;
+    SeriesSlot &seriesSlot(int seriesId);
+    void addDirtySeries(int seriesId);
+    void releaseSeriesItems(SeriesSlot &slot);
+    static QColor defaultSeriesColor(const QString &seriesLabel);
+    static int adoptedSeriesId(); // Interned once, compared per series on draw paths
+
+    // Screen mapping the series geometry in the scene was built with.
+    // timeMax is not part of it: moving it only translates the geometry vertically.
+    struct RenderKey
+    {
+        qreal yMin = 0.0;
+        qreal yMax = 0.0;
+        qint64 intervalMs = 0;
+        QRectF drawingArea;
+
+        bool operator==(const RenderKey &other) const
+        {
+            return yMin == other.yMin && yMax == other.yMax &&
+                   intervalMs == other.intervalMs && drawingArea == other.drawingArea;
+        }
+    };
+    RenderKey currentRenderKey() const;
+    RenderKey m_sceneRenderKey;
+    bool m_sceneRenderKeyValid;
+    qint64 m_sceneTimeMaxMs; // timeMax the series items were last positioned for
+
+    // Affine mapping used by mapDataToScreen, rebuilt when its render key or timeMax changes
+    const ScreenTransform &screenTransform() const;
+    mutable ScreenTransform m_screenTransform;
+    mutable RenderKey m_screenTransformKey;
+    mutable QDateTime m_screenTransformTimeMax;
+    mutable bool m_screenTransformValid;
+
+    // Raster rendering mode: the series of a draw pass are snapshotted into layers,
+    // rasterized on the global thread pool and blitted as a single image item
+    bool m_rasterRenderingEnabled;
+    bool m_rasterPassOpen;            // Layers are being collected, finishRasterPass is queued
+    bool m_rasterJobPending;          // m_pendingRasterJob waits for the running job
+    SeriesRasterJob m_pendingRasterJob;
+    QFutureWatcher<QImage> *m_rasterWatcher;
+    QRectF m_runningRasterArea;
+    SeriesRasterItem *m_rasterItem;   // Owned by the scene
+    QImage m_rasterImage;             // Last finished image, shown again after the scene is cleared
+    QRectF m_rasterArea;
+    void beginRasterPass();
+    void queueRasterLayer(SeriesRasterLayer &&layer);
+    void finishRasterPass();
+    void startRasterJob();
+    void onRasterJobFinished();
+    void showRasterImage();
+    void removeRasterImage();
+
+    // Scrolling bitmap mode: m_rasterImage is kept and shifted down by the rows timeMax
+    // advanced, and only the samples that arrived since the previous tick are painted
+    bool m_scrollingBitmapEnabled;
+    bool m_bitmapValid;
+    qreal m_bitmapTopMs; // Time at the top device row of the bitmap (fractional ms)
+    int m_bitmapTopRow;  // Image row holding the top device row; the bitmap is a ring of rows
+    SeriesRasterJob bitmapMapping() const;
+    void rebuildScrollingBitmap();
+    bool scrollScrollingBitmap();
+
+    // Colour map of the intensity series
+    IntensityColorMap m_intensityColorMap;
 
     // Mouse tracking
     bool isDragging;
     QPointF lastMousePos;
-    
-    // Drawing guard to prevent concurrent draws
-    bool isDrawing;
 
     // Crosshair functionality
     void setupCrosshair();
@@ -236,8 +386,11 @@ protected:
     void clearSelection();
     QDateTime mapScreenToTime(qreal yPos) const;
 
-private slots:
-    // Cursor layer update method
+private:
+    // Cursor layer updates, run by CursorFrameScheduler at most once per display frame
+    friend class CursorFrameScheduler;
+    void requestCursorFrame();
+    void flushCursorLayer();
     void updateCursorLayer();
 
 public:
@@ -266,6 +419,14 @@ public:
     void setCursorLayerEnabled(bool enabled);
     bool isCursorLayerEnabled() const;
     
+    // Raster rendering control (series are drawn off the GUI thread into an image)
+    void setRasterRenderingEnabled(bool enabled);
+    bool isRasterRenderingEnabled() const;
+
+    // Scrolling bitmap control (series are painted into a bitmap that scrolls with timeMax)
+    void setScrollingBitmapEnabled(bool enabled);
+    bool isScrollingBitmapEnabled() const;
+
     // Public access to overlay scene for interactive elements
     QGraphicsScene* getOverlayScene() const { return overlayScene; }
 
@@ -296,12 +457,16 @@ public:
     // Public draw method for external redraw triggers
     virtual void draw();
 
+    // Incremental redraw after the given series changed in the data source
+    void drawChangedSeries(const std::set<int> &seriesIds);
+
     // Drawing methods for custom elements
     void drawPoint(const QPointF &position, const QColor &color = Qt::white, qreal size = 2.0);
     void drawAxisLine(const QPointF &startPos, const QPointF &endPos, const QColor &color = QColor(255, 255, 255, 128));
     void drawCharacterLabel(const QString &text, const QPointF &position, const QColor &color = Qt::white, int fontSize = 12);
     void drawTriangleMarker(const QPointF &position, const QColor &fillColor = Qt::red, const QColor &outlineColor = Qt::black, qreal size = 8.0);
     void drawScatterplot(const QString &seriesLabel, const QColor &pointColor = Qt::white, qreal pointSize = 3.0, const QColor &outlineColor = Qt::black);
+    void drawScatterplot(int seriesId, const QColor &pointColor = Qt::white, qreal pointSize = 3.0, const QColor &outlineColor = Qt::black);
 
     // Multi-series support methods
     void setSeriesColor(const QString &seriesLabel, const QColor &color);
@@ -309,6 +474,8 @@ public:
     void setSeriesVisible(const QString &seriesLabel, bool visible);
     bool isSeriesVisible(const QString &seriesLabel) const;
     std::vector<QString> getVisibleSeries() const;
+    QColor getSeriesColor(int seriesId) const;
+    bool isSeriesVisible(int seriesId) const;
 
 signals:
     void SelectionCreated(const TimeSelectionSpan &selection);